@@ -19,20 +19,26 @@ layout (location = 2) out flat int outID;
 //------------------------------------------------------------------
 layout (set = 0, binding = 0) uniform Transform
 {
-    mat4 world;
     mat4 view;
     mat4 projection;
 };
 
+// 描画単位で変化するデータ
+layout (push_constant) uniform Object
+{
+    mat4 world;
+    int  id;
+} u_object;
+
 
 void main()
 {
-    vec4 worldPos     = world * vec4(inPos, 1.0);
-    mat3 normalMatrix = mat3(transpose(inverse(world)));
+    vec4 worldPos     = u_object.world * vec4(inPos, 1.0);
+    mat3 normalMatrix = mat3(transpose(inverse(u_object.world)));
 
     outNormal       = normalize(normalMatrix * inNormal);
     outTexCoord     = inTexCoord;
-    outID           = 9999;
+    outID           = u_object.id;
 
     gl_Position = projection * view * worldPos;
 }
@@ -140,6 +146,4 @@ void main()
     //----------------------------------------------------------------------------
 
     outID = inID; // エンティティID
-
-    outID = int(normal.x * 10.0) + int(normal.y * 10.0) + int(normal.z * 10.0);
 }
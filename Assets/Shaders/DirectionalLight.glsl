@@ -28,7 +28,8 @@ layout(location = 4) in vec3 inBitangent;
 //;
 
 
-layout (set = 0, binding = 0) uniform Transform
+// 描画単位で変化するデータ
+layout (push_constant) uniform Object
 {
     mat4 world;
 };
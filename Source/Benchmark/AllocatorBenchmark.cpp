@@ -0,0 +1,862 @@
+
+#include "PCH.h"
+#include "Core/Memory.h"
+#include "Core/LinearAllocator.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+
+//==================================================================
+// アロケーターベンチマーク
+//------------------------------------------------------------------
+// エンジンの各アロケーターと malloc について、確保・解放のスループットと
+// レイテンシ（パーセンタイル）を計測し、結果を JSON で出力する
+//
+// 使い方: AllocatorBenchmark [--operations N] [--threads N] [--batch N] [--output file.json]
+//
+// ・single_fixed      : 単一スレッド、固定サイズ（バッチ単位で確保してから全て解放）
+// ・multi_fixed       : 複数スレッドで single_fixed を同時に実行
+// ・random_size       : 単一スレッド、ランダムサイズ（生存中の要素をランダムに入れ替え）
+// ・producer_consumer : 確保スレッドと解放スレッドを分け、スレッド間で解放する
+// ・select_pool_index : MemoryPool のサイズクラス選択（if 分岐とビット走査の比較）
+//==================================================================
+
+
+namespace Silex
+{
+    // エディターのコンソールを持たないので、ログは標準エラーに出力する
+    void Logger::Log(LogLevel level, std::string_view message)
+    {
+        std::fprintf(stderr, "%.*s\n", (int)message.size(), message.data());
+    }
+}
+
+
+namespace Silex::Benchmark
+{
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint64 fixedBlockByteSize = 64;
+    static constexpr uint32 ringCapacity       = 1024;
+    static constexpr uint32 randomSlotCount    = 1024;
+
+    struct Config
+    {
+        uint64      operations = 1000000;
+        uint32      threads    = 4;
+        uint32      batch      = 256;
+        const char* output     = nullptr;
+    };
+
+    struct Percentiles
+    {
+        double p50  = 0.0;
+        double p90  = 0.0;
+        double p99  = 0.0;
+        double p999 = 0.0;
+        double max  = 0.0;
+    };
+
+    struct Result
+    {
+        const char* pattern      = "";
+        const char* allocator    = "";
+        uint32      threads      = 1;
+        uint64      operations   = 0;
+        double      seconds      = 0.0;
+        bool        hasLatency   = false;
+        Percentiles allocLatency = {};
+        Percentiles freeLatency  = {};
+    };
+
+    // 固定サイズアロケーター用の要素（確保のたびにゼロ初期化されないよう、空のコンストラクタを持つ）
+    struct alignas(16) Block
+    {
+        Block() {}
+        byte data[fixedBlockByteSize];
+    };
+
+
+    //===============================================================
+    // 計測対象アロケーター
+    //---------------------------------------------------------------
+    // variableSize : 任意サイズの確保に対応する
+    // threadSafe   : 複数スレッドからの同時確保・解放に対応する
+    // freeEach     : 要素ごとに解放できる（ランダムサイズの入れ替えに必要）
+    // EndBatch     : バッチ内の要素が全て解放された後に呼ばれる（リニアアロケーターのリセット用）
+    //===============================================================
+    struct MallocAllocator
+    {
+        static constexpr const char* name         = "malloc";
+        static constexpr bool        variableSize = true;
+        static constexpr bool        threadSafe   = true;
+        static constexpr bool        freeEach     = true;
+
+        void* Allocate(uint64 size)        { return std::malloc(size); }
+        void  Free(void* ptr, uint64 size) { std::free(ptr); }
+        void  EndBatch()                   {}
+    };
+
+    struct MemoryPoolAllocator
+    {
+        static constexpr const char* name         = "MemoryPool";
+        static constexpr bool        variableSize = true;
+        static constexpr bool        threadSafe   = true;
+        static constexpr bool        freeEach     = true;
+
+        void* Allocate(uint64 size)        { return PoolAllocator::Allocate(size); }
+        void  Free(void* ptr, uint64 size) { PoolAllocator::Deallocate(ptr); }
+        void  EndBatch()                   {}
+    };
+
+    struct LinearBumpAllocator
+    {
+        static constexpr const char* name         = "LinearAllocator";
+        static constexpr bool        variableSize = true;
+        static constexpr bool        threadSafe   = false; // Reset が確保と並行できないため
+        static constexpr bool        freeEach     = false;
+
+        LinearBumpAllocator() { allocator.Initialize(); }
+
+        void* Allocate(uint64 size)        { return allocator.Allocate(size); }
+        void  Free(void* ptr, uint64 size) {}
+        void  EndBatch()                   { allocator.Reset(); }
+
+        LinearAllocator allocator;
+    };
+
+    struct PagedBlockAllocator
+    {
+        static constexpr const char* name         = "PagedAllocator";
+        static constexpr bool        variableSize = false;
+        static constexpr bool        threadSafe   = true;
+        static constexpr bool        freeEach     = true;
+
+        void* Allocate(uint64 size)        { return allocator.Alloc(); }
+        void  Free(void* ptr, uint64 size) { allocator.Free(static_cast<Block*>(ptr)); }
+        void  EndBatch()                   {}
+
+        PagedAllocator<Block, true> allocator;
+    };
+
+    struct ConcurrentPagedBlockAllocator
+    {
+        static constexpr const char* name         = "ConcurrentPagedAllocator";
+        static constexpr bool        variableSize = false;
+        static constexpr bool        threadSafe   = true;
+        static constexpr bool        freeEach     = true;
+
+        void* Allocate(uint64 size)        { return allocator.Alloc(); }
+        void  Free(void* ptr, uint64 size) { allocator.Free(static_cast<Block*>(ptr)); }
+        void  EndBatch()                   {}
+
+        ConcurrentPagedAllocator<Block> allocator;
+    };
+
+    struct ResourceStorageAllocator
+    {
+        static constexpr const char* name         = "ResourceStorage";
+        static constexpr bool        variableSize = false;
+        static constexpr bool        threadSafe   = true;
+        static constexpr bool        freeEach     = true;
+
+        void* Allocate(uint64 size)        { return storage.New(); }
+        void  Free(void* ptr, uint64 size) { storage.Delete(static_cast<Block*>(ptr)); }
+        void  EndBatch()                   {}
+
+        ResourceStorage<Block, true> storage;
+    };
+
+
+    //===============================================================
+    // 計測補助
+    //===============================================================
+    namespace Internal
+    {
+        // 最適化で確保・解放が取り除かれないように、確保した領域に書き込む
+        SL_FORCEINLINE void Touch(void* ptr)
+        {
+            *static_cast<volatile byte*>(ptr) = 1;
+        }
+
+        SL_FORCEINLINE uint64 ElapsedNs(Clock::time_point begin, Clock::time_point end)
+        {
+            return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+        }
+
+        static Percentiles ComputePercentiles(std::vector<uint64>& samples)
+        {
+            Percentiles result = {};
+            if (samples.empty())
+                return result;
+
+            std::sort(samples.begin(), samples.end());
+
+            auto at = [&](double ratio)
+            {
+                uint64 index = std::min<uint64>((uint64)(ratio * (double)samples.size()), samples.size() - 1);
+                return (double)samples[index];
+            };
+
+            result.p50  = at(0.50);
+            result.p90  = at(0.90);
+            result.p99  = at(0.99);
+            result.p999 = at(0.999);
+            result.max  = (double)samples.back();
+
+            return result;
+        }
+
+        // 全スレッドの準備が整ってから一斉に開始する
+        class StartBarrier
+        {
+        public:
+
+            StartBarrier(uint32 count) : remaining(count) {}
+
+            void ArriveAndWait()
+            {
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+                while (remaining.load(std::memory_order_acquire) != 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+        private:
+
+            std::atomic<uint32> remaining;
+        };
+
+        // 各スレッドの開始・終了時刻から、最初の開始から最後の終了までの時間を求める
+        // （計測スレッドが開始直後にプリエンプトされても、経過時間がずれないように）
+        class WallTime
+        {
+        public:
+
+            void Begin()
+            {
+                int64 now   = Now();
+                int64 value = begin.load(std::memory_order_relaxed);
+                while (now < value && !begin.compare_exchange_weak(value, now, std::memory_order_relaxed)) {}
+            }
+
+            void End()
+            {
+                int64 now   = Now();
+                int64 value = end.load(std::memory_order_relaxed);
+                while (now > value && !end.compare_exchange_weak(value, now, std::memory_order_relaxed)) {}
+            }
+
+            double GetSeconds() const
+            {
+                return (end.load(std::memory_order_relaxed) - begin.load(std::memory_order_relaxed)) * 1e-9;
+            }
+
+        private:
+
+            static int64 Now()
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+            }
+
+            std::atomic<int64> begin = INT64_MAX;
+            std::atomic<int64> end   = 0;
+        };
+
+        // 単一生産者・単一消費者のリングバッファ（producer_consumer 用）
+        class SPSCRing
+        {
+        public:
+
+            bool Push(void* ptr)
+            {
+                uint64 tail = writeIndex.load(std::memory_order_relaxed);
+                if (tail - readIndex.load(std::memory_order_acquire) == ringCapacity)
+                    return false;
+
+                slots[tail % ringCapacity] = ptr;
+                writeIndex.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            void* Pop()
+            {
+                uint64 head = readIndex.load(std::memory_order_relaxed);
+                if (head == writeIndex.load(std::memory_order_acquire))
+                    return nullptr;
+
+                void* ptr = slots[head % ringCapacity];
+                readIndex.store(head + 1, std::memory_order_release);
+                return ptr;
+            }
+
+        private:
+
+            alignas(64) std::atomic<uint64> writeIndex = 0;
+            alignas(64) std::atomic<uint64> readIndex  = 0;
+            std::array<void*, ringCapacity> slots      = {};
+        };
+
+        // スレッドごとの計測結果
+        struct ThreadSamples
+        {
+            std::vector<uint64> alloc;
+            std::vector<uint64> free;
+        };
+
+        static void MergeLatency(Result& result, std::vector<ThreadSamples>& samples)
+        {
+            std::vector<uint64> allocSamples;
+            std::vector<uint64> freeSamples;
+
+            for (ThreadSamples& s : samples)
+            {
+                allocSamples.insert(allocSamples.end(), s.alloc.begin(), s.alloc.end());
+                freeSamples.insert(freeSamples.end(), s.free.begin(), s.free.end());
+            }
+
+            result.hasLatency   = true;
+            result.allocLatency = ComputePercentiles(allocSamples);
+            result.freeLatency  = ComputePercentiles(freeSamples);
+        }
+    }
+
+
+    //===============================================================
+    // 固定サイズ: バッチ単位で確保し、確保した順に全て解放する
+    //===============================================================
+    template<bool MEASURE, typename Allocator>
+    static void FixedWorker(Allocator& allocator, uint64 operations, uint32 batch, Internal::ThreadSamples* samples)
+    {
+        std::vector<void*> live(batch);
+
+        for (uint64 done = 0; done < operations; done += batch)
+        {
+            uint32 count = (uint32)std::min<uint64>(batch, operations - done);
+
+            for (uint32 i = 0; i < count; i++)
+            {
+                if constexpr (MEASURE)
+                {
+                    auto begin = Clock::now();
+                    live[i] = allocator.Allocate(fixedBlockByteSize);
+                    samples->alloc.push_back(Internal::ElapsedNs(begin, Clock::now()));
+                }
+                else
+                {
+                    live[i] = allocator.Allocate(fixedBlockByteSize);
+                }
+
+                Internal::Touch(live[i]);
+            }
+
+            for (uint32 i = 0; i < count; i++)
+            {
+                if constexpr (MEASURE)
+                {
+                    auto begin = Clock::now();
+                    allocator.Free(live[i], fixedBlockByteSize);
+                    samples->free.push_back(Internal::ElapsedNs(begin, Clock::now()));
+                }
+                else
+                {
+                    allocator.Free(live[i], fixedBlockByteSize);
+                }
+            }
+
+            allocator.EndBatch();
+        }
+    }
+
+    template<typename Allocator>
+    static Result RunFixed(const char* pattern, const Config& config, uint32 numThreads)
+    {
+        Allocator allocator;
+
+        Result result     = {};
+        result.pattern    = pattern;
+        result.allocator  = Allocator::name;
+        result.threads    = numThreads;
+        result.operations = config.operations;
+
+        const uint64 perThread = config.operations / numThreads;
+
+        // スループット（計測のオーバーヘッドを含めない）
+        {
+            Internal::StartBarrier barrier(numThreads);
+            Internal::WallTime     wallTime;
+            std::vector<std::thread> threads;
+
+            for (uint32 t = 0; t < numThreads; t++)
+            {
+                threads.emplace_back([&]
+                {
+                    barrier.ArriveAndWait();
+
+                    wallTime.Begin();
+                    FixedWorker<false>(allocator, perThread, config.batch, nullptr);
+                    wallTime.End();
+                });
+            }
+
+            for (std::thread& thread : threads)
+                thread.join();
+
+            result.seconds = wallTime.GetSeconds();
+        }
+
+        // レイテンシ（1操作ごとに計測するので、スループットとは別に実行する）
+        {
+            std::vector<Internal::ThreadSamples> samples(numThreads);
+            std::vector<std::thread>             threads;
+
+            for (uint32 t = 0; t < numThreads; t++)
+            {
+                samples[t].alloc.reserve(perThread);
+                samples[t].free.reserve(perThread);
+
+                threads.emplace_back([&, t]
+                {
+                    FixedWorker<true>(allocator, perThread, config.batch, &samples[t]);
+                });
+            }
+
+            for (std::thread& thread : threads)
+                thread.join();
+
+            Internal::MergeLatency(result, samples);
+        }
+
+        return result;
+    }
+
+
+    //===============================================================
+    // ランダムサイズ: 生存中のスロットをランダムに選び、解放して別サイズで確保し直す
+    //---------------------------------------------------------------
+    // サイズ分布は 16B〜256B: 70%, 〜4KB: 25%, 〜64KB: 5%
+    //===============================================================
+    namespace Internal
+    {
+        static std::vector<uint64> GenerateRandomSizes(uint64 count)
+        {
+            std::mt19937_64 engine(0x5133ull);
+            std::uniform_int_distribution<uint32> bucket(0, 99);
+            std::uniform_int_distribution<uint64> small(16, 256);
+            std::uniform_int_distribution<uint64> medium(257, 4096);
+            std::uniform_int_distribution<uint64> large(4097, 65536);
+
+            std::vector<uint64> sizes(count);
+            for (uint64& size : sizes)
+            {
+                uint32 b = bucket(engine);
+                size = b < 70 ? small(engine) : b < 95 ? medium(engine) : large(engine);
+            }
+
+            return sizes;
+        }
+
+        static std::vector<uint32> GenerateRandomSlots(uint64 count)
+        {
+            std::mt19937 engine(0x1eaf);
+            std::uniform_int_distribution<uint32> slot(0, randomSlotCount - 1);
+
+            std::vector<uint32> slots(count);
+            for (uint32& s : slots)
+                s = slot(engine);
+
+            return slots;
+        }
+    }
+
+    template<bool MEASURE, typename Allocator>
+    static void RandomWorker(Allocator& allocator, const std::vector<uint64>& sizes, const std::vector<uint32>& slots, Internal::ThreadSamples* samples)
+    {
+        std::array<void*,  randomSlotCount> live     = {};
+        std::array<uint64, randomSlotCount> liveSize = {};
+
+        for (uint64 i = 0; i < sizes.size(); i++)
+        {
+            uint32 slot = slots[i];
+
+            if (live[slot])
+            {
+                if constexpr (MEASURE)
+                {
+                    auto begin = Clock::now();
+                    allocator.Free(live[slot], liveSize[slot]);
+                    samples->free.push_back(Internal::ElapsedNs(begin, Clock::now()));
+                }
+                else
+                {
+                    allocator.Free(live[slot], liveSize[slot]);
+                }
+            }
+
+            if constexpr (MEASURE)
+            {
+                auto begin = Clock::now();
+                live[slot] = allocator.Allocate(sizes[i]);
+                samples->alloc.push_back(Internal::ElapsedNs(begin, Clock::now()));
+            }
+            else
+            {
+                live[slot] = allocator.Allocate(sizes[i]);
+            }
+
+            liveSize[slot] = sizes[i];
+            Internal::Touch(live[slot]);
+        }
+
+        for (uint32 slot = 0; slot < randomSlotCount; slot++)
+        {
+            if (live[slot])
+                allocator.Free(live[slot], liveSize[slot]);
+        }
+
+        allocator.EndBatch();
+    }
+
+    template<typename Allocator>
+    static Result RunRandom(const Config& config)
+    {
+        Allocator allocator;
+
+        Result result     = {};
+        result.pattern    = "random_size";
+        result.allocator  = Allocator::name;
+        result.threads    = 1;
+        result.operations = config.operations;
+
+        const std::vector<uint64> sizes = Internal::GenerateRandomSizes(config.operations);
+        const std::vector<uint32> slots = Internal::GenerateRandomSlots(config.operations);
+
+        auto begin = Clock::now();
+        RandomWorker<false>(allocator, sizes, slots, nullptr);
+        result.seconds = Internal::ElapsedNs(begin, Clock::now()) * 1e-9;
+
+        std::vector<Internal::ThreadSamples> samples(1);
+        samples[0].alloc.reserve(config.operations);
+        samples[0].free.reserve(config.operations);
+
+        RandomWorker<true>(allocator, sizes, slots, &samples[0]);
+        Internal::MergeLatency(result, samples);
+
+        return result;
+    }
+
+
+    //===============================================================
+    // 生産者・消費者: 生産者が確保した要素を、対になる消費者スレッドが解放する
+    //===============================================================
+    template<bool MEASURE, typename Allocator>
+    static void ProducerConsumer(Allocator& allocator, uint32 numPairs, uint64 perPair, std::vector<Internal::ThreadSamples>* samples, double* seconds)
+    {
+        std::vector<Internal::SPSCRing> rings(numPairs);
+        Internal::StartBarrier barrier(numPairs * 2);
+        Internal::WallTime     wallTime;
+        std::vector<std::thread> threads;
+
+        for (uint32 p = 0; p < numPairs; p++)
+        {
+            threads.emplace_back([&, p]
+            {
+                barrier.ArriveAndWait();
+                wallTime.Begin();
+
+                for (uint64 i = 0; i < perPair; i++)
+                {
+                    void* ptr = nullptr;
+                    if constexpr (MEASURE)
+                    {
+                        auto begin = Clock::now();
+                        ptr = allocator.Allocate(fixedBlockByteSize);
+                        (*samples)[p].alloc.push_back(Internal::ElapsedNs(begin, Clock::now()));
+                    }
+                    else
+                    {
+                        ptr = allocator.Allocate(fixedBlockByteSize);
+                    }
+
+                    Internal::Touch(ptr);
+
+                    while (!rings[p].Push(ptr))
+                        std::this_thread::yield();
+                }
+            });
+
+            threads.emplace_back([&, p]
+            {
+                barrier.ArriveAndWait();
+
+                for (uint64 i = 0; i < perPair; i++)
+                {
+                    void* ptr = nullptr;
+                    while (!(ptr = rings[p].Pop()))
+                        std::this_thread::yield();
+
+                    if constexpr (MEASURE)
+                    {
+                        auto begin = Clock::now();
+                        allocator.Free(ptr, fixedBlockByteSize);
+                        (*samples)[p].free.push_back(Internal::ElapsedNs(begin, Clock::now()));
+                    }
+                    else
+                    {
+                        allocator.Free(ptr, fixedBlockByteSize);
+                    }
+                }
+
+                wallTime.End();
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        if (seconds)
+            *seconds = wallTime.GetSeconds();
+    }
+
+    template<typename Allocator>
+    static Result RunProducerConsumer(const Config& config)
+    {
+        Allocator allocator;
+
+        const uint32 numPairs = std::max(config.threads / 2, 1u);
+        const uint64 perPair  = config.operations / numPairs;
+
+        Result result     = {};
+        result.pattern    = "producer_consumer";
+        result.allocator  = Allocator::name;
+        result.threads    = numPairs * 2;
+        result.operations = perPair * numPairs;
+
+        ProducerConsumer<false>(allocator, numPairs, perPair, nullptr, &result.seconds);
+
+        std::vector<Internal::ThreadSamples> samples(numPairs);
+        for (Internal::ThreadSamples& s : samples)
+        {
+            s.alloc.reserve(perPair);
+            s.free.reserve(perPair);
+        }
+
+        ProducerConsumer<true>(allocator, numPairs, perPair, &samples, nullptr);
+        Internal::MergeLatency(result, samples);
+
+        return result;
+    }
+
+
+    //===============================================================
+    // サイズクラス選択（MemoryPool.cpp の SelectPoolIndex と同じ分岐）
+    //===============================================================
+    namespace Internal
+    {
+        static uint32 SelectPoolIndexBranch(uint64 requestByteSize)
+        {
+            if      (  1 <= requestByteSize && requestByteSize <=   32) { return 0; }
+            else if ( 33 <= requestByteSize && requestByteSize <=   64) { return 1; }
+            else if ( 65 <= requestByteSize && requestByteSize <=  128) { return 2; }
+            else if (129 <= requestByteSize && requestByteSize <=  256) { return 3; }
+            else if (257 <= requestByteSize && requestByteSize <=  512) { return 4; }
+            else if (513 <= requestByteSize && requestByteSize <= 1024) { return 5; }
+            else if (requestByteSize > 1024)                            { return (uint32)std::bit_width(requestByteSize - 1) - 5; }
+
+            return 0;
+        }
+
+        static uint32 SelectPoolIndexBitScan(uint64 requestByteSize)
+        {
+            return requestByteSize <= 32 ? 0 : (uint32)std::bit_width(requestByteSize - 1) - 5;
+        }
+    }
+
+    template<uint32 (*SELECT)(uint64)>
+    static Result RunSelectPoolIndex(const char* name, const Config& config)
+    {
+        std::mt19937_64 engine(0x5e1ec7ull);
+        std::uniform_int_distribution<uint64> size(1, 1024);
+
+        std::vector<uint64> sizes(4096);
+        for (uint64& s : sizes)
+            s = size(engine);
+
+        Result result     = {};
+        result.pattern    = "select_pool_index";
+        result.allocator  = name;
+        result.threads    = 1;
+        result.operations = config.operations;
+
+        volatile uint32 sink = 0;
+        uint32 accumulate    = 0;
+
+        auto begin = Clock::now();
+
+        for (uint64 i = 0; i < config.operations; i++)
+            accumulate += SELECT(sizes[i & (sizes.size() - 1)]);
+
+        result.seconds = Internal::ElapsedNs(begin, Clock::now()) * 1e-9;
+        sink = accumulate;
+
+        return result;
+    }
+
+
+    //===============================================================
+    // 実行・出力
+    //===============================================================
+    template<typename Allocator>
+    static void RunAllPatterns(const Config& config, std::vector<Result>& results)
+    {
+        std::fprintf(stderr, "running %s ...\n", Allocator::name);
+
+        results.push_back(RunFixed<Allocator>("single_fixed", config, 1));
+
+        if constexpr (Allocator::threadSafe)
+        {
+            results.push_back(RunFixed<Allocator>("multi_fixed", config, config.threads));
+            results.push_back(RunProducerConsumer<Allocator>(config));
+        }
+
+        if constexpr (Allocator::variableSize && Allocator::freeEach)
+        {
+            results.push_back(RunRandom<Allocator>(config));
+        }
+    }
+
+    static double MeasureTimerOverhead()
+    {
+        constexpr uint32 count = 100000;
+
+        auto begin = Clock::now();
+        for (uint32 i = 0; i < count; i++)
+        {
+            auto t = Clock::now();
+            SL_DONT_USE_VAR(t);
+        }
+
+        return (double)Internal::ElapsedNs(begin, Clock::now()) / count;
+    }
+
+    static void WritePercentiles(FILE* out, const char* key, const Percentiles& p)
+    {
+        std::fprintf(out, "\"%s\": { \"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"p999\": %.1f, \"max\": %.1f }", key, p.p50, p.p90, p.p99, p.p999, p.max);
+    }
+
+    static void WriteJson(FILE* out, const Config& config, double timerOverhead, const std::vector<Result>& results)
+    {
+#if SL_DEBUG
+        const char* build = "Debug";
+#else
+        const char* build = "Release";
+#endif
+
+        std::fprintf(out, "{\n");
+        std::fprintf(out, "  \"config\": { \"operations\": %llu, \"threads\": %u, \"batch\": %u, \"blockByteSize\": %llu, \"build\": \"%s\" },\n",
+            (unsigned long long)config.operations, config.threads, config.batch, (unsigned long long)fixedBlockByteSize, build);
+        std::fprintf(out, "  \"timerOverheadNs\": %.1f,\n", timerOverhead);
+        std::fprintf(out, "  \"results\": [\n");
+
+        for (uint64 i = 0; i < results.size(); i++)
+        {
+            const Result& r = results[i];
+            const double opsPerSecond = r.seconds > 0.0 ? (double)r.operations / r.seconds : 0.0;
+
+            std::fprintf(out, "    { \"pattern\": \"%s\", \"allocator\": \"%s\", \"threads\": %u, \"operations\": %llu, \"seconds\": %.6f, \"opsPerSecond\": %.0f, ",
+                r.pattern, r.allocator, r.threads, (unsigned long long)r.operations, r.seconds, opsPerSecond);
+
+            if (r.hasLatency)
+            {
+                WritePercentiles(out, "allocLatencyNs", r.allocLatency);
+                std::fprintf(out, ", ");
+                WritePercentiles(out, "freeLatencyNs", r.freeLatency);
+            }
+            else
+            {
+                std::fprintf(out, "\"allocLatencyNs\": null, \"freeLatencyNs\": null");
+            }
+
+            std::fprintf(out, " }%s\n", i + 1 < results.size() ? "," : "");
+        }
+
+        std::fprintf(out, "  ]\n}\n");
+    }
+
+    static bool ParseArguments(int argc, char** argv, Config& config)
+    {
+        config.threads = std::max(std::thread::hardware_concurrency(), 2u);
+
+        for (int i = 1; i < argc; i++)
+        {
+            const bool hasValue = i + 1 < argc;
+
+            if      (!std::strcmp(argv[i], "--operations") && hasValue) config.operations = std::strtoull(argv[++i], nullptr, 10);
+            else if (!std::strcmp(argv[i], "--threads")    && hasValue) config.threads    = (uint32)std::strtoul(argv[++i], nullptr, 10);
+            else if (!std::strcmp(argv[i], "--batch")      && hasValue) config.batch      = (uint32)std::strtoul(argv[++i], nullptr, 10);
+            else if (!std::strcmp(argv[i], "--output")     && hasValue) config.output     = argv[++i];
+            else
+            {
+                std::fprintf(stderr, "usage: %s [--operations N] [--threads N] [--batch N] [--output file.json]\n", argv[0]);
+                return false;
+            }
+        }
+
+        // ResourceStorage の最大要素数（チャンク 256 × 256 要素）を超えないように制限する
+        config.threads    = std::clamp(config.threads, 1u, 64u);
+        config.batch      = std::clamp(config.batch,   1u, 512u);
+        config.operations = std::max<uint64>(config.operations, config.threads);
+
+        return true;
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    using namespace Silex;
+    using namespace Silex::Benchmark;
+
+    Config config;
+    if (!ParseArguments(argc, argv, config))
+        return 1;
+
+    Memory::Initialize();
+
+    std::vector<Result> results;
+    {
+        RunAllPatterns<MallocAllocator>(config, results);
+        RunAllPatterns<MemoryPoolAllocator>(config, results);
+        RunAllPatterns<LinearBumpAllocator>(config, results);
+        RunAllPatterns<PagedBlockAllocator>(config, results);
+        RunAllPatterns<ConcurrentPagedBlockAllocator>(config, results);
+        RunAllPatterns<ResourceStorageAllocator>(config, results);
+
+        results.push_back(RunSelectPoolIndex<Benchmark::Internal::SelectPoolIndexBranch>("if_chain", config));
+        results.push_back(RunSelectPoolIndex<Benchmark::Internal::SelectPoolIndexBitScan>("bit_scan", config));
+    }
+
+    const double timerOverhead = MeasureTimerOverhead();
+
+    FILE* out = stdout;
+    if (config.output)
+    {
+        out = std::fopen(config.output, "w");
+        if (!out)
+        {
+            std::fprintf(stderr, "cannot open %s\n", config.output);
+            return 1;
+        }
+    }
+
+    WriteJson(out, config, timerOverhead, results);
+
+    if (out != stdout)
+        std::fclose(out);
+
+    Memory::Finalize();
+    return 0;
+}
@@ -2,7 +2,9 @@
 #include "PCH.h"
 
 #include "Core/Random.h"
+#include "Core/TaskGraph.h"
 #include "Asset/Asset.h"
+#include "Asset/TextureReader.h"
 #include "Editor/EditorSplashImage.h"
 #include "Rendering/Mesh.h"
 #include "Rendering/Environment.h"
@@ -121,21 +123,15 @@ namespace Silex
 
     bool AssetManager::IsExistInMetadata(const std::filesystem::path& directory)
     {
-        for (auto& [id, metadata] : metadata)
-        {
-            if (metadata.path == directory)
-                return true;
-        }
-
-        return false;
+        return pathToID.contains(_PathToKey(directory));
     }
 
     AssetMetadata AssetManager::GetMetadata(const std::filesystem::path& directory)
     {
-        for (auto& [id, metadata] : metadata)
+        auto it = pathToID.find(_PathToKey(directory));
+        if (it != pathToID.end())
         {
-            if (metadata.path == directory)
-                return metadata;
+            return metadata.at(it->second);
         }
 
         return {};
@@ -151,12 +147,12 @@ namespace Silex
         return metadata[id];
     }
 
-    std::unordered_map<AssetID, Ref<Asset>>& AssetManager::GetAllAssets()
+    FlatHashMap<AssetID, Ref<Asset>>& AssetManager::GetAllAssets()
     {
         return assetData;
     }
 
-    std::unordered_map<AssetID, AssetMetadata>& AssetManager::GetMetadatas()
+    FlatHashMap<AssetID, AssetMetadata>& AssetManager::GetMetadatas()
     {
         return metadata;
     }
@@ -267,8 +263,7 @@ namespace Silex
             }
 
             // メタデータを登録
-            AssetID id = md.id;
-            metadata[id] = md;
+            _RegisterMetadata(md);
         }
     }
 
@@ -320,18 +315,35 @@ namespace Silex
         md.path = dir;
         md.type = Asset::FileNameToAssetType(dir);
 
-        metadata[md.id] = md;
+        _RegisterMetadata(md);
         return md;
     }
 
+    void AssetManager::_RegisterMetadata(const AssetMetadata& md)
+    {
+        metadata[md.id] = md;
+        pathToID[_PathToKey(md.path)] = md.id;
+    }
+
     void AssetManager::_RemoveFromMetadata(const AssetID id)
     {
-        if (metadata.contains(id))
+        auto it = metadata.find(id);
+        if (it != metadata.end())
         {
-            metadata.erase(id);
+            pathToID.erase(_PathToKey(it->second.path));
+            metadata.erase(it);
         }
     }
 
+    StringID AssetManager::_PathToKey(const std::filesystem::path& path)
+    {
+        // 検索キーとしてのみ使うので、文字列テーブルには登録しない
+        std::string str = path.string();
+        std::replace(str.begin(), str.end(), '\\', '/');
+
+        return StringID::Lookup(str);
+    }
+
     void AssetManager::_RemoveFromAsset(const AssetID id)
     {
         if (assetData.contains(id))
@@ -368,71 +380,97 @@ namespace Silex
     }
 
     //===========================================================================
-    // マテリアルがテクスチャに依存するので、アセットタイプごとにイテレーションするようにする
-    // 必要があれば、アセットタイプごとのデータ群を返す関数を追加する
+    // テクスチャのデコード（CPU 処理）のみをワーカーで並列に実行し
+    // GPU リソースの生成・転送を伴う処理はメインスレッドで依存順に行う (テクスチャ → 環境マップ → マテリアル → メッシュ)
+    // テクスチャの転送は非同期に送信し、GPU の完了待ちを1回にまとめる
+    //---------------------------------------------------------------------------
+    // 即時コマンドのコマンドプール・キューは外部同期が必要なので、ワーカーからは送信しない
     //===========================================================================
     void AssetManager::_LoadAssetToMemory(const std::filesystem::path& filePath)
     {
-        INIT_PROCESS("Load Texture", 20);
+        std::vector<const AssetMetadata*> textures;
+        std::vector<const AssetMetadata*> environments;
+        std::vector<const AssetMetadata*> materials;
+        std::vector<const AssetMetadata*> meshes;
 
-        // テクスチャ2D: マテリアルから参照されるので、最初に読み込むこと!
         for (auto& [aid, md] : metadata)
         {
-            if (md.type == AssetType::Texture && !IsBuiltInAssetID(aid))
-            {
-                AssetID id       = md.id;
-                std::string path = md.path.string();
-
-                Ref<Asset> asset = nullptr;
-                asset = LoadAssetFromFile<Texture2DAsset>(path);
+            if (IsBuiltInAssetID(aid))
+                continue;
 
-                instance->_AddToAssetAndID(id, asset);
+            switch (md.type)
+            {
+                case AssetType::Texture:     textures.push_back(&md);     break;
+                case AssetType::Environment: environments.push_back(&md); break;
+                case AssetType::Material:    materials.push_back(&md);    break;
+                case AssetType::Mesh:        meshes.push_back(&md);       break;
+                default: break;
             }
         }
 
-        INIT_PROCESS("Load EnvironmentMap", 40);
+        TaskGraph graph;
 
-        // 環境マップ
-        for (auto& [aid, md] : metadata)
+        // テクスチャ2D: デコードはファイルごとに並列実行
+        std::vector<TextureReader> readers(textures.size());
+        for (uint32 i = 0; i < textures.size(); i++)
         {
-            if (md.type == AssetType::Environment && !IsBuiltInAssetID(aid))
+            graph.AddTask([&, i]()
             {
-                AssetID id       = md.id;
-                std::string path = md.path.string();
+                std::string path = textures[i]->path.string();
 
-                Ref<Asset> asset = LoadAssetFromFile<EnvironmentAsset>(path);
-                instance->_AddToAssetAndID(id, asset);
-            }
+                if (readers[i].IsHDR(path.c_str())) readers[i].ReadHDR(path.c_str());
+                else                                readers[i].Read(path.c_str());
+            });
         }
 
-        INIT_PROCESS("Load Material", 60);
+        // スプラッシュ画面の更新はメインスレッドから行う
+        INIT_PROCESS("Load Texture", 20);
+        graph.Run();
+        graph.Wait();
 
-        // マテリアル
-        for (auto& [aid, md] : metadata)
+        // テクスチャ2D: マテリアルから参照されるので、最初に読み込むこと!
+        // 転送はまとめて送信し、フェンスの完了をまとめて待機する
+        std::vector<AsyncTask<Ref<Texture2DAsset>>> uploads;
+        uploads.reserve(textures.size());
+
+        for (uint32 i = 0; i < textures.size(); i++)
         {
-            if (md.type == AssetType::Material && !IsBuiltInAssetID(aid))
-            {
-                AssetID id       = md.id;
-                std::string path = md.path.string();
+            uploads.push_back(AssetImporter::ImportTextureAsync(textures[i]->path.string(), readers[i].data));
+        }
 
-                Ref<Asset> asset = LoadAssetFromFile<MaterialAsset>(path);
-                instance->_AddToAssetAndID(id, asset);
-            }
+        std::vector<Ref<Texture2DAsset>> textureAssets = SyncWait(WhenAll(std::move(uploads)));
+
+        for (uint32 i = 0; i < textures.size(); i++)
+        {
+            readers[i].Unload(readers[i].data.pixels);
+
+            // 転送に失敗したテクスチャは登録しない（参照するマテリアルはテクスチャ無しとして扱われる）
+            if (textureAssets[i])
+                instance->_AddToAssetAndID(textures[i]->id, textureAssets[i]);
         }
 
-        INIT_PROCESS("Load Mesh", 80);
+        // 環境マップ
+        INIT_PROCESS("Load EnvironmentMap", 40);
+        for (const AssetMetadata* md : environments)
+        {
+            Ref<Asset> asset = LoadAssetFromFile<EnvironmentAsset>(md->path.string());
+            instance->_AddToAssetAndID(md->id, asset);
+        }
 
-        // メッシュ
-        for (auto& [aid, md] : metadata)
+        // マテリアル
+        INIT_PROCESS("Load Material", 60);
+        for (const AssetMetadata* md : materials)
         {
-            if (md.type == AssetType::Mesh && !IsBuiltInAssetID(aid))
-            {
-                AssetID id       = md.id;
-                std::string path = md.path.string();
+            Ref<Asset> asset = LoadAssetFromFile<MaterialAsset>(md->path.string());
+            instance->_AddToAssetAndID(md->id, asset);
+        }
 
-                Ref<Asset> asset = LoadAssetFromFile<MeshAsset>(path);
-                instance->_AddToAssetAndID(id, asset);
-            }
+        // メッシュ
+        INIT_PROCESS("Load Mesh", 80);
+        for (const AssetMetadata* md : meshes)
+        {
+            Ref<Asset> asset = LoadAssetFromFile<MeshAsset>(md->path.string());
+            instance->_AddToAssetAndID(md->id, asset);
         }
     }
 }
@@ -3,6 +3,8 @@
 
 #include "Core/Core.h"
 #include "Core/Random.h"
+#include "Core/FlatHashMap.h"
+#include "Core/StringID.h"
 #include "Asset/AssetImporter.h"
 #include "Asset/AssetCreator.h"
 
@@ -57,8 +59,8 @@ namespace Silex
         void    SetAssetID(AssetID id) { assetID = id;   }
 
         // 名前
-        void               SetName(const std::string& name) { assetName = name; }
-        const std::string& GetName() const                  { return assetName; }
+        void     SetName(const std::string& name) { assetName = StringID(name); }
+        StringID GetName() const                  { return assetName; }
 
         // プロパティ設定
         void SetupAssetProperties(const std::string& filePath, AssetType flag)
@@ -90,7 +92,7 @@ namespace Silex
         AssetID     assetID        = 0;
         AssetType   assetFlag      = AssetType::None;
         std::string assetFilePath  = {};
-        std::string assetName      = {};
+        StringID    assetName      = {};
     };
 
 
@@ -197,23 +199,34 @@ namespace Silex
         AssetMetadata GetMetadata(const std::filesystem::path& directory);
         AssetMetadata GetMetadata(AssetID id);
 
-        std::unordered_map<AssetID, AssetMetadata>& GetMetadatas();
+        FlatHashMap<AssetID, AssetMetadata>& GetMetadatas();
 
         //=================================
         // アセット
         //=================================
         bool IsLoaded(const AssetID id);
-        std::unordered_map<AssetID, Ref<Asset>>& GetAllAssets();
+        FlatHashMap<AssetID, Ref<Asset>>& GetAllAssets();
 
+        // 毎フレーム / プロパティ行ごとに呼ばれるので、未登録 ID で空要素を挿入しないように検索のみ行う
         template<class T>
         Ref<T> GetAssetAs(const AssetID id)
         {
-            return assetData[id].As<T>();
+            auto it = assetData.find(id);
+            return it != assetData.end() ? it->second.As<T>() : nullptr;
         }
 
         Ref<Asset> GetAsset(const AssetID id)
         {
-            return assetData[id];
+            auto it = assetData.find(id);
+            return it != assetData.end() ? it->second : nullptr;
+        }
+
+        // 所有権が不要な読み取り用（参照カウントを操作しない）
+        template<class T>
+        RefView<T> GetAssetViewAs(const AssetID id)
+        {
+            auto it = assetData.find(id);
+            return it != assetData.end() ? it->second.AsView<T>() : nullptr;
         }
 
         template<class T, class... Args>
@@ -276,7 +289,7 @@ namespace Silex
             md.path = filePath;
             md.type = type;
 
-            instance->metadata[currentBuiltinAssetCount] = md;
+            instance->_RegisterMetadata(md);
         }
 
 
@@ -293,6 +306,7 @@ namespace Silex
 
         // アセット・メタデータ追加
         AssetMetadata _AddToMetadata(const std::filesystem::path& directory);
+        void          _RegisterMetadata(const AssetMetadata& md);
         void          _AddToAssetAndID(const AssetID id, Ref<Asset> asset);
         void          _AddToAsset(Ref<Asset> asset);
 
@@ -311,8 +325,12 @@ namespace Silex
         uint32 currentBuiltinAssetCount  = 0;
         const uint32 reservedBuiltinAssetCount = 256;
 
-        std::unordered_map<AssetID, Ref<Asset>>    assetData;
-        std::unordered_map<AssetID, AssetMetadata> metadata;
+        // パス → ID の索引（区切り文字を '/' に揃えたパス文字列のハッシュ値がキー）
+        static StringID _PathToKey(const std::filesystem::path& path);
+
+        FlatHashMap<AssetID, Ref<Asset>>    assetData;
+        FlatHashMap<AssetID, AssetMetadata> metadata;
+        FlatHashMap<StringID, AssetID>      pathToID;
 
         static inline const char* assetDatabasePath = "Assets/AssetDatabase.yml";
         static inline const char* assetDiectoryPath = "Assets";
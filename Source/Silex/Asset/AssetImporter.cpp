@@ -28,24 +28,56 @@ namespace Silex
     template<>
     Ref<Texture2DAsset> AssetImporter::Import<Texture2DAsset>(const std::string& filePath)
     {
-        Texture2D* texture = nullptr;
+        TextureReader reader;
+        if (reader.IsHDR(filePath.c_str())) reader.ReadHDR(filePath.c_str());
+        else                                reader.Read(filePath.c_str());
+
+        return ImportTexture(filePath, reader.data);
+    }
+
+    Ref<Texture2DAsset> AssetImporter::ImportTexture(const std::string& filePath, const TextureSourceData& source)
+    {
+        Texture2D* texture = source.isHDR?
+            Renderer::Get()->CreateTextureFromMemory((const float*)source.pixels, source.byteSize, source.width, source.height, true):
+            Renderer::Get()->CreateTextureFromMemory((const byte*)source.pixels,  source.byteSize, source.width, source.height, true);
+
+        Ref<Texture2DAsset> asset = CreateRef<Texture2DAsset>(texture);
+        asset->SetupAssetProperties(filePath, AssetType::Texture);
+
+        return asset;
+    }
+
+    AsyncTask<Ref<Texture2DAsset>> AssetImporter::ImportTextureAsync(std::string filePath)
+    {
+        // デコード
+        co_await ResumeOnThreadPool();
 
         TextureReader reader;
-        if (reader.IsHDR(filePath.c_str()))
-        {
-            float* pixelData = reader.ReadHDR(filePath.c_str());
-            texture = Renderer::Get()->CreateTextureFromMemory(pixelData, reader.data.byteSize, reader.data.width, reader.data.height, true);
-        }
-        else
+        if (reader.IsHDR(filePath.c_str())) reader.ReadHDR(filePath.c_str());
+        else                                reader.Read(filePath.c_str());
+
+        // GPU リソースの生成はメインスレッドで行う
+        co_await ResumeOnMainThread();
+
+        Ref<Texture2DAsset> asset = co_await ImportTextureAsync(std::move(filePath), reader.data);
+        reader.Unload(reader.data.pixels);
+
+        co_return asset;
+    }
+
+    AsyncTask<Ref<Texture2DAsset>> AssetImporter::ImportTextureAsync(std::string filePath, const TextureSourceData& source)
+    {
+        Texture2D* texture = co_await Renderer::Get()->CreateTextureFromMemoryAsync(source.pixels, source.byteSize, source.width, source.height, source.isHDR, true);
+        if (!texture)
         {
-            byte* pixelData = reader.Read(filePath.c_str());
-            texture = Renderer::Get()->CreateTextureFromMemory(pixelData, reader.data.byteSize, reader.data.width, reader.data.height, true);
+            SL_LOG_ERROR("テクスチャの転送に失敗しました: {}", filePath);
+            co_return nullptr;
         }
 
         Ref<Texture2DAsset> asset = CreateRef<Texture2DAsset>(texture);
         asset->SetupAssetProperties(filePath, AssetType::Texture);
 
-        return asset;
+        co_return asset;
     }
 
     template<>
@@ -2,15 +2,29 @@
 #pragma once
 #include "Core/Core.h"
 #include "Core/Ref.h"
+#include "Core/Coroutine.h"
 
 
 namespace Silex
 {
+    class  Texture2DAsset;
+    struct TextureSourceData;
+
     class AssetImporter
     {
     public:
 
         template<class T>
         static Ref<T> Import(const std::string& filePath);
+
+        // デコード済みのピクセルデータからテクスチャを生成する（デコードとアップロードを分離する場合に使用）
+        static Ref<Texture2DAsset> ImportTexture(const std::string& filePath, const TextureSourceData& source);
+
+        // デコードをワーカースレッドで行い、GPU への転送完了を待機せずに中断する（メインスレッドから呼び出すこと）
+        static AsyncTask<Ref<Texture2DAsset>> ImportTextureAsync(std::string filePath);
+
+        // デコード済みのピクセルデータを転送し、GPU への転送完了を待機せずに中断する（メインスレッドから呼び出すこと）
+        // source は転送用のバッファにコピーされるまで（= 最初の中断まで）参照される。転送に失敗した場合は nullptr を返す
+        static AsyncTask<Ref<Texture2DAsset>> ImportTextureAsync(std::string filePath, const TextureSourceData& source);
     };
 }
@@ -20,7 +20,8 @@ namespace Silex
             return nullptr;
         }
 
-        stbi_set_flip_vertically_on_load(flipOnRead);
+        // ワーカースレッドからの並列読み込みに対応するため、スレッドローカルなフラグを使用する
+        stbi_set_flip_vertically_on_load_thread(flipOnRead);
 
         reader->data.pixels = isHDR?
             (void*)stbi_loadf(path, &reader->data.width, &reader->data.height, &reader->data.channels, 4):
@@ -31,6 +32,7 @@ namespace Silex
             SL_LOG_ERROR("{} が見つからなかったか、データが破損しています", path);
         }
 
+        reader->data.isHDR    = isHDR;
         reader->data.byteSize = reader->data.width * reader->data.height * 4 * (isHDR? sizeof(float) : sizeof(byte));
         return reader->data.pixels;
     }
@@ -12,6 +12,7 @@ namespace Silex
         int32 height   = 0;
         int32 channels = 0;
         int64 byteSize = 0;
+        bool  isHDR    = false;
 
         void* pixels  = nullptr;
     };
@@ -0,0 +1,120 @@
+
+#include "PCH.h"
+#include "Coroutine.h"
+#include <fstream>
+
+
+namespace Silex
+{
+    namespace Internal
+    {
+        struct AsyncWaitEntry
+        {
+            std::coroutine_handle<>   handle;
+            AsyncScheduler::Predicate predicate;
+            bool                      resumeOnMainThread;
+        };
+    }
+
+    using Internal::AsyncWaitEntry;
+
+
+    static std::mutex                  waitEntryMutex;
+    static std::vector<AsyncWaitEntry> waitEntries;
+
+
+    void AsyncScheduler::Post(std::coroutine_handle<> handle, Predicate&& predicate, bool resumeOnMainThread)
+    {
+        std::lock_guard<std::mutex> lock(waitEntryMutex);
+        waitEntries.push_back({ handle, std::move(predicate), resumeOnMainThread });
+    }
+
+    bool AsyncScheduler::Poll()
+    {
+        const bool isMainThread = ThreadPool::IsMainThread();
+
+        std::vector<AsyncWaitEntry> readyEntries;
+
+        {
+            std::lock_guard<std::mutex> lock(waitEntryMutex);
+
+            for (uint64 i = 0; i < waitEntries.size();)
+            {
+                AsyncWaitEntry& entry = waitEntries[i];
+
+                // メインスレッド指定のものは、メインスレッド以外では条件も評価しない
+                bool ready = (isMainThread || !entry.resumeOnMainThread) && (!entry.predicate || entry.predicate());
+                if (ready)
+                {
+                    readyEntries.push_back(std::move(entry));
+
+                    if (i != waitEntries.size() - 1)
+                        entry = std::move(waitEntries.back());
+
+                    waitEntries.pop_back();
+                }
+                else
+                {
+                    i++;
+                }
+            }
+        }
+
+        // 再開したコルーチンが再度 Post する可能性があるので、ロック外で再開する
+        for (AsyncWaitEntry& entry : readyEntries)
+        {
+            if (entry.resumeOnMainThread)
+            {
+                entry.handle.resume();
+            }
+            else
+            {
+                std::coroutine_handle<> handle = entry.handle;
+                ThreadPool::AddTask([handle]() { handle.resume(); });
+            }
+        }
+
+        return !readyEntries.empty();
+    }
+
+
+    AsyncTask<std::vector<byte>> ReadFileAsync(std::filesystem::path path)
+    {
+        co_await ResumeOnIOThread();
+
+        std::vector<byte> data;
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            SL_LOG_ERROR("{} が見つかりませんでした", path.string());
+            co_return data;
+        }
+
+        data.resize((uint64)file.tellg());
+        file.seekg(0, std::ios::beg);
+        file.read((char*)data.data(), data.size());
+
+        co_return data;
+    }
+
+
+    void Internal::SyncWaitUntil(const std::atomic<bool>& completed)
+    {
+        const bool isMainThread = ThreadPool::IsMainThread();
+
+        while (!completed.load(std::memory_order_acquire))
+        {
+            if (isMainThread)
+                ThreadPool::ExecuteMainThreadTasks();
+
+            if (ThreadPool::ExecuteOneTask())
+                continue;
+
+            if (AsyncScheduler::Poll())
+                continue;
+
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,363 @@
+#pragma once
+#include "Core/ThreadPool.h"
+#include <coroutine>
+#include <optional>
+#include <utility>
+#include <filesystem>
+#include <vector>
+
+
+namespace Silex
+{
+    template<typename T = void>
+    class AsyncTask;
+
+
+    //==================================================================
+    // 非同期タスクの再開スケジューラー
+    //------------------------------------------------------------------
+    // 条件付き待機（GPU フェンス等）やメインスレッドでの再開を要求したコルーチンを保持し
+    // Poll 呼び出し時に条件を満たしたものを再開する（メインループで毎フレーム呼び出される）
+    //==================================================================
+    class AsyncScheduler
+    {
+    public:
+
+        using Predicate = std::function<bool()>;
+
+        // predicate が true を返した時点で handle を再開する（predicate が空の場合は次回の Poll で再開）
+        // resumeOnMainThread が true の場合はメインスレッドの Poll でのみ再開し、それ以外はスレッドプールで再開する
+        static void Post(std::coroutine_handle<> handle, Predicate&& predicate, bool resumeOnMainThread);
+
+        // 再開可能なコルーチンを再開する（再開したものがあれば true）
+        static bool Poll();
+    };
+
+
+    namespace Internal
+    {
+        template<typename T>
+        class AsyncPromise;
+
+        class AsyncPromiseBase
+        {
+        public:
+
+            // 呼び出し元に co_await されるまで実行しない
+            std::suspend_always initial_suspend() noexcept { return {}; }
+
+            // 完了後は待機しているコルーチンへ直接制御を移す
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept { return false; }
+                void await_resume() const noexcept {}
+
+                template<typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+                {
+                    std::coroutine_handle<> continuation = handle.promise().continuation;
+                    return continuation ? continuation : std::noop_coroutine();
+                }
+            };
+
+            FinalAwaiter final_suspend() noexcept { return {}; }
+
+            // 例外は使用しない
+            void unhandled_exception() noexcept { std::terminate(); }
+
+            std::coroutine_handle<> continuation = nullptr;
+        };
+
+        template<typename T>
+        class AsyncPromise : public AsyncPromiseBase
+        {
+        public:
+
+            AsyncTask<T> get_return_object() noexcept;
+
+            template<typename U>
+            void return_value(U&& v) { value.emplace(Traits::Forward<U>(v)); }
+
+            T Result() { return std::move(*value); }
+
+        private:
+
+            std::optional<T> value;
+        };
+
+        template<>
+        class AsyncPromise<void> : public AsyncPromiseBase
+        {
+        public:
+
+            AsyncTask<void> get_return_object() noexcept;
+
+            void return_void() noexcept {}
+            void Result() {}
+        };
+
+        // 完了を待機しない起動専用コルーチン（SyncWait の内部で使用）
+        struct DetachedTask
+        {
+            struct promise_type
+            {
+                DetachedTask        get_return_object() noexcept { return {}; }
+                std::suspend_never  initial_suspend()   noexcept { return {}; }
+                std::suspend_never  final_suspend()     noexcept { return {}; }
+                void                return_void()       noexcept {}
+                void                unhandled_exception() noexcept { std::terminate(); }
+            };
+        };
+    }
+
+
+    //==================================================================
+    // コルーチン非同期タスク
+    //------------------------------------------------------------------
+    // co_await されるまで実行されない（遅延開始）
+    // 完了すると、co_await しているコルーチンが同じスレッドで再開される
+    // コルーチン以外から結果を取得する場合は SyncWait を使用する
+    //==================================================================
+    template<typename T>
+    class AsyncTask
+    {
+    public:
+
+        using promise_type = Internal::AsyncPromise<T>;
+        using Handle       = std::coroutine_handle<promise_type>;
+
+        AsyncTask() = default;
+        explicit AsyncTask(Handle h) : handle(h) {}
+
+        AsyncTask(const AsyncTask&)            = delete;
+        AsyncTask& operator=(const AsyncTask&) = delete;
+
+        AsyncTask(AsyncTask&& other) noexcept
+            : handle(std::exchange(other.handle, nullptr))
+        {
+        }
+
+        AsyncTask& operator=(AsyncTask&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle) handle.destroy();
+                handle = std::exchange(other.handle, nullptr);
+            }
+
+            return *this;
+        }
+
+        ~AsyncTask()
+        {
+            if (handle) handle.destroy();
+        }
+
+        bool IsValid()     const { return handle != nullptr;             }
+        bool IsCompleted() const { return handle && handle.done();       }
+
+        auto operator co_await() noexcept
+        {
+            struct Awaiter
+            {
+                Handle handle;
+
+                bool await_ready() const noexcept
+                {
+                    return !handle || handle.done();
+                }
+
+                // 待機元を登録して、このタスクの実行を開始する
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+                {
+                    handle.promise().continuation = awaiting;
+                    return handle;
+                }
+
+                T await_resume()
+                {
+                    return handle.promise().Result();
+                }
+            };
+
+            return Awaiter{ handle };
+        }
+
+    private:
+
+        Handle handle = nullptr;
+    };
+
+    namespace Internal
+    {
+        template<typename T>
+        AsyncTask<T> AsyncPromise<T>::get_return_object() noexcept
+        {
+            return AsyncTask<T>(std::coroutine_handle<AsyncPromise<T>>::from_promise(*this));
+        }
+
+        inline AsyncTask<void> AsyncPromise<void>::get_return_object() noexcept
+        {
+            return AsyncTask<void>(std::coroutine_handle<AsyncPromise<void>>::from_promise(*this));
+        }
+    }
+
+
+    //==================================================================
+    // アウェイター
+    //==================================================================
+
+    // スレッドプールのワーカーで再開する
+    inline auto ResumeOnThreadPool(TaskPriority priority = TaskPriority::Normal) noexcept
+    {
+        struct Awaiter
+        {
+            TaskPriority priority;
+
+            bool await_ready() const noexcept { return false; }
+            void await_resume() const noexcept {}
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                ThreadPool::AddTask([handle]() { handle.resume(); }, nullptr, priority);
+            }
+        };
+
+        return Awaiter{ priority };
+    }
+
+    // メインスレッドで再開する（既にメインスレッドであれば中断しない）
+    inline auto ResumeOnMainThread() noexcept
+    {
+        struct Awaiter
+        {
+            bool await_ready() const noexcept { return ThreadPool::IsMainThread(); }
+            void await_resume() const noexcept {}
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                ThreadPool::AddMainThreadTask([handle]() { handle.resume(); });
+            }
+        };
+
+        return Awaiter{};
+    }
+
+    // I/O スレッドで再開する（ブロッキング処理でワーカーを占有しないように使用する）
+    inline auto ResumeOnIOThread() noexcept
+    {
+        struct Awaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            void await_resume() const noexcept {}
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                ThreadPool::AddIOTask([handle]() { handle.resume(); });
+            }
+        };
+
+        return Awaiter{};
+    }
+
+    // 条件を満たすまで中断する（条件は AsyncScheduler::Poll ごとに評価される）
+    inline auto WaitUntil(AsyncScheduler::Predicate&& predicate, bool resumeOnMainThread = false)
+    {
+        struct Awaiter
+        {
+            AsyncScheduler::Predicate predicate;
+            bool                      resumeOnMainThread;
+
+            bool await_ready() const { return predicate() && (!resumeOnMainThread || ThreadPool::IsMainThread()); }
+            void await_resume() const noexcept {}
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                AsyncScheduler::Post(handle, std::move(predicate), resumeOnMainThread);
+            }
+        };
+
+        return Awaiter{ std::move(predicate), resumeOnMainThread };
+    }
+
+
+    //==================================================================
+    // ユーティリティ
+    //==================================================================
+
+    // ファイル全体を I/O スレッドで読み込む（完了後は I/O スレッドで再開される）
+    AsyncTask<std::vector<byte>> ReadFileAsync(std::filesystem::path path);
+
+    namespace Internal
+    {
+        // フラグが立つまで、スレッドプール（メインスレッドではメインスレッドキューも）のタスク・スケジューラーの再開処理を実行しながら待機する
+        void SyncWaitUntil(const std::atomic<bool>& completed);
+    }
+
+    // 全てのタスクを同時に開始し、全ての完了を待機する（結果は tasks と同じ順に並ぶ）
+    // 呼び出したスレッドがメインスレッドであれば、完了後もメインスレッドで再開される
+    template<typename T>
+    AsyncTask<std::vector<T>> WhenAll(std::vector<AsyncTask<T>> tasks)
+    {
+        std::vector<std::optional<T>> results(tasks.size());
+        std::atomic<uint64>           remaining = tasks.size();
+
+        // 完了を通知した後は、このコルーチンのフレームに触れない
+        auto run = [](AsyncTask<T>& t, std::optional<T>& r, std::atomic<uint64>& c) -> Internal::DetachedTask
+        {
+            r.emplace(co_await t);
+            c.fetch_sub(1, std::memory_order_acq_rel);
+        };
+
+        for (uint64 i = 0; i < tasks.size(); i++)
+        {
+            run(tasks[i], results[i], remaining);
+        }
+
+        co_await WaitUntil([&remaining]() { return remaining.load(std::memory_order_acquire) == 0; }, ThreadPool::IsMainThread());
+
+        std::vector<T> values;
+        values.reserve(results.size());
+
+        for (std::optional<T>& result : results)
+        {
+            values.push_back(std::move(*result));
+        }
+
+        co_return values;
+    }
+
+    // コルーチン以外から非同期タスクを実行し、完了するまで待機する
+    template<typename T>
+    T SyncWait(AsyncTask<T> task)
+    {
+        std::atomic<bool> completed = false;
+
+        if constexpr (std::is_void_v<T>)
+        {
+            auto run = [](AsyncTask<T>& t, std::atomic<bool>& c) -> Internal::DetachedTask
+            {
+                co_await t;
+                c.store(true, std::memory_order_release);
+            };
+
+            run(task, completed);
+            Internal::SyncWaitUntil(completed);
+        }
+        else
+        {
+            std::optional<T> result;
+
+            auto run = [](AsyncTask<T>& t, std::optional<T>& r, std::atomic<bool>& c) -> Internal::DetachedTask
+            {
+                r.emplace(co_await t);
+                c.store(true, std::memory_order_release);
+            };
+
+            run(task, result, completed);
+            Internal::SyncWaitUntil(completed);
+
+            return std::move(*result);
+        }
+    }
+}
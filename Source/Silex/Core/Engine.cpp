@@ -5,7 +5,10 @@
 #include "Asset/Asset.h"
 #include "Editor/EditorSplashImage.h"
 #include "Core/ThreadPool.h"
+#include "Core/Coroutine.h"
+#include "Core/Profiler.h"
 #include "Rendering/RenderingContext.h"
+#include "Rendering/RenderThread.h"
 
 
 namespace Silex
@@ -21,6 +24,7 @@ namespace Silex
         // コア機能初期化
         Logger::Initialize();
         Memory::Initialize();
+        Profiler::Initialize();
         Input::Initialize();
         ThreadPool::Initialize();
 
@@ -51,6 +55,7 @@ namespace Silex
 
         ThreadPool::Finalize();
         Input::Finalize();
+        Profiler::Finalize();
         Memory::Finalize();
         Logger::Finalize();
 
@@ -84,6 +89,9 @@ namespace Silex
         result = renderer->Initialize(context);
         SL_CHECK(!result, false);
 
+        // 描画スレッド
+        RenderThread::Initialize();
+
         // ウィンドウコンテキスト生成
         result = mainWindow->SetupWindowContext(context);
         SL_CHECK(!result, false);
@@ -107,6 +115,8 @@ namespace Silex
 
         renderer->TEST();
 
+        // メインループ中に参照カウントが 0 になったオブジェクトは、セーフポイントまで破棄を遅延する
+        DeferredRelease::Initialize();
 
         // ウィンドウ表示
         mainWindow->Show();
@@ -116,6 +126,12 @@ namespace Silex
 
     void Engine::Finalize()
     {
+        // 描画中のフレームを完了させてから、描画スレッドを停止
+        RenderThread::Finalize();
+
+        // 遅延中のオブジェクトを破棄し、以降はその場で破棄する
+        DeferredRelease::Finalize();
+
         editor->Shutdown();
         sldelete(editor);
 
@@ -140,6 +156,11 @@ namespace Silex
     bool Engine::MainLoop()
     {
         CalcurateFrameTime();
+        MemoryTracker::NewFrame();
+
+        // メインスレッドキューのタスク・フェンス待ちのコルーチンを再開
+        ThreadPool::ExecuteMainThreadTasks();
+        AsyncScheduler::Poll();
 
         if (!minimized)
         {
@@ -147,13 +168,28 @@ namespace Silex
             renderer->BeginFrame();
             editorUI->BeginFrame();
 
-            // update
+            // render: 前フレームで確定したスナップショットの描画コマンドを描画スレッドで記録する
+            SceneRenderer*         sceneRenderer = editor->GetSceneRenderer();
+            const SceneRenderData& renderData    = sceneRenderer->GetRenderData();
+            const float            renderDelta   = deltaTime;
+
+            RenderThread::Kick([this, &renderData, renderDelta]()
+            {
+                renderer->Render(renderData, renderDelta);
+            });
+
+            // update: 描画と並行して、次フレームのスナップショットを生成する
             editor->Update(deltaTime);
             editor->UpdateUI();
             editorUI->Update();
 
-            // render
-            renderer->Render(deltaTime);
+            // シーン描画の記録完了を待ってから、同じコマンドバッファに UI を記録する
+            RenderThread::Wait();
+            sceneRenderer->Swap();
+
+            // セーフポイント: 描画スレッドは待機中で、前フレームのスナップショットの参照は全て終わっている
+            DeferredRelease::NewFrame();
+
             editorUI->Render();
 
             // submit
@@ -167,7 +203,8 @@ namespace Silex
             Input::Flush();
         }
 
-        PerformanceProfiler::Get().GetFrameData(&performanceData, true);
+        // このフレームで終了したゾーンを回収する
+        Profiler::NewFrame();
 
         // メインループ抜け出し確認
         return isRunning;
@@ -33,11 +33,6 @@ namespace Silex
         float   GetDeltaTime() const { return deltaTime; }
         uint32  GetFrameRate() const { return frameRate; }
 
-        const std::unordered_map<const char*, float>& GetPerformanceData() const
-        {
-            return performanceData;
-        }
-
     private:
 
         void OnWindowResize(WindowResizeEvent& e);
@@ -65,7 +60,5 @@ namespace Silex
         float  deltaTime     = 0.0f;
 
         std::string applicationName = "Silex";
-
-        std::unordered_map<const char*, float> performanceData;
     };
 }
@@ -0,0 +1,907 @@
+#pragma once
+
+#include "Core/Macros.h"
+#include "Core/CoreType.h"
+#include "Core/Hash.h"
+
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(_M_X64) || defined(__SSE2__)
+    #define SL_FLAT_HASH_MAP_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define SL_FLAT_HASH_MAP_SSE2 0
+#endif
+
+
+namespace Silex
+{
+    namespace Internal
+    {
+        // 64bit 値の混合（murmur3 fmix64）
+        // 制御バイトには下位 7bit、グループ選択には上位ビットを使うので、全ビットを攪拌しておく
+        constexpr uint64 MixHash64(uint64 value)
+        {
+            value ^= value >> 33;
+            value *= 0xFF51AFD7ED558CCDull;
+            value ^= value >> 33;
+            value *= 0xC4CEB9FE1A85EC53ull;
+            value ^= value >> 33;
+
+            return value;
+        }
+    }
+
+
+    //==================================================================
+    // FlatHashMap 用ハッシュ関数
+    //------------------------------------------------------------------
+    // ・整数 / 列挙型 / ポインタは、値（アドレス）を混合するだけ
+    // ・文字列は XXH3 で、std::string_view 経由の異種キー検索に対応する
+    //   （const char* / std::string_view で std::string を生成せずに検索できる）
+    // ・それ以外は std::hash の結果を混合する（std::hash は恒等写像の実装があるため）
+    //==================================================================
+    template<typename T>
+    struct FlatHash
+    {
+        uint64 operator()(const T& value) const
+        {
+            return Internal::MixHash64(static_cast<uint64>(std::hash<T>{}(value)));
+        }
+    };
+
+    template<typename T> requires (std::is_integral_v<T> || std::is_enum_v<T>)
+    struct FlatHash<T>
+    {
+        constexpr uint64 operator()(T value) const
+        {
+            return Internal::MixHash64(static_cast<uint64>(value));
+        }
+    };
+
+    template<typename T>
+    struct FlatHash<T*>
+    {
+        uint64 operator()(const T* ptr) const
+        {
+            return Internal::MixHash64(reinterpret_cast<uintptr_t>(ptr));
+        }
+    };
+
+    template<>
+    struct FlatHash<std::string>
+    {
+        using is_transparent = void;
+
+        uint64 operator()(std::string_view str) const
+        {
+            return Hash::XXH3(str);
+        }
+    };
+
+    template<>
+    struct FlatHash<std::string_view> : FlatHash<std::string>
+    {
+    };
+
+
+    //==================================================================
+    // オープンアドレス法ハッシュマップ（Swiss Table 方式）
+    //------------------------------------------------------------------
+    // ・要素は連続した配列に直接格納し、ノード確保もポインタ追跡も行わない
+    // ・各スロットに 1byte の制御バイトを持ち、16 スロット単位のグループで探索する
+    //     空: 0x80 / 削除済み: 0xFE / 使用中: ハッシュの下位 7bit
+    //   SSE2 で 16 バイトを一度に比較するので、キー比較はほぼ一致候補に対してのみ行われる
+    // ・グループは三角数列で探索し、グループ数が 2 の累乗なので全グループを巡回する
+    // ・最大負荷率は 7/8、削除済みが溜まった場合は同容量で再構築する
+    // ・Hasher / KeyEqual が両方 is_transparent を持つ場合、異種キーで検索できる
+    // ・Allocator は value_type の STL アロケーター（std::pmr::polymorphic_allocator 等も可）
+    //
+    // std::unordered_map との違い
+    // ・挿入で再構築が発生すると、全てのイテレーター / 参照が無効になる
+    // ・削除は他の要素を移動しないので、削除した要素以外の参照は有効なまま
+    //==================================================================
+    template<
+        typename K,
+        typename V,
+        typename Hasher    = FlatHash<K>,
+        typename KeyEqual  = std::equal_to<>,
+        typename Allocator = std::allocator<std::pair<const K, V>>>
+    class FlatHashMap
+    {
+    public:
+
+        using key_type        = K;
+        using mapped_type     = V;
+        using value_type      = std::pair<const K, V>;
+        using size_type       = uint64;
+        using hasher          = Hasher;
+        using key_equal       = KeyEqual;
+        using allocator_type  = Allocator;
+        using reference       = value_type&;
+        using const_reference = const value_type&;
+
+    private:
+
+        using SlotTraits     = std::allocator_traits<Allocator>;
+        using CtrlAllocator  = typename SlotTraits::template rebind_alloc<int8>;
+        using CtrlTraits     = std::allocator_traits<CtrlAllocator>;
+
+        static constexpr int8   ctrlEmpty   = -128; // 0x80
+        static constexpr int8   ctrlDeleted = -2;   // 0xFE
+        static constexpr uint32 groupWidth  = 16;
+        static constexpr uint64 npos        = ~0ull;
+
+        static constexpr bool isTransparent = requires
+        {
+            typename Hasher::is_transparent;
+            typename KeyEqual::is_transparent;
+        };
+
+        //==============================================================
+        // 制御バイトグループ（16 スロット分）
+        // 各 Match はスロット位置をビット位置としたマスクを返す
+        //==============================================================
+        struct Group
+        {
+#if SL_FLAT_HASH_MAP_SSE2
+            explicit Group(const int8* ctrl)
+                : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+            {}
+
+            uint32 Match(int8 h2) const
+            {
+                return static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+            }
+
+            // 空 / 削除済みは最上位ビットが立っている
+            uint32 MatchEmptyOrDeleted() const
+            {
+                return static_cast<uint32>(_mm_movemask_epi8(ctrl));
+            }
+
+            __m128i ctrl;
+#else
+            explicit Group(const int8* ctrl)
+            {
+                std::memcpy(bytes, ctrl, groupWidth);
+            }
+
+            uint32 Match(int8 h2) const
+            {
+                uint32 mask = 0;
+                for (uint32 i = 0; i < groupWidth; i++)
+                    mask |= static_cast<uint32>(bytes[i] == h2) << i;
+
+                return mask;
+            }
+
+            uint32 MatchEmptyOrDeleted() const
+            {
+                uint32 mask = 0;
+                for (uint32 i = 0; i < groupWidth; i++)
+                    mask |= static_cast<uint32>(bytes[i] < 0) << i;
+
+                return mask;
+            }
+
+            int8 bytes[groupWidth];
+#endif
+            uint32 MatchEmpty() const
+            {
+                return Match(ctrlEmpty);
+            }
+        };
+
+    public:
+
+        //==============================================================
+        // イテレーター（制御バイトを走査して、使用中スロットのみ返す）
+        //==============================================================
+        template<bool CONST>
+        class Iterator
+        {
+            friend class FlatHashMap;
+
+        public:
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = FlatHashMap::value_type;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = std::conditional_t<CONST, const value_type*, value_type*>;
+            using reference         = std::conditional_t<CONST, const value_type&, value_type&>;
+
+            Iterator() = default;
+
+            // iterator → const_iterator 変換
+            template<bool OTHER> requires (CONST && !OTHER)
+            Iterator(const Iterator<OTHER>& other)
+                : ctrl(other.ctrl), slot(other.slot), ctrlEnd(other.ctrlEnd)
+            {}
+
+            reference operator*()  const { return *slot; }
+            pointer   operator->() const { return slot;  }
+
+            Iterator& operator++()
+            {
+                ++ctrl;
+                ++slot;
+                _SkipEmpty();
+
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+            template<bool OTHER>
+            bool operator==(const Iterator<OTHER>& other) const { return ctrl == other.ctrl; }
+
+        private:
+
+            Iterator(const int8* ctrl, value_type* slot, const int8* ctrlEnd)
+                : ctrl(ctrl), slot(slot), ctrlEnd(ctrlEnd)
+            {}
+
+            void _SkipEmpty()
+            {
+                while (ctrl != ctrlEnd && *ctrl < 0)
+                {
+                    ++ctrl;
+                    ++slot;
+                }
+            }
+
+            template<bool> friend class Iterator;
+
+            const int8* ctrl    = nullptr;
+            value_type* slot    = nullptr;
+            const int8* ctrlEnd = nullptr;
+        };
+
+        using iterator       = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+    public:
+
+        FlatHashMap() = default;
+
+        explicit FlatHashMap(const Allocator& alloc)
+            : allocator(alloc)
+        {}
+
+        explicit FlatHashMap(size_type reserveCount, const Allocator& alloc = Allocator())
+            : allocator(alloc)
+        {
+            reserve(reserveCount);
+        }
+
+        FlatHashMap(std::initializer_list<value_type> list, const Allocator& alloc = Allocator())
+            : allocator(alloc)
+        {
+            reserve(list.size());
+            for (const value_type& value : list)
+                insert(value);
+        }
+
+        ~FlatHashMap()
+        {
+            _Release();
+        }
+
+        // 制御バイト列をそのまま複製し、要素を同じ位置にコピーする（再ハッシュ不要）
+        FlatHashMap(const FlatHashMap& other)
+            : hash(other.hash)
+            , equal(other.equal)
+            , allocator(SlotTraits::select_on_container_copy_construction(other.allocator))
+        {
+            _CopyFrom(other);
+        }
+
+        FlatHashMap(FlatHashMap&& other) noexcept
+            : hash(std::move(other.hash))
+            , equal(std::move(other.equal))
+            , allocator(std::move(other.allocator))
+        {
+            _StealFrom(other);
+        }
+
+        FlatHashMap& operator=(const FlatHashMap& other)
+        {
+            if (this != &other)
+            {
+                _Release();
+
+                hash  = other.hash;
+                equal = other.equal;
+
+                if constexpr (SlotTraits::propagate_on_container_copy_assignment::value)
+                    allocator = other.allocator;
+
+                _CopyFrom(other);
+            }
+
+            return *this;
+        }
+
+        FlatHashMap& operator=(FlatHashMap&& other) noexcept
+        {
+            if (this != &other)
+            {
+                _Release();
+
+                hash  = std::move(other.hash);
+                equal = std::move(other.equal);
+
+                if constexpr (SlotTraits::propagate_on_container_move_assignment::value)
+                {
+                    allocator = std::move(other.allocator);
+                    _StealFrom(other);
+                }
+                else if (allocator == other.allocator)
+                {
+                    _StealFrom(other);
+                }
+                else
+                {
+                    // 異なるリソースのアロケーター同士では、バッファを譲り受けられない
+                    reserve(other.size());
+                    for (value_type& value : other)
+                        _EmplaceUnique(std::move(const_cast<K&>(value.first)), std::move(value.second));
+
+                    other.clear();
+                }
+            }
+
+            return *this;
+        }
+
+    public:
+
+        //==============================================================
+        // 容量
+        //==============================================================
+        size_type size()     const { return elementCount; }
+        size_type capacity() const { return slotCount; }
+        bool      empty()    const { return elementCount == 0; }
+
+        allocator_type get_allocator() const { return allocator; }
+
+        // 再構築なしで count 個の要素を格納できる容量を確保する
+        void reserve(size_type reserveCount)
+        {
+            const size_type required = _CapacityFor(reserveCount);
+            if (required > slotCount)
+            {
+                _Rehash(required);
+            }
+        }
+
+        // 要素を破棄する（バッファは保持する）
+        void clear()
+        {
+            if (slotCount == 0)
+                return;
+
+            _DestroyAll();
+            std::memset(ctrl, ctrlEmpty, slotCount);
+
+            elementCount = 0;
+            growthLeft = _MaxLoad(slotCount);
+        }
+
+        void swap(FlatHashMap& other) noexcept
+        {
+            std::swap(hash,       other.hash);
+            std::swap(equal,      other.equal);
+            std::swap(ctrl,       other.ctrl);
+            std::swap(slots,      other.slots);
+            std::swap(slotCount,  other.slotCount);
+            std::swap(elementCount, other.elementCount);
+            std::swap(growthLeft, other.growthLeft);
+
+            if constexpr (SlotTraits::propagate_on_container_swap::value)
+                std::swap(allocator, other.allocator);
+        }
+
+        //==============================================================
+        // イテレーター
+        //==============================================================
+        iterator begin()
+        {
+            iterator it(ctrl, slots, ctrl + slotCount);
+            it._SkipEmpty();
+
+            return it;
+        }
+
+        const_iterator begin() const
+        {
+            const_iterator it(ctrl, slots, ctrl + slotCount);
+            it._SkipEmpty();
+
+            return it;
+        }
+
+        iterator       end()          { return _MakeIterator(slotCount); }
+        const_iterator end()    const { return _MakeIterator(slotCount); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend()   const { return end();   }
+
+        //==============================================================
+        // 検索
+        //==============================================================
+        iterator find(const K& key)
+        {
+            return _MakeIterator(_Find(key));
+        }
+
+        const_iterator find(const K& key) const
+        {
+            return _MakeIterator(_Find(key));
+        }
+
+        template<typename Key> requires (isTransparent)
+        iterator find(const Key& key)
+        {
+            return _MakeIterator(_Find(key));
+        }
+
+        template<typename Key> requires (isTransparent)
+        const_iterator find(const Key& key) const
+        {
+            return _MakeIterator(_Find(key));
+        }
+
+        bool contains(const K& key) const
+        {
+            return _Find(key) != npos;
+        }
+
+        template<typename Key> requires (isTransparent)
+        bool contains(const Key& key) const
+        {
+            return _Find(key) != npos;
+        }
+
+        size_type count(const K& key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        // 存在しないキーは呼び出し側の誤りとして扱い、リリースビルドでも停止する（例外は投げない）
+        V& at(const K& key)
+        {
+            return slots[_FindExisting(key)].second;
+        }
+
+        const V& at(const K& key) const
+        {
+            return slots[_FindExisting(key)].second;
+        }
+
+        template<typename Key> requires (isTransparent)
+        V& at(const Key& key)
+        {
+            return slots[_FindExisting(key)].second;
+        }
+
+        template<typename Key> requires (isTransparent)
+        const V& at(const Key& key) const
+        {
+            return slots[_FindExisting(key)].second;
+        }
+
+        //==============================================================
+        // 挿入
+        //==============================================================
+        V& operator[](const K& key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        V& operator[](K&& key)
+        {
+            return try_emplace(std::move(key)).first->second;
+        }
+
+        // キーが存在しなければ、値を args から構築して挿入する（存在すれば何もしない）
+        template<typename ... Args>
+        std::pair<iterator, bool> try_emplace(const K& key, Args&& ... args)
+        {
+            return _TryEmplace(key, std::forward<Args>(args)...);
+        }
+
+        template<typename ... Args>
+        std::pair<iterator, bool> try_emplace(K&& key, Args&& ... args)
+        {
+            return _TryEmplace(std::move(key), std::forward<Args>(args)...);
+        }
+
+        template<typename M>
+        std::pair<iterator, bool> insert_or_assign(const K& key, M&& value)
+        {
+            auto result = _TryEmplace(key, std::forward<M>(value));
+            if (!result.second)
+                result.first->second = std::forward<M>(value);
+
+            return result;
+        }
+
+        std::pair<iterator, bool> insert(const value_type& value)
+        {
+            return _TryEmplace(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& value)
+        {
+            return _TryEmplace(value.first, std::move(value.second));
+        }
+
+        // std::unordered_map::emplace と同様に、キーと値の構築引数を受け取る
+        template<typename KeyArg, typename ... Args>
+        std::pair<iterator, bool> emplace(KeyArg&& key, Args&& ... args)
+        {
+            if constexpr (std::is_same_v<std::remove_cvref_t<KeyArg>, K>)
+            {
+                return _TryEmplace(std::forward<KeyArg>(key), std::forward<Args>(args)...);
+            }
+            else
+            {
+                return _TryEmplace(K(std::forward<KeyArg>(key)), std::forward<Args>(args)...);
+            }
+        }
+
+        //==============================================================
+        // 削除
+        //==============================================================
+        size_type erase(const K& key)
+        {
+            const size_type index = _Find(key);
+            if (index == npos)
+                return 0;
+
+            _EraseAt(index);
+            return 1;
+        }
+
+        template<typename Key> requires (isTransparent && !std::is_convertible_v<const Key&, const_iterator>)
+        size_type erase(const Key& key)
+        {
+            const size_type index = _Find(key);
+            if (index == npos)
+                return 0;
+
+            _EraseAt(index);
+            return 1;
+        }
+
+        // 削除しても他の要素は移動しないので、次の要素を指すイテレーターを返せる
+        iterator erase(const_iterator it)
+        {
+            const size_type index = static_cast<size_type>(it.ctrl - ctrl);
+            _EraseAt(index);
+
+            iterator next = _MakeIterator(index);
+            ++next;
+
+            return next;
+        }
+
+        iterator erase(iterator it)
+        {
+            return erase(const_iterator(it));
+        }
+
+    private:
+
+        //==============================================================
+        // ハッシュ値の分割
+        // H1: グループ選択（上位 57bit） / H2: 制御バイト（下位 7bit）
+        //==============================================================
+        static constexpr uint64 _H1(uint64 hashValue) { return hashValue >> 7; }
+        static constexpr int8   _H2(uint64 hashValue) { return static_cast<int8>(hashValue & 0x7F); }
+
+        // 容量（2 の累乗、最低 1 グループ）と、その容量で挿入可能な最大要素数
+        static constexpr size_type _MaxLoad(size_type capacity)
+        {
+            return capacity - capacity / 8;
+        }
+
+        static constexpr size_type _CapacityFor(size_type elementCount)
+        {
+            if (elementCount == 0)
+                return 0;
+
+            size_type capacity = std::bit_ceil((elementCount * 8 + 6) / 7);
+            return capacity < groupWidth ? groupWidth : capacity;
+        }
+
+        iterator _MakeIterator(size_type index)
+        {
+            if (index == npos)
+                index = slotCount;
+
+            return iterator(ctrl + index, slots + index, ctrl + slotCount);
+        }
+
+        const_iterator _MakeIterator(size_type index) const
+        {
+            if (index == npos)
+                index = slotCount;
+
+            return const_iterator(ctrl + index, slots + index, ctrl + slotCount);
+        }
+
+        template<typename Key>
+        size_type _Find(const Key& key) const
+        {
+            return _Find(key, hash(key));
+        }
+
+        template<typename Key>
+        size_type _Find(const Key& key, uint64 hashValue) const
+        {
+            if (slotCount == 0) SL_UNLIKELY
+                return npos;
+
+            const int8      h2        = _H2(hashValue);
+            const size_type groupMask = slotCount / groupWidth - 1;
+
+            size_type group = _H1(hashValue) & groupMask;
+            for (size_type step = 1;; step++)
+            {
+                const size_type base = group * groupWidth;
+                const Group     g(ctrl + base);
+
+                for (uint32 mask = g.Match(h2); mask; mask &= mask - 1)
+                {
+                    const size_type index = base + std::countr_zero(mask);
+                    if (equal(slots[index].first, key)) SL_LIKELY
+                        return index;
+                }
+
+                // 空スロットがあるグループより先に、このキーが配置されることはない
+                if (g.MatchEmpty()) SL_LIKELY
+                    return npos;
+
+                group = (group + step) & groupMask;
+            }
+        }
+
+        // at() 用: 見つからなければ範囲外アクセスになる前に停止する
+        template<typename Key>
+        size_type _FindExisting(const Key& key) const
+        {
+            const size_type index = _Find(key);
+            if (index == npos) SL_UNLIKELY
+            {
+                SL_LOG_FATAL("FlatHashMap::at: キーが存在しません");
+                std::abort();
+            }
+
+            return index;
+        }
+
+        // 探索列上で最初の 空 / 削除済み スロットを返す
+        size_type _FindInsertSlot(uint64 hashValue) const
+        {
+            const size_type groupMask = slotCount / groupWidth - 1;
+
+            size_type group = _H1(hashValue) & groupMask;
+            for (size_type step = 1;; step++)
+            {
+                const size_type base = group * groupWidth;
+                const Group     g(ctrl + base);
+
+                if (const uint32 mask = g.MatchEmptyOrDeleted()) SL_LIKELY
+                    return base + std::countr_zero(mask);
+
+                group = (group + step) & groupMask;
+            }
+        }
+
+        // 挿入位置を確保して制御バイトを設定する（要素の構築は呼び出し側）
+        size_type _PrepareInsert(uint64 hashValue)
+        {
+            size_type index = slotCount != 0 ? _FindInsertSlot(hashValue) : npos;
+
+            // 削除済みスロットの再利用は負荷率を増やさないので、空きを消費する場合のみ拡張を判断する
+            if (index == npos || (growthLeft == 0 && ctrl[index] == ctrlEmpty)) SL_UNLIKELY
+            {
+                _Rehash(_NextCapacity());
+                index = _FindInsertSlot(hashValue);
+            }
+
+            if (ctrl[index] == ctrlEmpty)
+                growthLeft--;
+
+            ctrl[index] = _H2(hashValue);
+            elementCount++;
+
+            return index;
+        }
+
+        // 削除済みスロットが半分以上を占めるなら、同容量で再構築して掃除するだけで足りる
+        size_type _NextCapacity() const
+        {
+            if (slotCount == 0)
+                return groupWidth;
+
+            if (elementCount * 2 <= _MaxLoad(slotCount))
+                return slotCount;
+
+            return slotCount * 2;
+        }
+
+        template<typename Key, typename ... Args>
+        std::pair<iterator, bool> _TryEmplace(Key&& key, Args&& ... args)
+        {
+            // 探索と挿入位置の決定で同じハッシュ値を使う
+            const uint64    hashValue = hash(key);
+            const size_type found     = _Find(key, hashValue);
+            if (found != npos)
+                return { _MakeIterator(found), false };
+
+            const size_type index = _PrepareInsert(hashValue);
+            SlotTraits::construct(allocator, slots + index,
+                std::piecewise_construct,
+                std::forward_as_tuple(std::forward<Key>(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+
+            return { _MakeIterator(index), true };
+        }
+
+        // キーの重複がないことが分かっている場合の挿入（再構築 / ムーブ用）
+        template<typename Key, typename Value>
+        void _EmplaceUnique(Key&& key, Value&& value)
+        {
+            const size_type index = _PrepareInsert(hash(key));
+            SlotTraits::construct(allocator, slots + index, std::forward<Key>(key), std::forward<Value>(value));
+        }
+
+        void _EraseAt(size_type index)
+        {
+            SlotTraits::destroy(allocator, slots + index);
+            elementCount--;
+
+            // グループに空きが既にあれば、このグループを越えて探索が続くことはないので空に戻せる
+            // そうでなければ、後続の探索を途切れさせないように削除済みとして残す
+            const size_type base = index & ~static_cast<size_type>(groupWidth - 1);
+            if (Group(ctrl + base).MatchEmpty())
+            {
+                ctrl[index] = ctrlEmpty;
+                growthLeft++;
+            }
+            else
+            {
+                ctrl[index] = ctrlDeleted;
+            }
+        }
+
+        void _Rehash(size_type newCapacity)
+        {
+            int8*       oldCtrl     = ctrl;
+            value_type* oldSlots    = slots;
+            size_type   oldCapacity = slotCount;
+
+            _Allocate(newCapacity);
+
+            for (size_type i = 0; i < oldCapacity; i++)
+            {
+                if (oldCtrl[i] < 0)
+                    continue;
+
+                // キーは const だが、旧スロットは直後に破棄するのでムーブして構わない
+                value_type&     old       = oldSlots[i];
+                const uint64    hashValue = hash(old.first);
+                const size_type index     = _FindInsertSlot(hashValue);
+
+                ctrl[index] = _H2(hashValue);
+                SlotTraits::construct(allocator, slots + index, std::move(const_cast<K&>(old.first)), std::move(old.second));
+                SlotTraits::destroy(allocator, &old);
+            }
+
+            growthLeft -= elementCount;
+
+            _Deallocate(oldCtrl, oldSlots, oldCapacity);
+        }
+
+        void _Allocate(size_type capacity)
+        {
+            CtrlAllocator ctrlAllocator(allocator);
+
+            ctrl       = CtrlTraits::allocate(ctrlAllocator, capacity);
+            slots      = SlotTraits::allocate(allocator, capacity);
+            slotCount  = capacity;
+            growthLeft = _MaxLoad(capacity);
+
+            std::memset(ctrl, ctrlEmpty, capacity);
+        }
+
+        void _Deallocate(int8* oldCtrl, value_type* oldSlots, size_type capacity)
+        {
+            if (capacity == 0)
+                return;
+
+            CtrlAllocator ctrlAllocator(allocator);
+
+            CtrlTraits::deallocate(ctrlAllocator, oldCtrl, capacity);
+            SlotTraits::deallocate(allocator, oldSlots, capacity);
+        }
+
+        void _DestroyAll()
+        {
+            if constexpr (!std::is_trivially_destructible_v<value_type>)
+            {
+                for (size_type i = 0; i < slotCount; i++)
+                {
+                    if (ctrl[i] >= 0)
+                        SlotTraits::destroy(allocator, slots + i);
+                }
+            }
+        }
+
+        void _Release()
+        {
+            _DestroyAll();
+            _Deallocate(ctrl, slots, slotCount);
+
+            ctrl       = nullptr;
+            slots      = nullptr;
+            slotCount  = 0;
+            elementCount = 0;
+            growthLeft = 0;
+        }
+
+        void _CopyFrom(const FlatHashMap& other)
+        {
+            if (other.slotCount == 0)
+                return;
+
+            _Allocate(other.slotCount);
+            std::memcpy(ctrl, other.ctrl, slotCount);
+
+            for (size_type i = 0; i < slotCount; i++)
+            {
+                if (ctrl[i] >= 0)
+                    SlotTraits::construct(allocator, slots + i, other.slots[i]);
+            }
+
+            elementCount = other.elementCount;
+            growthLeft = other.growthLeft;
+        }
+
+        void _StealFrom(FlatHashMap& other)
+        {
+            ctrl       = std::exchange(other.ctrl,       nullptr);
+            slots      = std::exchange(other.slots,      nullptr);
+            slotCount  = std::exchange(other.slotCount,  0);
+            elementCount = std::exchange(other.elementCount, 0);
+            growthLeft = std::exchange(other.growthLeft, 0);
+        }
+
+    private:
+
+        int8*       ctrl       = nullptr;
+        value_type* slots      = nullptr;
+        size_type   slotCount    = 0;
+        size_type   elementCount = 0;
+        size_type   growthLeft = 0;
+
+        Hasher      hash;
+        KeyEqual    equal;
+        Allocator   allocator;
+    };
+}
@@ -0,0 +1,457 @@
+
+#include "PCH.h"
+#include "Core/Hash.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #define SL_XXH3_X64 1
+    #include <immintrin.h>
+    #if _MSC_VER
+        #include <intrin.h>
+    #endif
+#else
+    #define SL_XXH3_X64 0
+#endif
+
+// GCC / Clang は、AVX2 命令を使う関数ごとにターゲットを指定する必要がある（MSVC は不要）
+#if SL_XXH3_X64 && !_MSC_VER
+    #define SL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define SL_TARGET_AVX2
+#endif
+
+
+namespace Silex
+{
+    namespace Internal
+    {
+        using namespace Internal::XXHash;
+
+        //==============================================================
+        // XXH3 ストライプ処理
+        //--------------------------------------------------------------
+        // 240 バイトを超える入力の大部分はここで処理されるので、命令セットごとに実装を持ち
+        // 初回呼び出し時に CPU がサポートする最も広い命令セットを選択する
+        //==============================================================
+        using XXH3AccumulateFunction = void(*)(uint64* acc, const uint8* input, const uint8* secret, uint64 numStripes);
+        using XXH3ScrambleFunction   = void(*)(uint64* acc, const uint8* secret);
+
+        struct XXH3Kernel
+        {
+            XXH3AccumulateFunction accumulate;
+            XXH3ScrambleFunction   scramble;
+        };
+
+#if !SL_XXH3_X64
+        static void AccumulateScalar(uint64* acc, const uint8* input, const uint8* secret, uint64 numStripes)
+        {
+            for (uint64 n = 0; n < numStripes; n++)
+                XXH3Accumulate512(acc, input + n * stripeByteSize, secret + n * secretConsumeRate);
+        }
+
+        static void ScrambleScalar(uint64* acc, const uint8* secret)
+        {
+            XXH3ScrambleAcc(acc, secret);
+        }
+#else
+        static void AccumulateSSE2(uint64* acc, const uint8* input, const uint8* secret, uint64 numStripes)
+        {
+            __m128i* xacc = reinterpret_cast<__m128i*>(acc);
+
+            for (uint64 n = 0; n < numStripes; n++)
+            {
+                const uint8* in  = input  + n * stripeByteSize;
+                const uint8* key = secret + n * secretConsumeRate;
+
+                for (uint32 i = 0; i < 4; i++)
+                {
+                    const __m128i dataVec   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)  + i);
+                    const __m128i keyVec    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + i);
+                    const __m128i dataKey   = _mm_xor_si128(dataVec, keyVec);
+                    const __m128i dataKeyHi = _mm_srli_epi64(dataKey, 32);
+                    const __m128i product   = _mm_mul_epu32(dataKey, dataKeyHi);
+                    const __m128i dataSwap  = _mm_shuffle_epi32(dataVec, _MM_SHUFFLE(1, 0, 3, 2));
+
+                    xacc[i] = _mm_add_epi64(product, _mm_add_epi64(xacc[i], dataSwap));
+                }
+            }
+        }
+
+        static void ScrambleSSE2(uint64* acc, const uint8* secret)
+        {
+            __m128i* xacc = reinterpret_cast<__m128i*>(acc);
+            const __m128i prime = _mm_set1_epi32((int)prime32_1);
+
+            for (uint32 i = 0; i < 4; i++)
+            {
+                const __m128i accVec    = xacc[i];
+                const __m128i dataVec   = _mm_xor_si128(accVec, _mm_srli_epi64(accVec, 47));
+                const __m128i keyVec    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i);
+                const __m128i dataKey   = _mm_xor_si128(dataVec, keyVec);
+                const __m128i dataKeyHi = _mm_srli_epi64(dataKey, 32);
+                const __m128i productLo = _mm_mul_epu32(dataKey,   prime);
+                const __m128i productHi = _mm_mul_epu32(dataKeyHi, prime);
+
+                xacc[i] = _mm_add_epi64(productLo, _mm_slli_epi64(productHi, 32));
+            }
+        }
+
+        SL_TARGET_AVX2 static void AccumulateAVX2(uint64* acc, const uint8* input, const uint8* secret, uint64 numStripes)
+        {
+            __m256i* xacc = reinterpret_cast<__m256i*>(acc);
+
+            for (uint64 n = 0; n < numStripes; n++)
+            {
+                const uint8* in  = input  + n * stripeByteSize;
+                const uint8* key = secret + n * secretConsumeRate;
+
+                for (uint32 i = 0; i < 2; i++)
+                {
+                    const __m256i dataVec   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)  + i);
+                    const __m256i keyVec    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key) + i);
+                    const __m256i dataKey   = _mm256_xor_si256(dataVec, keyVec);
+                    const __m256i dataKeyHi = _mm256_srli_epi64(dataKey, 32);
+                    const __m256i product   = _mm256_mul_epu32(dataKey, dataKeyHi);
+                    const __m256i dataSwap  = _mm256_shuffle_epi32(dataVec, _MM_SHUFFLE(1, 0, 3, 2));
+
+                    xacc[i] = _mm256_add_epi64(product, _mm256_add_epi64(xacc[i], dataSwap));
+                }
+            }
+        }
+
+        SL_TARGET_AVX2 static void ScrambleAVX2(uint64* acc, const uint8* secret)
+        {
+            __m256i* xacc = reinterpret_cast<__m256i*>(acc);
+            const __m256i prime = _mm256_set1_epi32((int)prime32_1);
+
+            for (uint32 i = 0; i < 2; i++)
+            {
+                const __m256i accVec    = xacc[i];
+                const __m256i dataVec   = _mm256_xor_si256(accVec, _mm256_srli_epi64(accVec, 47));
+                const __m256i keyVec    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i);
+                const __m256i dataKey   = _mm256_xor_si256(dataVec, keyVec);
+                const __m256i dataKeyHi = _mm256_srli_epi64(dataKey, 32);
+                const __m256i productLo = _mm256_mul_epu32(dataKey,   prime);
+                const __m256i productHi = _mm256_mul_epu32(dataKeyHi, prime);
+
+                xacc[i] = _mm256_add_epi64(productLo, _mm256_slli_epi64(productHi, 32));
+            }
+        }
+
+        static bool IsAVX2Supported()
+        {
+#if _MSC_VER
+            int info[4] = {};
+
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                return false;
+
+            // OS が YMM レジスタを保存するか（OSXSAVE + XCR0）
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx     = (info[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+                return false;
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+
+        static const XXH3Kernel& GetXXH3Kernel()
+        {
+            static const XXH3Kernel kernel = []
+            {
+#if SL_XXH3_X64
+                if (IsAVX2Supported())
+                    return XXH3Kernel{ AccumulateAVX2, ScrambleAVX2 };
+
+                return XXH3Kernel{ AccumulateSSE2, ScrambleSSE2 };
+#else
+                return XXH3Kernel{ AccumulateScalar, ScrambleScalar };
+#endif
+            }();
+
+            return kernel;
+        }
+
+        // ブロック境界をまたぐストライプ列を処理する（ブロック終端でスクランブル）
+        static void ConsumeStripes(const XXH3Kernel& kernel, uint64* acc, uint64& numStripesSoFar, const uint8* input, uint64 numStripes, const uint8* secret)
+        {
+            const uint8* initialSecret = secret + numStripesSoFar * secretConsumeRate;
+
+            if (numStripes >= stripesPerBlock - numStripesSoFar)
+            {
+                uint64 stripesThisBlock = stripesPerBlock - numStripesSoFar;
+
+                do
+                {
+                    kernel.accumulate(acc, input, initialSecret, stripesThisBlock);
+                    kernel.scramble(acc, secret + secretByteSize - stripeByteSize);
+
+                    input      += stripesThisBlock * stripeByteSize;
+                    numStripes -= stripesThisBlock;
+
+                    stripesThisBlock = stripesPerBlock;
+                    initialSecret    = secret;
+
+                } while (numStripes >= stripesPerBlock);
+
+                numStripesSoFar = 0;
+            }
+
+            if (numStripes > 0)
+            {
+                kernel.accumulate(acc, input, initialSecret, numStripes);
+                numStripesSoFar += numStripes;
+            }
+        }
+
+        static uint64 XXH3Long(const uint8* input, uint64 length, const uint8* secret)
+        {
+            const XXH3Kernel& kernel = GetXXH3Kernel();
+
+            alignas(64) uint64 acc[8];
+            XXH3InitAcc(acc);
+
+            const uint64 numBlocks = (length - 1) / blockByteSize;
+            for (uint64 n = 0; n < numBlocks; n++)
+            {
+                kernel.accumulate(acc, input + n * blockByteSize, secret, stripesPerBlock);
+                kernel.scramble(acc, secret + secretByteSize - stripeByteSize);
+            }
+
+            const uint64 numStripes = ((length - 1) - blockByteSize * numBlocks) / stripeByteSize;
+            kernel.accumulate(acc, input + numBlocks * blockByteSize, secret, numStripes);
+
+            // 最後のストライプ（末尾 64 バイト）
+            kernel.accumulate(acc, input + length - stripeByteSize, secret + secretByteSize - stripeByteSize - secretLastAccStart, 1);
+
+            return XXH3MergeAccs(acc, secret + secretMergeAccStart, length * prime64_1);
+        }
+    }
+
+
+    //==================================================================
+    // 一括計算
+    //==================================================================
+    uint64 Hash::XXH64(const void* data, uint64 size, uint64 seed)
+    {
+        return Internal::XXHash::XXH64(static_cast<const uint8*>(data), size, seed);
+    }
+
+    uint64 Hash::XXH3(const void* data, uint64 size, uint64 seed)
+    {
+        using namespace Internal::XXHash;
+
+        const uint8* input = static_cast<const uint8*>(data);
+
+        if (size <= midSizeMax) SL_LIKELY
+            return XXH3Short(input, size, defaultSecret, seed);
+
+        if (seed == 0)
+            return Internal::XXH3Long(input, size, defaultSecret);
+
+        alignas(64) uint8 secret[secretByteSize];
+        XXH3InitCustomSecret(secret, seed);
+
+        return Internal::XXH3Long(input, size, secret);
+    }
+
+
+    //==================================================================
+    // XXH64Stream
+    //==================================================================
+    void XXH64Stream::Reset(uint64 newSeed)
+    {
+        using namespace Internal::XXHash;
+
+        seed        = newSeed;
+        acc[0]      = seed + prime64_1 + prime64_2;
+        acc[1]      = seed + prime64_2;
+        acc[2]      = seed;
+        acc[3]      = seed - prime64_1;
+        bufferSize  = 0;
+        totalLength = 0;
+    }
+
+    void XXH64Stream::Update(const void* data, uint64 size)
+    {
+        using namespace Internal::XXHash;
+
+        const uint8* input = static_cast<const uint8*>(data);
+        const uint8* end   = input + size;
+
+        totalLength += size;
+
+        // 32 バイトに満たなければ、バッファに溜めるだけ
+        if (bufferSize + size < 32)
+        {
+            std::memcpy(buffer + bufferSize, input, size);
+            bufferSize += (uint32)size;
+            return;
+        }
+
+        if (bufferSize > 0)
+        {
+            const uint64 fill = 32 - bufferSize;
+            std::memcpy(buffer + bufferSize, input, fill);
+            input += fill;
+
+            acc[0] = XXH64Round(acc[0], Read64(buffer + 0));
+            acc[1] = XXH64Round(acc[1], Read64(buffer + 8));
+            acc[2] = XXH64Round(acc[2], Read64(buffer + 16));
+            acc[3] = XXH64Round(acc[3], Read64(buffer + 24));
+
+            bufferSize = 0;
+        }
+
+        while (input + 32 <= end)
+        {
+            acc[0] = XXH64Round(acc[0], Read64(input + 0));
+            acc[1] = XXH64Round(acc[1], Read64(input + 8));
+            acc[2] = XXH64Round(acc[2], Read64(input + 16));
+            acc[3] = XXH64Round(acc[3], Read64(input + 24));
+
+            input += 32;
+        }
+
+        if (input < end)
+        {
+            bufferSize = (uint32)(end - input);
+            std::memcpy(buffer, input, bufferSize);
+        }
+    }
+
+    uint64 XXH64Stream::Digest() const
+    {
+        using namespace Internal::XXHash;
+
+        uint64 hash = 0;
+
+        if (totalLength >= 32)
+        {
+            hash = Rotl64(acc[0], 1) + Rotl64(acc[1], 7) + Rotl64(acc[2], 12) + Rotl64(acc[3], 18);
+            hash = XXH64MergeRound(hash, acc[0]);
+            hash = XXH64MergeRound(hash, acc[1]);
+            hash = XXH64MergeRound(hash, acc[2]);
+            hash = XXH64MergeRound(hash, acc[3]);
+        }
+        else
+        {
+            hash = seed + prime64_5;
+        }
+
+        hash += totalLength;
+        return XXH64Finalize(hash, buffer, bufferSize);
+    }
+
+
+    //==================================================================
+    // XXH3Stream
+    //------------------------------------------------------------------
+    // 最後のストライプは一括計算と同様に末尾 64 バイトで処理する必要があるので
+    // 入力の末尾（最低 1 バイト）は常にバッファに残しておき、Digest で処理する
+    //==================================================================
+    void XXH3Stream::Reset(uint64 newSeed)
+    {
+        using namespace Internal::XXHash;
+
+        XXH3InitAcc(acc);
+
+        if (newSeed == 0)
+            std::memcpy(secret, defaultSecret, secretByteSize);
+        else
+            XXH3InitCustomSecret(secret, newSeed);
+
+        seed        = newSeed;
+        bufferSize  = 0;
+        numStripes  = 0;
+        totalLength = 0;
+    }
+
+    void XXH3Stream::Update(const void* data, uint64 size)
+    {
+        using namespace Internal::XXHash;
+
+        const uint8* input = static_cast<const uint8*>(data);
+        const uint8* end   = input + size;
+
+        totalLength += size;
+
+        if (size <= bufferByteSize - bufferSize)
+        {
+            std::memcpy(buffer + bufferSize, input, size);
+            bufferSize += size;
+            return;
+        }
+
+        const Internal::XXH3Kernel& kernel = Internal::GetXXH3Kernel();
+        constexpr uint64 bufferStripes = bufferByteSize / stripeByteSize;
+
+        // バッファを満たしてから処理する（この後に最低 1 バイトは残る）
+        if (bufferSize > 0)
+        {
+            const uint64 fill = bufferByteSize - bufferSize;
+            std::memcpy(buffer + bufferSize, input, fill);
+            input += fill;
+
+            Internal::ConsumeStripes(kernel, acc, numStripes, buffer, bufferStripes, secret);
+            bufferSize = 0;
+        }
+
+        // バッファを経由せずに直接処理し、最後のストライプだけをバッファ末尾に保存しておく
+        if ((uint64)(end - input) > bufferByteSize)
+        {
+            const uint64 stripes = (uint64)(end - 1 - input) / stripeByteSize;
+            Internal::ConsumeStripes(kernel, acc, numStripes, input, stripes, secret);
+
+            input += stripes * stripeByteSize;
+            std::memcpy(buffer + bufferByteSize - stripeByteSize, input - stripeByteSize, stripeByteSize);
+        }
+
+        bufferSize = (uint64)(end - input);
+        std::memcpy(buffer, input, bufferSize);
+    }
+
+    uint64 XXH3Stream::Digest() const
+    {
+        using namespace Internal::XXHash;
+
+        // 240 バイト以下なら、入力は全てバッファにある
+        if (totalLength <= midSizeMax)
+            return XXH3Short(buffer, totalLength, defaultSecret, seed);
+
+        const Internal::XXH3Kernel& kernel = Internal::GetXXH3Kernel();
+
+        // 状態を変更しないように、コピー上で残りを処理する
+        alignas(64) uint64 digestAcc[8];
+        std::memcpy(digestAcc, acc, sizeof(acc));
+
+        alignas(64) uint8 lastStripe[stripeByteSize];
+        const uint8* lastStripePtr = nullptr;
+
+        if (bufferSize >= stripeByteSize)
+        {
+            uint64 stripesSoFar = numStripes;
+            Internal::ConsumeStripes(kernel, digestAcc, stripesSoFar, buffer, (bufferSize - 1) / stripeByteSize, secret);
+
+            lastStripePtr = buffer + bufferSize - stripeByteSize;
+        }
+        else
+        {
+            // 直前に処理したストライプの末尾と、バッファの内容を繋げて 64 バイトにする
+            const uint64 catchup = stripeByteSize - bufferSize;
+            std::memcpy(lastStripe, buffer + bufferByteSize - catchup, catchup);
+            std::memcpy(lastStripe + catchup, buffer, bufferSize);
+
+            lastStripePtr = lastStripe;
+        }
+
+        kernel.accumulate(digestAcc, lastStripePtr, secret + secretByteSize - stripeByteSize - secretLastAccStart, 1);
+        return XXH3MergeAccs(digestAcc, secret + secretMergeAccStart, totalLength * prime64_1);
+    }
+}
@@ -1,6 +1,9 @@
 
 #pragma once
 #include "Core/CoreType.h"
+#include <cstring>
+#include <string_view>
+#include <type_traits>
 
 
 namespace Silex
@@ -24,143 +27,537 @@ namespace Silex
         static constexpr uint64 prime  = 1099511628211ull;
     };
 
-    struct Hash
+    //==================================================================
+    // xxHash 内部実装
+    //------------------------------------------------------------------
+    // コンパイル時評価に対応するため、読み込みはバイト単位のテンプレートで記述する
+    // （実行時は memcpy で読み込み、リトルエンディアンを前提とする）
+    //==================================================================
+    namespace Internal::XXHash
     {
-        // 長さが不確定な文字配列のハッシュ
-        template<typename T = uint64>
-        static T FNV(const char* str)
+        constexpr uint64 prime32_1 = 0x9E3779B1U;
+        constexpr uint64 prime32_2 = 0x85EBCA77U;
+        constexpr uint64 prime32_3 = 0xC2B2AE3DU;
+        constexpr uint64 prime64_1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64 prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr uint64 prime64_3 = 0x165667B19E3779F9ULL;
+        constexpr uint64 prime64_4 = 0x85EBCA77C2B2AE63ULL;
+        constexpr uint64 prime64_5 = 0x27D4EB2F165667C5ULL;
+        constexpr uint64 primeMx1  = 0x165667919E3779F9ULL;
+        constexpr uint64 primeMx2  = 0x9FB21C651E98DF25ULL;
+
+        constexpr uint64 stripeByteSize      = 64;
+        constexpr uint64 secretByteSize      = 192;
+        constexpr uint64 secretConsumeRate   = 8;
+        constexpr uint64 secretLastAccStart  = 7;
+        constexpr uint64 secretMergeAccStart = 11;
+        constexpr uint64 secretSizeMin       = 136;
+        constexpr uint64 midSizeMax          = 240;
+        constexpr uint64 stripesPerBlock     = (secretByteSize - stripeByteSize) / secretConsumeRate;
+        constexpr uint64 blockByteSize       = stripeByteSize * stripesPerBlock;
+
+        // 既定のシークレット（参照実装の kSecret）
+        alignas(64) constexpr uint8 defaultSecret[secretByteSize] =
         {
-            uint64 length = std::strlen(str);
-            T value = fnv1a_constant<T>::offset;
+            0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+            0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+            0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+            0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+            0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+            0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+            0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+            0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+            0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+            0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+            0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+            0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+        };
 
-            for (uint64 i = 0; i < length; ++i)
+        template<typename Byte>
+        constexpr uint32 Read32(const Byte* p)
+        {
+            if (!std::is_constant_evaluated())
             {
-                value ^= *str++;
-                value *= fnv1a_constant<T>::prime;
+                uint32 value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
             }
 
-            return value;
+            return (uint32)(uint8)p[0] | (uint32)(uint8)p[1] << 8 | (uint32)(uint8)p[2] << 16 | (uint32)(uint8)p[3] << 24;
         }
 
-        // コンパイル時定数な文字列リテラルのハッシュ
-        template<typename T = uint64>
-        static consteval T StaticFNV(const char* str)
+        template<typename Byte>
+        constexpr uint64 Read64(const Byte* p)
         {
-            T value = fnv1a_constant<T>::offset;
-            while (*str != 0)
+            if (!std::is_constant_evaluated())
             {
-                value ^= *str++;
-                value *= fnv1a_constant<T>::prime;
+                uint64 value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
             }
 
-            return value;
+            return (uint64)Read32(p) | (uint64)Read32(p + 4) << 32;
         }
 
-        //==========================================================
-        // xxHash
-        // https://github.com/stbrumme/xxhash/blob/master/xxhash64.h
-        //==========================================================
+        constexpr uint64 Rotl64(uint64 value, uint32 shift)
+        {
+            return (value << shift) | (value >> (64 - shift));
+        }
 
-#define XXHASH64 0
-#if XXHASH64
-        static consteval uint64 xxhash64(const char* str)
+        constexpr uint32 Swap32(uint32 value)
         {
-            uint64 length = 0;
-            while (str[length] != '\0')
+            return ((value << 24) & 0xff000000) | ((value << 8) & 0x00ff0000) | ((value >> 8) & 0x0000ff00) | ((value >> 24) & 0x000000ff);
+        }
+
+        constexpr uint64 Swap64(uint64 value)
+        {
+            return (uint64)Swap32((uint32)value) << 32 | Swap32((uint32)(value >> 32));
+        }
+
+        // 64bit × 64bit の 128bit 積を、上位と下位の XOR に畳み込む
+        constexpr uint64 Mul128Fold64(uint64 lhs, uint64 rhs)
+        {
+            const uint64 lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+            const uint64 hi_lo = (lhs >> 32)        * (rhs & 0xFFFFFFFF);
+            const uint64 lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+            const uint64 hi_hi = (lhs >> 32)        * (rhs >> 32);
+
+            const uint64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+            const uint64 upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+            const uint64 lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+
+            return lower ^ upper;
+        }
+
+        constexpr uint64 XXH64Avalanche(uint64 hash)
+        {
+            hash ^= hash >> 33;
+            hash *= prime64_2;
+            hash ^= hash >> 29;
+            hash *= prime64_3;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+        constexpr uint64 XXH3Avalanche(uint64 hash)
+        {
+            hash ^= hash >> 37;
+            hash *= primeMx1;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+        constexpr uint64 RRMXMX(uint64 hash, uint64 length)
+        {
+            hash ^= Rotl64(hash, 49) ^ Rotl64(hash, 24);
+            hash *= primeMx2;
+            hash ^= (hash >> 35) + length;
+            hash *= primeMx2;
+            return hash ^ (hash >> 28);
+        }
+
+        //==============================================================
+        // XXH64
+        //==============================================================
+        constexpr uint64 XXH64Round(uint64 acc, uint64 input)
+        {
+            acc += input * prime64_2;
+            acc  = Rotl64(acc, 31);
+            acc *= prime64_1;
+            return acc;
+        }
+
+        constexpr uint64 XXH64MergeRound(uint64 acc, uint64 value)
+        {
+            acc ^= XXH64Round(0, value);
+            acc  = acc * prime64_1 + prime64_4;
+            return acc;
+        }
+
+        template<typename Byte>
+        constexpr uint64 XXH64Finalize(uint64 hash, const Byte* p, uint64 length)
+        {
+            length &= 31;
+
+            while (length >= 8)
+            {
+                hash ^= XXH64Round(0, Read64(p));
+                hash  = Rotl64(hash, 27) * prime64_1 + prime64_4;
+                p      += 8;
+                length -= 8;
+            }
+
+            if (length >= 4)
             {
-                length++;
+                hash ^= (uint64)Read32(p) * prime64_1;
+                hash  = Rotl64(hash, 23) * prime64_2 + prime64_3;
+                p      += 4;
+                length -= 4;
             }
 
-            const uint64 prime1 = 0x9E3779B185EBCA87ULL;
-            const uint64 prime2 = 0xC2B2AE3D27D4EB4FULL;
-            const uint64 prime3 = 0x165667B19E3779F9ULL;
-            const uint64 prime4 = 0x85EBCA77C2B2AE63ULL;
-            const uint64 prime5 = 0x27D4EB2F165667C5ULL;
+            while (length > 0)
+            {
+                hash ^= (uint8)(*p++) * prime64_5;
+                hash  = Rotl64(hash, 11) * prime64_1;
+                length--;
+            }
+
+            return XXH64Avalanche(hash);
+        }
 
-            uint64 h64 = prime5;
-            const uint8* p = reinterpret_cast<const uint8*>(str);
-            const uint8* const bEnd = p + length;
+        template<typename Byte>
+        constexpr uint64 XXH64(const Byte* p, uint64 length, uint64 seed)
+        {
+            uint64 hash = 0;
 
-#if 0
-            XXH64_finalize(xxh_u64 hash, const xxh_u8 * ptr, size_t len, XXH_alignment align)
+            if (length >= 32)
             {
-                if (ptr == NULL) XXH_ASSERT(len == 0);
-                len &= 31;
-                while (len >= 8) {
-                    xxh_u64 const k1 = XXH64_round(0, XXH_get64bits(ptr));
-                    ptr += 8;
-                    hash ^= k1;
-                    hash = XXH_rotl64(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
-                    len -= 8;
-                }
-                if (len >= 4) {
-                    hash ^= (xxh_u64)(XXH_get32bits(ptr)) * XXH_PRIME64_1;
-                    ptr += 4;
-                    hash = XXH_rotl64(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
-                    len -= 4;
-                }
-                while (len > 0) {
-                    hash ^= (*ptr++) * XXH_PRIME64_5;
-                    hash = XXH_rotl64(hash, 11) * XXH_PRIME64_1;
-                    --len;
+                const Byte* const limit = p + length - 32;
+
+                uint64 v1 = seed + prime64_1 + prime64_2;
+                uint64 v2 = seed + prime64_2;
+                uint64 v3 = seed;
+                uint64 v4 = seed - prime64_1;
+
+                do
+                {
+                    v1 = XXH64Round(v1, Read64(p));      p += 8;
+                    v2 = XXH64Round(v2, Read64(p));      p += 8;
+                    v3 = XXH64Round(v3, Read64(p));      p += 8;
+                    v4 = XXH64Round(v4, Read64(p));      p += 8;
+
+                } while (p <= limit);
+
+                hash = Rotl64(v1, 1) + Rotl64(v2, 7) + Rotl64(v3, 12) + Rotl64(v4, 18);
+                hash = XXH64MergeRound(hash, v1);
+                hash = XXH64MergeRound(hash, v2);
+                hash = XXH64MergeRound(hash, v3);
+                hash = XXH64MergeRound(hash, v4);
+            }
+            else
+            {
+                hash = seed + prime64_5;
+            }
+
+            hash += length;
+            return XXH64Finalize(hash, p, length);
+        }
+
+        //==============================================================
+        // XXH3 (240 バイト以下)
+        //==============================================================
+        template<typename Byte>
+        constexpr uint64 XXH3Mix16B(const Byte* p, const uint8* secret, uint64 seed)
+        {
+            const uint64 lo = Read64(p);
+            const uint64 hi = Read64(p + 8);
+            return Mul128Fold64(lo ^ (Read64(secret) + seed), hi ^ (Read64(secret + 8) - seed));
+        }
+
+        template<typename Byte>
+        constexpr uint64 XXH3Length0To16(const Byte* p, uint64 length, const uint8* secret, uint64 seed)
+        {
+            if (length > 8)
+            {
+                const uint64 bitflip1 = (Read64(secret + 24) ^ Read64(secret + 32)) + seed;
+                const uint64 bitflip2 = (Read64(secret + 40) ^ Read64(secret + 48)) - seed;
+                const uint64 inputLo  = Read64(p) ^ bitflip1;
+                const uint64 inputHi  = Read64(p + length - 8) ^ bitflip2;
+                const uint64 acc      = length + Swap64(inputLo) + inputHi + Mul128Fold64(inputLo, inputHi);
+                return XXH3Avalanche(acc);
+            }
+
+            if (length >= 4)
+            {
+                seed ^= (uint64)Swap32((uint32)seed) << 32;
+
+                const uint32 input1  = Read32(p);
+                const uint32 input2  = Read32(p + length - 4);
+                const uint64 bitflip = (Read64(secret + 8) ^ Read64(secret + 16)) - seed;
+                const uint64 input64 = input2 + ((uint64)input1 << 32);
+                return RRMXMX(input64 ^ bitflip, length);
+            }
+
+            if (length > 0)
+            {
+                const uint32 c1       = (uint8)p[0];
+                const uint32 c2       = (uint8)p[length >> 1];
+                const uint32 c3       = (uint8)p[length - 1];
+                const uint32 combined = (c1 << 16) | (c2 << 24) | c3 | ((uint32)length << 8);
+                const uint64 bitflip  = (Read32(secret) ^ Read32(secret + 4)) + seed;
+                return XXH64Avalanche((uint64)combined ^ bitflip);
+            }
+
+            return XXH64Avalanche(seed ^ (Read64(secret + 56) ^ Read64(secret + 64)));
+        }
+
+        template<typename Byte>
+        constexpr uint64 XXH3Length17To128(const Byte* p, uint64 length, const uint8* secret, uint64 seed)
+        {
+            uint64 acc = length * prime64_1;
+
+            if (length > 32)
+            {
+                if (length > 64)
+                {
+                    if (length > 96)
+                    {
+                        acc += XXH3Mix16B(p + 48,          secret + 96,  seed);
+                        acc += XXH3Mix16B(p + length - 64, secret + 112, seed);
+                    }
+
+                    acc += XXH3Mix16B(p + 32,          secret + 64, seed);
+                    acc += XXH3Mix16B(p + length - 48, secret + 80, seed);
                 }
-                return  XXH64_avalanche(hash);
+
+                acc += XXH3Mix16B(p + 16,          secret + 32, seed);
+                acc += XXH3Mix16B(p + length - 32, secret + 48, seed);
             }
-#endif
-            while (p + 8 <= bEnd)
+
+            acc += XXH3Mix16B(p,               secret,      seed);
+            acc += XXH3Mix16B(p + length - 16, secret + 16, seed);
+
+            return XXH3Avalanche(acc);
+        }
+
+        template<typename Byte>
+        constexpr uint64 XXH3Length129To240(const Byte* p, uint64 length, const uint8* secret, uint64 seed)
+        {
+            constexpr uint64 startOffset = 3;
+            constexpr uint64 lastOffset  = 17;
+
+            const uint64 numRounds = length / 16;
+
+            uint64 acc = length * prime64_1;
+            for (uint64 i = 0; i < 8; i++)
+                acc += XXH3Mix16B(p + 16 * i, secret + 16 * i, seed);
+
+            uint64 accEnd = XXH3Mix16B(p + length - 16, secret + secretSizeMin - lastOffset, seed);
+            acc = XXH3Avalanche(acc);
+
+            for (uint64 i = 8; i < numRounds; i++)
+                accEnd += XXH3Mix16B(p + 16 * i, secret + 16 * (i - 8) + startOffset, seed);
+
+            return XXH3Avalanche(acc + accEnd);
+        }
+
+        template<typename Byte>
+        constexpr uint64 XXH3Short(const Byte* p, uint64 length, const uint8* secret, uint64 seed)
+        {
+            if (length <= 16)  return XXH3Length0To16(p, length, secret, seed);
+            if (length <= 128) return XXH3Length17To128(p, length, secret, seed);
+
+            return XXH3Length129To240(p, length, secret, seed);
+        }
+
+        //==============================================================
+        // XXH3 (240 バイト超: スカラー版)
+        //--------------------------------------------------------------
+        // 実行時は Hash.cpp の SIMD 版が使われ、こちらはコンパイル時評価でのみ使われる
+        //==============================================================
+        template<typename Byte>
+        constexpr void XXH3Accumulate512(uint64* acc, const Byte* p, const uint8* secret)
+        {
+            for (uint64 i = 0; i < 8; i++)
+            {
+                const uint64 dataValue = Read64(p + 8 * i);
+                const uint64 dataKey   = dataValue ^ Read64(secret + 8 * i);
+
+                acc[i ^ 1] += dataValue;
+                acc[i]     += (dataKey & 0xFFFFFFFF) * (dataKey >> 32);
+            }
+        }
+
+        constexpr void XXH3ScrambleAcc(uint64* acc, const uint8* secret)
+        {
+            for (uint64 i = 0; i < 8; i++)
+            {
+                uint64 value = acc[i];
+                value ^= value >> 47;
+                value ^= Read64(secret + 8 * i);
+                value *= prime32_1;
+                acc[i] = value;
+            }
+        }
+
+        constexpr uint64 XXH3MergeAccs(const uint64* acc, const uint8* secret, uint64 start)
+        {
+            uint64 result = start;
+            for (uint64 i = 0; i < 4; i++)
+                result += Mul128Fold64(acc[2 * i] ^ Read64(secret + 16 * i), acc[2 * i + 1] ^ Read64(secret + 16 * i + 8));
+
+            return XXH3Avalanche(result);
+        }
+
+        constexpr void XXH3InitAcc(uint64* acc)
+        {
+            acc[0] = prime32_3; acc[1] = prime64_1; acc[2] = prime64_2; acc[3] = prime64_3;
+            acc[4] = prime64_4; acc[5] = prime32_2; acc[6] = prime64_5; acc[7] = prime32_1;
+        }
+
+        // シード値から派生シークレットを生成する（シード 0 は既定のシークレットと同じ）
+        constexpr void XXH3InitCustomSecret(uint8* secret, uint64 seed)
+        {
+            for (uint64 i = 0; i < secretByteSize / 16; i++)
             {
-                uint64 k1 = *reinterpret_cast<const uint64*>(p);
-                k1 *= prime2;
-                k1 = (k1 << 31) | (k1 >> (64 - 31));
-                k1 *= prime1;
-                h64 ^= k1;
-                h64 = (h64 << 27) | (h64 >> (64 - 27));
-                h64 = h64 * prime1 + prime4;
-                p += 8;
+                const uint64 lo = Read64(defaultSecret + 16 * i)     + seed;
+                const uint64 hi = Read64(defaultSecret + 16 * i + 8) - seed;
+
+                for (uint64 b = 0; b < 8; b++)
+                {
+                    secret[16 * i + b]     = (uint8)(lo >> (8 * b));
+                    secret[16 * i + 8 + b] = (uint8)(hi >> (8 * b));
+                }
             }
+        }
+
+        template<typename Byte>
+        constexpr uint64 XXH3LongScalar(const Byte* p, uint64 length, const uint8* secret)
+        {
+            uint64 acc[8] = {};
+            XXH3InitAcc(acc);
 
-            if (p + 4 <= bEnd)
+            const uint64 numBlocks = (length - 1) / blockByteSize;
+            for (uint64 n = 0; n < numBlocks; n++)
             {
-                uint64 k1 = *reinterpret_cast<const uint32*>(p);
-                k1 *= prime1;
-                k1 = (k1 << 23) | (k1 >> (64 - 23));
-                k1 *= prime2;
-                h64 ^= k1;
-                h64 = h64 * prime1 + prime3;
-                p += 4;
+                for (uint64 s = 0; s < stripesPerBlock; s++)
+                    XXH3Accumulate512(acc, p + n * blockByteSize + s * stripeByteSize, secret + s * secretConsumeRate);
+
+                XXH3ScrambleAcc(acc, secret + secretByteSize - stripeByteSize);
             }
 
-            while (p < bEnd)
+            const uint64 numStripes = ((length - 1) - blockByteSize * numBlocks) / stripeByteSize;
+            for (uint64 s = 0; s < numStripes; s++)
+                XXH3Accumulate512(acc, p + numBlocks * blockByteSize + s * stripeByteSize, secret + s * secretConsumeRate);
+
+            XXH3Accumulate512(acc, p + length - stripeByteSize, secret + secretByteSize - stripeByteSize - secretLastAccStart);
+
+            return XXH3MergeAccs(acc, secret + secretMergeAccStart, length * prime64_1);
+        }
+
+        template<typename Byte>
+        constexpr uint64 XXH3(const Byte* p, uint64 length, uint64 seed)
+        {
+            if (length <= midSizeMax)
+                return XXH3Short(p, length, defaultSecret, seed);
+
+            if (seed == 0)
+                return XXH3LongScalar(p, length, defaultSecret);
+
+            uint8 secret[secretByteSize] = {};
+            XXH3InitCustomSecret(secret, seed);
+            return XXH3LongScalar(p, length, secret);
+        }
+    }
+
+
+    //==================================================================
+    // ストリーミングハッシュ
+    //------------------------------------------------------------------
+    // 大きなファイルなどを分割して入力する（結果は一括計算と同じ値になる）
+    // Digest 後も Update を続けられる
+    //==================================================================
+    class XXH64Stream
+    {
+    public:
+
+        XXH64Stream(uint64 seed = 0) { Reset(seed); }
+
+        void   Reset(uint64 seed = 0);
+        void   Update(const void* data, uint64 size);
+        uint64 Digest() const;
+
+    private:
+
+        uint64 acc[4]      = {};
+        uint8  buffer[32]  = {};
+        uint32 bufferSize  = 0;
+        uint64 totalLength = 0;
+        uint64 seed        = 0;
+    };
+
+    class XXH3Stream
+    {
+    public:
+
+        XXH3Stream(uint64 seed = 0) { Reset(seed); }
+
+        void   Reset(uint64 seed = 0);
+        void   Update(const void* data, uint64 size);
+        uint64 Digest() const;
+
+    private:
+
+        static constexpr uint64 bufferByteSize = 256;
+
+        alignas(64) uint64 acc[8]                                   = {};
+        alignas(64) uint8  secret[Internal::XXHash::secretByteSize] = {};
+        alignas(64) uint8  buffer[bufferByteSize]                   = {};
+
+        uint64 bufferSize  = 0;
+        uint64 numStripes  = 0; // 現在のブロック内で処理済みのストライプ数
+        uint64 totalLength = 0;
+        uint64 seed        = 0;
+    };
+
+
+    struct Hash
+    {
+        // 長さが不確定な文字配列のハッシュ
+        template<typename T = uint64>
+        static T FNV(const char* str)
+        {
+            uint64 length = std::strlen(str);
+            T value = fnv1a_constant<T>::offset;
+
+            for (uint64 i = 0; i < length; ++i)
             {
-                h64 ^= (*p) * prime5;
-                h64 = (h64 << 11) | (h64 >> (64 - 11));
-                h64 *= prime1;
-                ++p;
+                value ^= *str++;
+                value *= fnv1a_constant<T>::prime;
             }
 
+            return value;
+        }
 
-#if 0
-            static xxh_u64 XXH64_avalanche(xxh_u64 hash)
+        // コンパイル時定数な文字列リテラルのハッシュ
+        template<typename T = uint64>
+        static consteval T StaticFNV(const char* str)
+        {
+            T value = fnv1a_constant<T>::offset;
+            while (*str != 0)
             {
-                hash ^= hash >> 33;
-                hash *= XXH_PRIME64_2;
-                hash ^= hash >> 29;
-                hash *= XXH_PRIME64_3;
-                hash ^= hash >> 32;
-                return hash;
+                value ^= *str++;
+                value *= fnv1a_constant<T>::prime;
             }
-#endif
 
-            h64 ^= h64 >> 33;
-            h64 *= prime2;
-            h64 ^= h64 >> 29;
-            h64 *= prime3;
-            h64 ^= h64 >> 32;
+            return value;
+        }
+
+        //==========================================================
+        // xxHash (XXH64 / XXH3 64bit)
+        // https://github.com/Cyan4973/xxHash
+        //----------------------------------------------------------
+        // 参照実装 (v0.8) と同じハッシュ値を返す
+        // ・XXH3     : 高速（長い入力は SSE2 / AVX2 で処理する）ファイル・シェーダー・バイナリのキャッシュキー向け
+        // ・XXH64    : XXH3 より遅いが、シンプルで広く使われている形式
+        // ・Static～ : 文字列リテラル用のコンパイル時版（実行時版と同じ値になる）
+        //==========================================================
+        static uint64 XXH64(const void* data, uint64 size, uint64 seed = 0);
+        static uint64 XXH3(const void* data, uint64 size, uint64 seed = 0);
 
-            return h64;
+        static uint64 XXH3(std::string_view str, uint64 seed = 0)
+        {
+            return XXH3(str.data(), str.size(), seed);
         }
-#endif
 
+        static consteval uint64 StaticXXH64(std::string_view str, uint64 seed = 0)
+        {
+            return Internal::XXHash::XXH64(str.data(), str.size(), seed);
+        }
 
+        static consteval uint64 StaticXXH3(std::string_view str, uint64 seed = 0)
+        {
+            return Internal::XXHash::XXH3(str.data(), str.size(), seed);
+        }
     };
 }
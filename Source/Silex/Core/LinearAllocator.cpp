@@ -0,0 +1,126 @@
+
+#include "PCH.h"
+#include "Core/LinearAllocator.h"
+
+
+namespace Silex
+{
+    void LinearAllocator::Initialize(uint64 blockSize)
+    {
+        SL_ASSERT(blockByteSize == 0);
+
+        blockByteSize = (blockSize + defaultAlignment - 1) & ~(defaultAlignment - 1);
+
+        head = _AllocateBlock(blockByteSize);
+        current.store(head, std::memory_order_release);
+    }
+
+    void LinearAllocator::Release()
+    {
+        if (blockByteSize == 0)
+            return;
+
+        Block* block = head;
+        while (block)
+        {
+            Block* next = block->next;
+            Memory::Destruct(block);
+            Memory::Free(block);
+
+            block = next;
+        }
+
+        head = nullptr;
+        current.store(nullptr, std::memory_order_release);
+
+        blockByteSize = 0;
+    }
+
+    void* LinearAllocator::Allocate(uint64 size, uint64 alignment)
+    {
+        SL_ASSERT(blockByteSize != 0);
+        SL_ASSERT(std::has_single_bit(alignment));
+
+        // 予約サイズをアライメント単位に揃えておけば、既定のアライメントまでは調整が不要になる
+        // それより大きいアライメントは、予約サイズに余白を含めて先頭を調整する
+        const uint64 padding = alignment > defaultAlignment ? alignment - defaultAlignment : 0;
+        const uint64 reserve = ((size + defaultAlignment - 1) & ~(defaultAlignment - 1)) + padding;
+
+        while (true)
+        {
+            Block* block  = current.load(std::memory_order_acquire);
+            uint64 offset = block->offset.fetch_add(reserve, std::memory_order_relaxed);
+
+            if (offset + reserve <= block->capacity) SL_LIKELY
+            {
+                uint64 address = (uint64)(block->GetData() + offset);
+                return reinterpret_cast<void*>((address + alignment - 1) & ~(alignment - 1));
+            }
+
+            // 容量不足: 以降の確保も全て失敗するので、次のブロックへ切り替える
+            _Grow(block, reserve);
+        }
+    }
+
+    void LinearAllocator::Reset()
+    {
+        for (Block* block = head; block; block = block->next)
+        {
+            block->offset.store(0, std::memory_order_relaxed);
+        }
+
+        current.store(head, std::memory_order_release);
+    }
+
+    uint64 LinearAllocator::GetUsedSize() const
+    {
+        uint64 size = 0;
+        for (const Block* block = head; block; block = block->next)
+        {
+            size += std::min(block->offset.load(std::memory_order_relaxed), block->capacity);
+        }
+
+        return size;
+    }
+
+    uint64 LinearAllocator::GetCapacity() const
+    {
+        uint64 size = 0;
+        for (const Block* block = head; block; block = block->next)
+        {
+            size += block->capacity;
+        }
+
+        return size;
+    }
+
+    void LinearAllocator::_Grow(Block* full, uint64 size)
+    {
+        std::lock_guard<std::mutex> lock(growMutex);
+
+        // 他のスレッドが既に切り替えている
+        if (current.load(std::memory_order_relaxed) != full)
+            return;
+
+        // 前回までに確保したブロックが残っていれば再利用する
+        Block* next = full->next;
+        if (!next || next->capacity < size)
+        {
+            Block* block = _AllocateBlock(std::max(blockByteSize, size));
+            block->next = next;
+            full->next  = block;
+            next        = block;
+        }
+
+        current.store(next, std::memory_order_release);
+    }
+
+    LinearAllocator::Block* LinearAllocator::_AllocateBlock(uint64 capacity)
+    {
+        void*  memory = Memory::Malloc(sizeof(Block) + capacity);
+        Block* block  = Memory::Construct<Block>(memory);
+        block->capacity = capacity;
+
+        return block;
+    }
+}
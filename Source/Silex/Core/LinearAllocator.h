@@ -0,0 +1,132 @@
+#pragma once
+#include "Core/Memory.h"
+#include <atomic>
+#include <mutex>
+
+
+//==================================================================
+// リニア（バンプ）アロケーター
+//------------------------------------------------------------------
+// ・先頭からポインタを進めるだけで確保し、個別の解放は行わない（Reset で一括解放）
+// ・容量が足りなくなれば次のブロックを追加し、Reset 後もブロックは解放せずに再利用する
+//   （ピーク時の容量が確保された後は、ヒープ確保が発生しない）
+// ・Allocate は複数スレッドから同時に呼び出し可能だが、Reset は確保と並行して呼び出さないこと
+// ・デストラクタは呼ばれないので、トリビアルに破棄可能な型のみ配置すること
+//==================================================================
+namespace Silex
+{
+    class LinearAllocator
+    {
+    public:
+
+        static constexpr uint64 defaultAlignment = 16;
+
+    public:
+
+        LinearAllocator()  = default;
+        ~LinearAllocator() { Release(); }
+
+        LinearAllocator(const LinearAllocator&)            = delete;
+        LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+        void Initialize(uint64 blockSize = 256 * 1024); // 256KB
+        void Release();
+
+        void* Allocate(uint64 size, uint64 alignment = defaultAlignment);
+
+        template<typename T, typename ... Args>
+        T* New(Args&& ... args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "デストラクタは呼び出されないので、トリビアルに破棄可能な型のみ配置可能です");
+
+            void* ptr = Allocate(sizeof(T), alignof(T));
+            return Memory::Construct<T>(ptr, Traits::Forward<Args>(args)...);
+        }
+
+        template<typename T>
+        T* NewArray(uint64 count)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "デストラクタは呼び出されないので、トリビアルに破棄可能な型のみ配置可能です");
+
+            T* ptr = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+            for (uint64 i = 0; i < count; i++)
+            {
+                Memory::Construct<T>(ptr + i);
+            }
+
+            return ptr;
+        }
+
+        // 全ての確保を破棄する（確保済みブロックは保持する）
+        void Reset();
+
+        // 使用中のバイト数と、確保済みブロックの合計バイト数
+        uint64 GetUsedSize() const;
+        uint64 GetCapacity() const;
+
+    private:
+
+        struct alignas(defaultAlignment) Block
+        {
+            std::atomic<uint64> offset   = 0;
+            uint64              capacity = 0;
+            Block*              next     = nullptr;
+
+            // 確保領域はヘッダの直後に続く
+            byte* GetData() { return reinterpret_cast<byte*>(this + 1); }
+        };
+
+        void   _Grow(Block* full, uint64 size);
+        Block* _AllocateBlock(uint64 capacity);
+
+    private:
+
+        Block*              head          = nullptr;
+        std::atomic<Block*> current       = nullptr;
+        std::mutex          growMutex;
+        uint64              blockByteSize = 0;
+    };
+
+
+    //===============================================================
+    // リニアアロケーター用 STL アロケーター
+    //---------------------------------------------------------------
+    // deallocate は何もしないので、コンテナの寿命はアロケーターの Reset までに限ること
+    //===============================================================
+    template <typename T>
+    class LinearSTLAllocator
+    {
+    public:
+
+        using value_type = T;
+
+        LinearSTLAllocator(LinearAllocator* linearAllocator) noexcept
+            : allocator(linearAllocator)
+        {}
+
+        template <typename U>
+        LinearSTLAllocator(const LinearSTLAllocator<U>& other) noexcept
+            : allocator(other.allocator)
+        {}
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(allocator->Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, std::size_t) noexcept
+        {
+        }
+
+        template <typename U>
+        bool operator==(const LinearSTLAllocator<U>& other) const noexcept
+        {
+            return allocator == other.allocator;
+        }
+
+        LinearAllocator* allocator = nullptr;
+    };
+
+    template<typename T>
+    using LinearVector = std::vector<T, LinearSTLAllocator<T>>;
+}
@@ -0,0 +1,245 @@
+
+#include "PCH.h"
+#include "Core/LogSink.h"
+#include "Core/OS.h"
+
+#ifndef SL_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+
+namespace Silex
+{
+    //==================================================================
+    // DebugConsoleLogSink
+    //==================================================================
+    void DebugConsoleLogSink::Write(const LogMessage& message)
+    {
+        // 書き込みスレッドからのみ呼ばれるので、バッファを使い回す
+        buffer.clear();
+        buffer += Logger::GetLevelPrefix(message.level);
+        buffer += message.text;
+        buffer += '\n';
+
+        OS::Get()->OutputDebugConsole(buffer);
+    }
+
+
+    namespace Internal
+    {
+        // "時刻 [レベル] [スレッドID] " の最大長（メッセージ本文の前に確保する）
+        static constexpr uint64 logLineHeaderCapacity = 64;
+
+        // ヘッダーと 1 行分の最低限の本文が収まるサイズ
+        static constexpr uint64 minLogSegmentSize = 64 * 1024;
+    }
+
+
+    //==================================================================
+    // FileLogSink
+    //==================================================================
+    FileLogSink::~FileLogSink()
+    {
+        Close();
+    }
+
+    bool FileLogSink::Open(const std::filesystem::path& filePath, uint64 segmentSize, uint32 backupCount)
+    {
+        Close();
+
+        this->path        = filePath;
+        this->segmentSize = std::max(segmentSize, Internal::minLogSegmentSize);
+        this->backupCount = backupCount;
+
+        std::error_code error;
+        if (path.has_parent_path())
+        {
+            std::filesystem::create_directories(path.parent_path(), error);
+        }
+
+        // 前回の実行のログを残す
+        if (std::filesystem::exists(path, error))
+        {
+            _ShiftBackups();
+        }
+
+        return _MapSegment();
+    }
+
+    void FileLogSink::Close()
+    {
+        if (view)
+        {
+            _UnmapSegment();
+        }
+    }
+
+    void FileLogSink::Write(const LogMessage& message)
+    {
+        if (!view)
+            return;
+
+        // セグメントに収まらない長さの本文は切り詰める
+        const uint64 textSize = std::min<uint64>(message.text.size(), segmentSize - Internal::logLineHeaderCapacity - 1);
+
+        if (cursor + Internal::logLineHeaderCapacity + textSize + 1 > segmentSize) SL_UNLIKELY
+        {
+            _Rotate();
+
+            if (!view)
+                return;
+        }
+
+        const uint64 seconds = message.timestamp / 1'000'000;
+        const uint64 micro   = message.timestamp % 1'000'000;
+
+        const std::chrono::hh_mm_ss time{ std::chrono::seconds(seconds % 86400) };
+
+        // マップ領域に直接書き込み、カーソルを進めるだけ
+        char* line   = view + cursor;
+        auto  result = std::format_to_n(line, Internal::logLineHeaderCapacity, "{:02}:{:02}:{:02}.{:06} {}[T{:02}] ",
+            time.hours().count(), time.minutes().count(), time.seconds().count(), micro,
+            Logger::GetLevelPrefix(message.level), message.threadID);
+
+        cursor += result.out - line;
+
+        std::memcpy(view + cursor, message.text.data(), textSize);
+        cursor += textSize;
+
+        view[cursor++] = '\n';
+
+        // 直後にブレークするので、ディスクまで書き出しておく
+        if (message.level == LogLevel::Fatal)
+        {
+            Sync();
+        }
+    }
+
+    void FileLogSink::Sync()
+    {
+        if (!view || cursor == 0)
+            return;
+
+#ifdef SL_PLATFORM_WINDOWS
+        ::FlushViewOfFile(view, cursor);
+        ::FlushFileBuffers(fileHandle);
+#else
+        ::msync(view, cursor, MS_SYNC);
+#endif
+    }
+
+    bool FileLogSink::_MapSegment()
+    {
+        cursor = 0;
+
+#ifdef SL_PLATFORM_WINDOWS
+        HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        // マッピングの作成でファイルがセグメントサイズまで拡張される
+        HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READWRITE, (DWORD)(segmentSize >> 32), (DWORD)(segmentSize & 0xFFFFFFFF), nullptr);
+        if (!mapping)
+        {
+            ::CloseHandle(file);
+            return false;
+        }
+
+        void* address = ::MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, segmentSize);
+        if (!address)
+        {
+            ::CloseHandle(mapping);
+            ::CloseHandle(file);
+            return false;
+        }
+
+        fileHandle    = file;
+        mappingHandle = mapping;
+#else
+        int32 fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            return false;
+
+        if (::ftruncate(fd, segmentSize) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void* address = ::mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        fileDescriptor = fd;
+#endif
+
+        view = static_cast<char*>(address);
+        return true;
+    }
+
+    void FileLogSink::_UnmapSegment()
+    {
+        // マップを解除してから、書き込んだ位置でファイルを切り詰める
+#ifdef SL_PLATFORM_WINDOWS
+        ::UnmapViewOfFile(view);
+        ::CloseHandle(mappingHandle);
+
+        LARGE_INTEGER size;
+        size.QuadPart = cursor;
+
+        ::SetFilePointerEx(fileHandle, size, nullptr, FILE_BEGIN);
+        ::SetEndOfFile(fileHandle);
+        ::CloseHandle(fileHandle);
+
+        fileHandle    = nullptr;
+        mappingHandle = nullptr;
+#else
+        ::munmap(view, segmentSize);
+        ::ftruncate(fileDescriptor, cursor);
+        ::close(fileDescriptor);
+
+        fileDescriptor = -1;
+#endif
+
+        view   = nullptr;
+        cursor = 0;
+    }
+
+    void FileLogSink::_Rotate()
+    {
+        _UnmapSegment();
+        _ShiftBackups();
+        _MapSegment();
+    }
+
+    void FileLogSink::_ShiftBackups()
+    {
+        // 世代数が 0 の場合は、現在のファイルを上書きする
+        if (backupCount == 0)
+            return;
+
+        std::error_code error;
+        std::filesystem::remove(_GetBackupPath(backupCount), error);
+
+        for (uint32 i = backupCount; i > 1; i--)
+        {
+            std::filesystem::rename(_GetBackupPath(i - 1), _GetBackupPath(i), error);
+        }
+
+        std::filesystem::rename(path, _GetBackupPath(1), error);
+    }
+
+    std::filesystem::path FileLogSink::_GetBackupPath(uint32 index) const
+    {
+        // "Logs/Silex.log" → "Logs/Silex.1.log"
+        std::filesystem::path backup = path;
+        backup.replace_filename(path.stem().string() + "." + std::to_string(index) + path.extension().string());
+
+        return backup;
+    }
+}
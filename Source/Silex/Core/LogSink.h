@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Core/Logger.h"
+#include <filesystem>
+
+
+namespace Silex
+{
+    //==================================================================
+    // デバッガー出力（OS::OutputDebugConsole）
+    //==================================================================
+    class DebugConsoleLogSink : public LogSink
+    {
+    public:
+
+        void Write(const LogMessage& message) override;
+
+    private:
+
+        std::string buffer;
+    };
+
+
+    //==================================================================
+    // ファイル出力（メモリマップ）
+    //------------------------------------------------------------------
+    // ・固定サイズに拡張したファイルをマップし、カーソルを進めながら追記する（書き込み毎のシステムコールは無い）
+    // ・セグメントが一杯になると閉じてローテーションする（Silex.log → Silex.1.log → ... → Silex.N.log）
+    // ・マップしたページは OS のページキャッシュにあるので、プロセスがクラッシュしても書き込み済みの内容は残る
+    // ・Fatal ログはディスクへの書き出しまで待機する（電源断などにも残す）
+    // ・正常に閉じた場合は、未使用の末尾を切り詰める（クラッシュ時は末尾が 0 埋めのまま残る）
+    // 各行は "時刻(UTC) [レベル] [スレッドID] メッセージ" の形式
+    //==================================================================
+    class FileLogSink : public LogSink
+    {
+    public:
+
+        static constexpr uint64 defaultSegmentSize = 16 * 1024 * 1024;
+        static constexpr uint32 defaultBackupCount = 4;
+
+        FileLogSink() = default;
+        ~FileLogSink();
+
+        // 既存のファイルは、前回の実行のログとしてローテーションしてから開く
+        bool Open(const std::filesystem::path& filePath, uint64 segmentSize = defaultSegmentSize, uint32 backupCount = defaultBackupCount);
+        void Close();
+
+        void Write(const LogMessage& message) override;
+
+        // マップ済みのページをディスクに書き出し、完了するまで待機する
+        void Sync();
+
+    private:
+
+        bool _MapSegment();
+        void _UnmapSegment();
+        void _Rotate();
+        void _ShiftBackups();
+
+        std::filesystem::path _GetBackupPath(uint32 index) const;
+
+    private:
+
+        std::filesystem::path path;
+        uint64                segmentSize = 0;
+        uint32                backupCount = 0;
+
+        char*  view   = nullptr;
+        uint64 cursor = 0;
+
+#ifdef SL_PLATFORM_WINDOWS
+        void* fileHandle    = nullptr;
+        void* mappingHandle = nullptr;
+#else
+        int32 fileDescriptor = -1;
+#endif
+    };
+}
@@ -2,45 +2,409 @@
 #include "PCH.h"
 
 #include "Core/OS.h"
+#include "Core/LogSink.h"
 #include "Editor/ConsoleLogger.h"
 
+#include <condition_variable>
+
 
 namespace Silex
 {
-    static std::mutex s_LogMutex;
+    namespace Internal
+    {
+        //==============================================================
+        // ログレコード（リングバッファの 1 要素）
+        //--------------------------------------------------------------
+        // 固定長の文字列領域に収まらないメッセージは、ヒープに確保して書き込みスレッドが解放する
+        //==============================================================
+        struct alignas(64) LogRecord
+        {
+            static constexpr uint64 inlineCapacity = 256 - 40;
+
+            std::atomic<uint64> sequence;
+            uint64              timestamp;
+            char*               heapText;
+            uint32              length;
+            uint32              threadID;
+            LogLevel            level;
+            char                text[inlineCapacity];
+
+            std::string_view GetText() const
+            {
+                return { heapText ? heapText : text, length };
+            }
+        };
+
+        static_assert(sizeof(LogRecord) == 256);
+
+        //==============================================================
+        // 有界 MPSC キュー（D. Vyukov の bounded MPMC キューの読み出し側を単一スレッドに限定したもの）
+        //--------------------------------------------------------------
+        // 各レコードのシーケンス番号で、書き込み可能 / 読み出し可能を判定する
+        //   sequence == pos            : 書き込み可能（pos 番目の書き込み待ち）
+        //   sequence == pos + 1        : 読み出し可能
+        //   sequence == pos + capacity : 読み出し済み（次の周回の書き込み待ち）
+        //==============================================================
+        static constexpr uint64 logRingCapacity = 4096; // 1MB
+        static constexpr uint64 logRingMask     = logRingCapacity - 1;
+
+        static LogRecord* logRing = nullptr;
+
+        alignas(64) static std::atomic<uint64> enqueuePosition = 0;
+        alignas(64) static std::atomic<uint64> dequeuePosition = 0;
+        alignas(64) static std::atomic<uint64> droppedCount    = 0;
+
+        // 書き込みスレッド
+        static std::thread             writerThread;
+        static std::atomic<bool>       writerRunning  = false;
+        static std::atomic<bool>       writerSleeping = false;
+        static std::mutex              wakeMutex;
+        static std::condition_variable wakeCondition;
+
+        // シンク（書き込みスレッドの出力中 / 同期出力中 / 登録変更中は排他）
+        static std::mutex            sinkMutex;
+        static std::vector<LogSink*> sinks;
+
+        static DebugConsoleLogSink debugConsoleSink;
+        static FileLogSink         fileSink;
+
+        static constexpr const char* logFilePath = "Logs/Silex.log";
+
+        static std::atomic<uint32> nextThreadID = 0;
+
+        static uint32 GetThreadID()
+        {
+            thread_local uint32 threadID = nextThreadID.fetch_add(1, std::memory_order_relaxed);
+            return threadID;
+        }
+
+        static uint64 GetTimestamp()
+        {
+            auto now = std::chrono::system_clock::now().time_since_epoch();
+            return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+        }
+
+        static void WriteToSinks(const LogMessage& message)
+        {
+            for (LogSink* sink : sinks)
+            {
+                sink->Write(message);
+            }
+        }
+
+        static void FlushSinks()
+        {
+            for (LogSink* sink : sinks)
+            {
+                sink->Flush();
+            }
+        }
+
+        // 読み出し可能なレコードを全てシンクに出力し、出力した件数を返す
+        static uint64 DrainRing()
+        {
+            uint64 position = dequeuePosition.load(std::memory_order_relaxed);
+            uint64 count    = 0;
+
+            std::lock_guard<std::mutex> lock(sinkMutex);
+
+            while (true)
+            {
+                LogRecord& record = logRing[position & logRingMask];
+                if (record.sequence.load(std::memory_order_acquire) != position + 1)
+                    break;
+
+                LogMessage message;
+                message.level     = record.level;
+                message.threadID  = record.threadID;
+                message.timestamp = record.timestamp;
+                message.text      = record.GetText();
+
+                WriteToSinks(message);
+
+                if (record.heapText)
+                {
+                    Memory::Free(record.heapText);
+                    record.heapText = nullptr;
+                }
+
+                // 次の周回の書き込みに開放する
+                record.sequence.store(position + logRingCapacity, std::memory_order_release);
+
+                position++;
+                count++;
+                dequeuePosition.store(position, std::memory_order_release);
+            }
+
+            // 満杯で破棄したログがあれば、件数だけ通知する
+            if (const uint64 dropped = droppedCount.exchange(0, std::memory_order_relaxed))
+            {
+                // 破棄が起きた時のみなので、文字数を気にせず std::string で整形する（固定長だと UTF-8 の途中で切れる）
+                const std::string message = std::format("ログバッファが満杯のため {} 件を破棄しました", dropped);
+
+                WriteToSinks({ LogLevel::Warn, GetThreadID(), GetTimestamp(), message });
+            }
+
+            return count;
+        }
+
+        static void WriterMain()
+        {
+            while (true)
+            {
+                if (DrainRing() != 0)
+                    continue;
+
+                // アイドル: ファイル等のバッファを反映してから眠る
+                {
+                    std::lock_guard<std::mutex> lock(sinkMutex);
+                    FlushSinks();
+                }
+
+                if (!writerRunning.load(std::memory_order_acquire))
+                {
+                    // 停止要求後に書き込まれたログを出力しきってから終了する
+                    if (DrainRing() == 0)
+                        break;
+
+                    continue;
+                }
+
+                // 通知の取りこぼしがあっても、一定時間で起きて読み出す
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                writerSleeping.store(true, std::memory_order_seq_cst);
+
+                const uint64 position = dequeuePosition.load(std::memory_order_relaxed);
+                if (logRing[position & logRingMask].sequence.load(std::memory_order_acquire) != position + 1)
+                {
+                    wakeCondition.wait_for(lock, std::chrono::milliseconds(50));
+                }
+
+                writerSleeping.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        static void WakeWriter()
+        {
+            if (writerSleeping.load(std::memory_order_seq_cst))
+            {
+                wakeCondition.notify_one();
+            }
+        }
+
+        // 書き込み位置を確保する。満杯で破棄する場合は nullptr
+        static LogRecord* AcquireRecord(LogLevel level, uint64& outPosition)
+        {
+            uint64 position = enqueuePosition.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                LogRecord&   record   = logRing[position & logRingMask];
+                const uint64 sequence = record.sequence.load(std::memory_order_acquire);
+                const int64  diff     = (int64)sequence - (int64)position;
+
+                if (diff == 0)
+                {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        outPosition = position;
+                        return &record;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    // 満杯: 詳細なログは破棄し、重要なログは書き込みスレッドが空けるのを待つ
+                    if (level > LogLevel::Warn)
+                    {
+                        droppedCount.fetch_add(1, std::memory_order_relaxed);
+                        return nullptr;
+                    }
+
+                    WakeWriter();
+                    std::this_thread::yield();
+
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+                else
+                {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
 
 
     void Logger::Initialize()
     {
+        using namespace Internal;
+
         OS::Get()->SetConsoleAttribute(8);
+
+        // LogRecord は alignas(64) なので、Memory::Malloc (16 バイト境界) ではなくアライメント指定で確保する
+#ifdef SL_PLATFORM_WINDOWS
+        logRing = static_cast<LogRecord*>(_aligned_malloc(sizeof(LogRecord) * logRingCapacity, alignof(LogRecord)));
+#else
+        logRing = static_cast<LogRecord*>(std::aligned_alloc(alignof(LogRecord), sizeof(LogRecord) * logRingCapacity));
+#endif
+        SL_ASSERT(logRing != nullptr);
+
+        for (uint64 i = 0; i < logRingCapacity; i++)
+        {
+            LogRecord* record = Memory::Construct<LogRecord>(&logRing[i]);
+            record->sequence.store(i, std::memory_order_relaxed);
+            record->heapText = nullptr;
+        }
+
+        enqueuePosition.store(0, std::memory_order_relaxed);
+        dequeuePosition.store(0, std::memory_order_relaxed);
+
+        fileSink.Open(logFilePath);
+
+        {
+            std::lock_guard<std::mutex> lock(sinkMutex);
+            sinks.push_back(&debugConsoleSink);
+            sinks.push_back(&fileSink);
+            sinks.push_back(&ConsoleLogger::Get());
+        }
+
+        writerRunning.store(true, std::memory_order_release);
+        writerThread = std::thread(WriterMain);
     }
 
     void Logger::Finalize()
     {
+        using namespace Internal;
+
+        // 書き込みスレッドは、停止要求までに書き込まれたログを出力しきってから終了する
+        writerRunning.store(false, std::memory_order_release);
+        wakeCondition.notify_one();
+
+        if (writerThread.joinable())
+        {
+            writerThread.join();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(sinkMutex);
+            FlushSinks();
+            sinks.clear();
+        }
+
+        fileSink.Close();
+
+#ifdef SL_PLATFORM_WINDOWS
+        _aligned_free(logRing);
+#else
+        std::free(logRing);
+#endif
+        logRing = nullptr;
+
         OS::Get()->SetConsoleAttribute(8);
     }
 
     void Logger::SetLogLevel(LogLevel level)
     {
-        logFilter = level;
+        logFilter.store(level, std::memory_order_relaxed);
+    }
+
+    void Logger::AddSink(LogSink* sink)
+    {
+        std::lock_guard<std::mutex> lock(Internal::sinkMutex);
+        Internal::sinks.push_back(sink);
     }
 
-    void Logger::Log(LogLevel level, const std::string& msg)
+    void Logger::RemoveSink(LogSink* sink)
     {
+        std::lock_guard<std::mutex> lock(Internal::sinkMutex);
+        std::erase(Internal::sinks, sink);
+    }
+
+    void Logger::Flush()
+    {
+        using namespace Internal;
+
+        if (!writerRunning.load(std::memory_order_acquire))
+            return;
+
+        // 呼び出し時点で確保済みの位置まで、書き込みスレッドが読み出し終えるのを待つ
+        const uint64 target = enqueuePosition.load(std::memory_order_acquire);
+        while (dequeuePosition.load(std::memory_order_acquire) < target)
+        {
+            WakeWriter();
+            std::this_thread::yield();
+        }
+
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        FlushSinks();
+    }
+
+    void Logger::Log(LogLevel level, std::string_view message)
+    {
+        using namespace Internal;
+
         // ログレベルのフィルタリング
-        if (level <= logFilter)
+        if (level > logFilter.load(std::memory_order_relaxed))
+            return;
+
+        // 書き込みスレッドが動いていない（初期化前 / 終了後）場合は、同期的に出力する
+        if (!writerRunning.load(std::memory_order_acquire)) SL_UNLIKELY
         {
-            switch (level)
-            {
-                case LogLevel::Fatal : OS::Get()->OutputDebugConsole("[FATAL] " + msg + "\n"); ConsoleLogger::Get().Log(level, "[FATAL] " + msg + "\n"); break;
-                case LogLevel::Error : OS::Get()->OutputDebugConsole("[ERROR] " + msg + "\n"); ConsoleLogger::Get().Log(level, "[ERROR] " + msg + "\n"); break;
-                case LogLevel::Warn  : OS::Get()->OutputDebugConsole("[WARN ] " + msg + "\n"); ConsoleLogger::Get().Log(level, "[WARN ] " + msg + "\n"); break;
-                case LogLevel::Info  : OS::Get()->OutputDebugConsole("[INFO ] " + msg + "\n"); ConsoleLogger::Get().Log(level, "[INFO ] " + msg + "\n"); break;
-                case LogLevel::Trace : OS::Get()->OutputDebugConsole("[TRACE] " + msg + "\n"); ConsoleLogger::Get().Log(level, "[TRACE] " + msg + "\n"); break;
-                case LogLevel::Debug : OS::Get()->OutputDebugConsole("[DEBUG] " + msg + "\n"); ConsoleLogger::Get().Log(level, "[DEBUG] " + msg + "\n"); break;
+            std::lock_guard<std::mutex> lock(sinkMutex);
 
-                default: break;
+            if (sinks.empty())
+            {
+                OS::Get()->OutputDebugConsole(GetLevelPrefix(level) + std::string(message) + "\n");
             }
+            else
+            {
+                WriteToSinks({ level, GetThreadID(), GetTimestamp(), message });
+            }
+
+            return;
+        }
+
+        uint64     position;
+        LogRecord* record = AcquireRecord(level, position);
+        if (!record)
+            return;
+
+        record->timestamp = GetTimestamp();
+        record->threadID  = GetThreadID();
+        record->level     = level;
+        record->length    = (uint32)message.size();
+
+        if (message.size() <= LogRecord::inlineCapacity) SL_LIKELY
+        {
+            std::memcpy(record->text, message.data(), message.size());
+        }
+        else
+        {
+            record->heapText = static_cast<char*>(Memory::Malloc(message.size()));
+            std::memcpy(record->heapText, message.data(), message.size());
+        }
+
+        record->sequence.store(position + 1, std::memory_order_release);
+        WakeWriter();
+
+        // 直後にブレークするので、出力を完了させておく
+        if (level == LogLevel::Fatal)
+        {
+            Flush();
+        }
+    }
+
+    const char* Logger::GetLevelPrefix(LogLevel level)
+    {
+        switch (level)
+        {
+            case LogLevel::Fatal : return "[FATAL] ";
+            case LogLevel::Error : return "[ERROR] ";
+            case LogLevel::Warn  : return "[WARN ] ";
+            case LogLevel::Info  : return "[INFO ] ";
+            case LogLevel::Trace : return "[TRACE] ";
+            case LogLevel::Debug : return "[DEBUG] ";
+
+            default: return "";
         }
     }
 }
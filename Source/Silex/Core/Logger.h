@@ -1,9 +1,11 @@
-
 #pragma once
 
 #include "Core/CoreType.h"
+#include "Core/Macros.h"
+#include <atomic>
 #include <format>
 #include <string>
+#include <string_view>
 
 
 namespace Silex
@@ -20,6 +22,41 @@ namespace Silex
         Count,
     };
 
+    // シンクに渡されるログ（text は Write の呼び出し中のみ有効）
+    struct LogMessage
+    {
+        LogLevel         level;
+        uint32           threadID;
+        uint64           timestamp; // UNIX 時間（マイクロ秒）
+        std::string_view text;
+    };
+
+    //==================================================================
+    // ログ出力先
+    //------------------------------------------------------------------
+    // Write / Flush はログ書き込みスレッドからのみ呼ばれる（複数スレッドから同時には呼ばれない）
+    //==================================================================
+    class LogSink
+    {
+    public:
+
+        virtual ~LogSink() = default;
+
+        virtual void Write(const LogMessage& message) = 0;
+        virtual void Flush() {}
+    };
+
+
+    //==================================================================
+    // 非同期ロガー
+    //------------------------------------------------------------------
+    // ・呼び出し側はスタック上のバッファに整形し、固定長レコードのリングバッファへ書き込むだけ
+    //   （リングバッファはロックフリーの MPSC キュー）
+    // ・書き込みスレッドがリングバッファを読み出し、登録されたシンクへ出力する
+    // ・リングバッファが満杯の場合、Warn 以上は空きを待ち、それ以外は破棄して件数のみ記録する
+    // ・Fatal は出力が完了するまで待機する（直後にブレークするため）
+    // ・Initialize 前 / Finalize 後は、呼び出したスレッドで同期的に出力する
+    //==================================================================
     class Logger
     {
     public:
@@ -28,10 +65,45 @@ namespace Silex
         static void Finalize();
         static void SetLogLevel(LogLevel level);
 
-        static void Log(LogLevel level, const std::string& message);
+        // シンクの所有権は呼び出し側にある（登録中は破棄しないこと）
+        static void AddSink(LogSink* sink);
+        static void RemoveSink(LogSink* sink);
+
+        // 呼び出し時点までに書き込まれたログを、全てシンクに出力し終えるまで待機する
+        static void Flush();
+
+        static void Log(LogLevel level, std::string_view message);
+
+        // 引数は const 参照で受け取り、書式文字列の型を std::format_to_n / std::format にそのまま渡せるようにする
+        template<typename ... Args>
+        static void Format(LogLevel level, std::format_string<const Args&...> format, const Args& ... args)
+        {
+            if (level > logFilter.load(std::memory_order_relaxed))
+                return;
+
+            // 大半のログはスタック上で整形でき、一時文字列を生成しない
+            char buffer[formatBufferSize];
+            auto result = std::format_to_n(buffer, sizeof(buffer), format, args...);
+
+            if (result.size <= (std::ptrdiff_t)sizeof(buffer)) SL_LIKELY
+            {
+                Log(level, std::string_view(buffer, result.size));
+            }
+            else
+            {
+                Log(level, std::format(format, args...));
+            }
+        }
+
+        static bool IsEnabled(LogLevel level) { return level <= logFilter.load(std::memory_order_relaxed); }
+
+        static const char* GetLevelPrefix(LogLevel level);
 
     private:
 
-        static inline LogLevel logFilter = LogLevel::Debug;
+        static constexpr uint64 formatBufferSize = 512;
+
+        // 任意のスレッドから SetLogLevel と並行して読まれる（順序の保証は不要）
+        static inline std::atomic<LogLevel> logFilter = LogLevel::Debug;
     };
 }
@@ -2,8 +2,11 @@
 #pragma once
 
 // デバッグ
-#define SL_ENABLE_ALLOCATION_TRACKER 1
-#define SL_ENABLE_ASSERTS            1
+#define SL_ENABLE_ALLOCATION_TRACKER      1
+#define SL_ALLOCATION_TRACKER_SAMPLE_RATE 1 // N 回に1回の確保を記録する
+#define SL_ENABLE_ASSERTS                 1
+#define SL_ENABLE_SPINLOCK_STATS          0 // スピンロックの競合回数を計測する
+#define SL_ENABLE_PROFILER                1 // SL_SCOPE_PROFILE のゾーンを記録する
 
 // レンダリング
 #define SL_RENDERER_INVERT_Y_AXIS 1
@@ -52,11 +55,19 @@
     #define SL_FORCEINLINE   __forceinline
     #define SL_FUNCNAME      __FUNCTION__
     #define SL_FUNCSIG       __FUNCSIG__
+    #define SL_CPU_PAUSE()   _mm_pause()
 #else
     #define SL_DEBUG_BREAK() __builtin_trap();
     #define SL_FORCEINLINE   __attribute__((__always_inline__))
     #define SL_FUNCNAME      __FUNCTION__
     #define SL_FUNCSIG       __PRETTY_FUNCTION__
+    #if defined(__x86_64__) || defined(__i386__)
+        #define SL_CPU_PAUSE() __builtin_ia32_pause()
+    #elif defined(__aarch64__)
+        #define SL_CPU_PAUSE() __asm__ __volatile__("yield")
+    #else
+        #define SL_CPU_PAUSE() SL_DONT_USE
+    #endif
 #endif
 
 
@@ -73,13 +84,50 @@
 // ログ
 //===========================================================================================================================
 
+// コンパイル時に残すログレベル（LogLevel の値: Fatal 0 ～ Debug 5）
+// これより詳細なレベルのログは、引数の評価も含めてコンパイル時に除去される
+#ifndef SL_LOG_LEVEL
+    #if SL_DEBUG
+        #define SL_LOG_LEVEL 5 // Debug まで
+    #else
+        #define SL_LOG_LEVEL 3 // Info まで
+    #endif
+#endif
+
+#define SL_LOG_DISCARD(...) ((void)0)
+
 // コンソールログ
-#define SL_LOG_FATAL(...) Silex::Logger::Log(Silex::LogLevel::Fatal, std::format(__VA_ARGS__))
-#define SL_LOG_ERROR(...) Silex::Logger::Log(Silex::LogLevel::Error, std::format(__VA_ARGS__))
-#define SL_LOG_WARN(...)  Silex::Logger::Log(Silex::LogLevel::Warn,  std::format(__VA_ARGS__))
-#define SL_LOG_INFO(...)  Silex::Logger::Log(Silex::LogLevel::Info,  std::format(__VA_ARGS__))
-#define SL_LOG_TRACE(...) Silex::Logger::Log(Silex::LogLevel::Trace, std::format(__VA_ARGS__))
-#define SL_LOG_DEBUG(...) Silex::Logger::Log(Silex::LogLevel::Debug, std::format(__VA_ARGS__))
+#define SL_LOG_FATAL(...) Silex::Logger::Format(Silex::LogLevel::Fatal, __VA_ARGS__)
+
+#if SL_LOG_LEVEL >= 1
+    #define SL_LOG_ERROR(...) Silex::Logger::Format(Silex::LogLevel::Error, __VA_ARGS__)
+#else
+    #define SL_LOG_ERROR(...) SL_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if SL_LOG_LEVEL >= 2
+    #define SL_LOG_WARN(...)  Silex::Logger::Format(Silex::LogLevel::Warn,  __VA_ARGS__)
+#else
+    #define SL_LOG_WARN(...)  SL_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if SL_LOG_LEVEL >= 3
+    #define SL_LOG_INFO(...)  Silex::Logger::Format(Silex::LogLevel::Info,  __VA_ARGS__)
+#else
+    #define SL_LOG_INFO(...)  SL_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if SL_LOG_LEVEL >= 4
+    #define SL_LOG_TRACE(...) Silex::Logger::Format(Silex::LogLevel::Trace, __VA_ARGS__)
+#else
+    #define SL_LOG_TRACE(...) SL_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if SL_LOG_LEVEL >= 5
+    #define SL_LOG_DEBUG(...) Silex::Logger::Format(Silex::LogLevel::Debug, __VA_ARGS__)
+#else
+    #define SL_LOG_DEBUG(...) SL_LOG_DISCARD(__VA_ARGS__)
+#endif
 
 // プラットフォーム固有メッセージダイアログ
 #define SL_MESSAGE_INFO(...)  Silex::OS::Get()->Message(OS_MESSEGA_TYPE_INFO,  std::format(__VA_ARGS__))
@@ -159,11 +207,15 @@ inline void  operator delete  (void*, void*, SLEmpty) noexcept { return; }
 inline void  operator delete[](void*, void*, SLEmpty) noexcept { return; }
 #else
     #if SL_ENABLE_ALLOCATION_TRACKER
-        #define slnew(T, ...) Memory::Allocate<T>(#T, __FILE__, __LINE__ __VA_OPT__(,) __VA_ARGS__)
-        #define sldelete(ptr) Memory::Deallocate(ptr)
+        #define slnew(T, ...)          Memory::Allocate<T>(#T, __FILE__, __LINE__ __VA_OPT__(,) __VA_ARGS__)
+        #define sldelete(ptr)          Memory::Deallocate(ptr)
+        #define slnewArray(T, count)   Memory::AllocateArray<T>(#T "[]", __FILE__, __LINE__, count)
+        #define sldeleteArray(ptr)     Memory::DeallocateArray(ptr)
     #else
-        #define slnew(T, ...) Memory::Allocate<T>(__VA_ARGS__)
-        #define sldelete(ptr) Memory::Deallocate(ptr)
+        #define slnew(T, ...)          Memory::Allocate<T>(__VA_ARGS__)
+        #define sldelete(ptr)          Memory::Deallocate(ptr)
+        #define slnewArray(T, count)   Memory::AllocateArray<T>(count)
+        #define sldeleteArray(ptr)     Memory::DeallocateArray(ptr)
     #endif
 #endif
 
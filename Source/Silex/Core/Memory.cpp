@@ -32,27 +32,317 @@ namespace Silex
         pool.Deallocate(pointer);
     }
 
-    const uint64 t = 10 * 1024 * 1024;
+    //============================================================================
+    // メモリトラッカー
+    //============================================================================
+    namespace Internal
+    {
+        static constexpr uint32 maxTrackedCallsites = 4096; // 2の累乗
+        static constexpr uint32 maxTrackedTags      = 64;
+        static constexpr uint32 maxSampleRate       = UINT16_MAX;
+
+        struct TrackerTag
+        {
+            std::atomic<uint32> state = 0; // 0: 未使用, 1: 登録中, 2: 登録済み
+            std::string_view    name;
+
+            std::atomic<int64>  liveBytes        = 0;
+            std::atomic<int64>  peakBytes        = 0;
+            std::atomic<uint64> frameCounter     = 0;
+            std::atomic<uint64> frameAllocations = 0;
+        };
+
+        struct TrackerCallsite
+        {
+            std::atomic<uint64> key   = 0; // ファイル名のアドレスと行番号（0: 未使用）
+            std::atomic<bool>   ready = false;
+
+            const char* desc = nullptr;
+            const char* file = nullptr;
+            uint32      line = 0;
+            uint32      tag  = 0;
+
+            std::atomic<int64>  liveBytes        = 0;
+            std::atomic<int64>  peakBytes        = 0;
+            std::atomic<int64>  liveCount        = 0;
+            std::atomic<uint64> totalAllocations = 0;
+            std::atomic<uint64> frameCounter     = 0;
+            std::atomic<uint64> frameAllocations = 0;
+        };
+
+        static TrackerCallsite     trackerCallsites[maxTrackedCallsites];
+        static std::atomic<uint32> trackerCallsiteOrder[maxTrackedCallsites]; // 登録順のインデックス + 1
+        static std::atomic<uint32> numTrackerCallsites = 0;
+        static TrackerTag          trackerTags[maxTrackedTags];
+
+        static std::atomic<uint32> trackerSampleRate = SL_ALLOCATION_TRACKER_SAMPLE_RATE;
+        static std::atomic<int64>  trackerLiveBytes  = 0;
+        static std::atomic<int64>  trackerPeakBytes  = 0;
+
+        static thread_local uint32 trackerSampleCounter = 0;
+
+        static void UpdatePeak(std::atomic<int64>& peak, int64 value)
+        {
+            int64 current = peak.load(std::memory_order_relaxed);
+            while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        // "…/Silex/Rendering/Renderer.cpp" → "Rendering"
+        static std::string_view ExtractTagName(const char* file)
+        {
+            std::string_view path = file;
+
+            uint64 root = path.rfind("Silex\\");
+            if (root == std::string_view::npos)
+                root = path.rfind("Silex/");
+
+            if (root == std::string_view::npos)
+                return "Other";
+
+            std::string_view relative = path.substr(root + 6);
+            uint64           end      = relative.find_first_of("\\/");
+
+            return end == std::string_view::npos ? std::string_view("Silex") : relative.substr(0, end);
+        }
+
+        static uint32 FindTag(std::string_view name)
+        {
+            for (uint32 i = 0; i < maxTrackedTags; i++)
+            {
+                TrackerTag& tag = trackerTags[i];
+
+                uint32 state = tag.state.load(std::memory_order_acquire);
+                if (state == 0)
+                {
+                    if (tag.state.compare_exchange_strong(state, 1, std::memory_order_acquire))
+                    {
+                        tag.name = name;
+                        tag.state.store(2, std::memory_order_release);
+                        return i;
+                    }
+                }
+
+                // 他スレッドの登録完了を待つ
+                while (state != 2)
+                {
+                    state = tag.state.load(std::memory_order_acquire);
+                }
+
+                if (tag.name == name)
+                    return i;
+            }
+
+            // 上限を超えた場合は、最後のタグに集計する
+            return maxTrackedTags - 1;
+        }
+
+        static TrackerCallsite* FindCallsite(const char* desc, const char* file, uint32 line, uint32* outIndex)
+        {
+            const uint64 key = (uint64)file ^ ((uint64)line << 48);
+
+            uint64 hash = key;
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+            hash ^= hash >> 33;
+
+            for (uint32 probe = 0; probe < maxTrackedCallsites; probe++)
+            {
+                uint32           index    = (hash + probe) & (maxTrackedCallsites - 1);
+                TrackerCallsite& callsite = trackerCallsites[index];
+
+                uint64 current = callsite.key.load(std::memory_order_acquire);
+                if (current == 0)
+                {
+                    if (callsite.key.compare_exchange_strong(current, key, std::memory_order_acq_rel))
+                    {
+                        callsite.desc = desc;
+                        callsite.file = file;
+                        callsite.line = line;
+                        callsite.tag  = FindTag(ExtractTagName(file));
+                        callsite.ready.store(true, std::memory_order_release);
+
+                        uint32 order = numTrackerCallsites.fetch_add(1, std::memory_order_relaxed);
+                        trackerCallsiteOrder[order].store(index + 1, std::memory_order_release);
+
+                        *outIndex = index;
+                        return &callsite;
+                    }
+                }
+
+                if (current == key)
+                {
+                    // 他スレッドの登録完了を待つ
+                    while (!callsite.ready.load(std::memory_order_acquire))
+                    {
+                    }
+
+                    *outIndex = index;
+                    return &callsite;
+                }
+            }
+
+            return nullptr;
+        }
+
+        // 利用者データ: [0..15] 呼び出し箇所インデックス + 1, [16..31] サンプリング間隔, [32..63] 記録バイト数
+        static uint64 EncodeTrackerData(uint32 index, uint32 weight, uint64 bytes)
+        {
+            return (uint64)(index + 1) | ((uint64)weight << 16) | (bytes << 32);
+        }
+    }
 
     void MemoryTracker::RecordAllocate(void* ptr, uint64 size, const char* desc, const char* file, uint64 line)
     {
-        allocationMap[ptr] = {size, desc, file, line};
+        const uint32 rate = Internal::trackerSampleRate.load(std::memory_order_relaxed);
+        if (rate > 1)
+        {
+            if (++Internal::trackerSampleCounter < rate)
+                return;
+
+            Internal::trackerSampleCounter = 0;
+        }
+
+        uint32 index = 0;
+        Internal::TrackerCallsite* callsite = Internal::FindCallsite(desc, file, (uint32)line, &index);
+        if (!callsite)
+            return;
+
+        // 利用者データに格納できる範囲に制限する（解放時も同じ値を減算するので、集計は崩れない）
+        const int64 bytes = (int64)std::min<uint64>(size * rate, UINT32_MAX);
+        Internal::TrackerTag& tag = Internal::trackerTags[callsite->tag];
+
+        Internal::UpdatePeak(callsite->peakBytes,   callsite->liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+        Internal::UpdatePeak(tag.peakBytes,         tag.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+        Internal::UpdatePeak(Internal::trackerPeakBytes, Internal::trackerLiveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+
+        callsite->liveCount.fetch_add(rate, std::memory_order_relaxed);
+        callsite->totalAllocations.fetch_add(rate, std::memory_order_relaxed);
+        callsite->frameCounter.fetch_add(rate, std::memory_order_relaxed);
+        tag.frameCounter.fetch_add(rate, std::memory_order_relaxed);
+
+        MemoryPool::SetUserData(ptr, Internal::EncodeTrackerData(index, rate, bytes));
     }
 
     void MemoryTracker::RecordDeallocate(void* ptr)
     {
-        allocationMap.erase(ptr);
+        // サンプリングされなかった確保
+        const uint64 data = MemoryPool::GetUserData(ptr);
+        if (data == 0)
+            return;
+
+        const uint32 index  = (uint32)(data & 0xffff) - 1;
+        const uint32 weight = (uint32)((data >> 16) & 0xffff);
+        const int64  bytes  = (int64)(data >> 32);
+
+        Internal::TrackerCallsite& callsite = Internal::trackerCallsites[index];
+        Internal::TrackerTag&      tag      = Internal::trackerTags[callsite.tag];
+
+        callsite.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        callsite.liveCount.fetch_sub(weight, std::memory_order_relaxed);
+        tag.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        Internal::trackerLiveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    void MemoryTracker::NewFrame()
+    {
+        const uint32 count = Internal::numTrackerCallsites.load(std::memory_order_acquire);
+        for (uint32 i = 0; i < count; i++)
+        {
+            uint32 order = Internal::trackerCallsiteOrder[i].load(std::memory_order_acquire);
+            if (order == 0)
+                continue;
+
+            Internal::TrackerCallsite& callsite = Internal::trackerCallsites[order - 1];
+            callsite.frameAllocations.store(callsite.frameCounter.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        for (Internal::TrackerTag& tag : Internal::trackerTags)
+        {
+            if (tag.state.load(std::memory_order_acquire) == 2)
+                tag.frameAllocations.store(tag.frameCounter.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    void MemoryTracker::SetSampleRate(uint32 rate)
+    {
+        Internal::trackerSampleRate.store(std::clamp(rate, 1u, Internal::maxSampleRate), std::memory_order_relaxed);
+    }
+
+    uint32 MemoryTracker::GetSampleRate()
+    {
+        return Internal::trackerSampleRate.load(std::memory_order_relaxed);
+    }
+
+    int64 MemoryTracker::GetLiveBytes()
+    {
+        return Internal::trackerLiveBytes.load(std::memory_order_relaxed);
+    }
+
+    int64 MemoryTracker::GetPeakBytes()
+    {
+        return Internal::trackerPeakBytes.load(std::memory_order_relaxed);
+    }
+
+    void MemoryTracker::GetCallsiteStats(std::vector<MemoryCallsiteStats>& outStats)
+    {
+        outStats.clear();
+
+        const uint32 count = Internal::numTrackerCallsites.load(std::memory_order_acquire);
+        for (uint32 i = 0; i < count; i++)
+        {
+            uint32 order = Internal::trackerCallsiteOrder[i].load(std::memory_order_acquire);
+            if (order == 0)
+                continue;
+
+            const Internal::TrackerCallsite& callsite = Internal::trackerCallsites[order - 1];
+
+            MemoryCallsiteStats& stats = outStats.emplace_back();
+            stats.desc             = callsite.desc;
+            stats.file             = callsite.file;
+            stats.line             = callsite.line;
+            stats.tag              = Internal::trackerTags[callsite.tag].name;
+            stats.liveBytes        = callsite.liveBytes.load(std::memory_order_relaxed);
+            stats.peakBytes        = callsite.peakBytes.load(std::memory_order_relaxed);
+            stats.liveCount        = callsite.liveCount.load(std::memory_order_relaxed);
+            stats.totalAllocations = callsite.totalAllocations.load(std::memory_order_relaxed);
+            stats.frameAllocations = callsite.frameAllocations.load(std::memory_order_relaxed);
+        }
+    }
+
+    void MemoryTracker::GetTagStats(std::vector<MemoryTagStats>& outStats)
+    {
+        outStats.clear();
+
+        for (const Internal::TrackerTag& tag : Internal::trackerTags)
+        {
+            if (tag.state.load(std::memory_order_acquire) != 2)
+                continue;
+
+            MemoryTagStats& stats = outStats.emplace_back();
+            stats.tag              = tag.name;
+            stats.liveBytes        = tag.liveBytes.load(std::memory_order_relaxed);
+            stats.peakBytes        = tag.peakBytes.load(std::memory_order_relaxed);
+            stats.frameAllocations = tag.frameAllocations.load(std::memory_order_relaxed);
+        }
     }
 
     void MemoryTracker::DumpMemoryStats()
     {
 #if SL_ENABLE_ALLOCATION_TRACKER
+        std::vector<MemoryCallsiteStats> callsites;
+        GetCallsiteStats(callsites);
+
         SL_LOG_WARN("*************************************************************************************************************");
-        SL_LOG_WARN(" Memory In Use:");
+        SL_LOG_WARN(" Memory In Use: {} byte (peak: {} byte, sample rate: 1/{})", GetLiveBytes(), GetPeakBytes(), GetSampleRate());
         SL_LOG_WARN("*************************************************************************************************************");
-        for (auto& [ptr, info] : allocationMap)
+        for (const MemoryCallsiteStats& stats : callsites)
         {
-            SL_LOG_WARN(" {:>4} byte | {:<20} | {} [{}]", info.size, info.desc, info.file, info.line);
+            if (stats.liveCount > 0)
+            {
+                SL_LOG_WARN(" {:>6} byte ({:>4}) | {:<20} | {} [{}]", stats.liveBytes, stats.liveCount, stats.desc, stats.file, stats.line);
+            }
         }
         SL_LOG_WARN("*************************************************************************************************************");
 #endif
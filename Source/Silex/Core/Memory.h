@@ -11,8 +11,15 @@
 #include <unordered_set>
 #include <mutex>
 #include <filesystem>
+#include <string_view>
+#include <vector>
 #include <atomic>
 #include <bit>
+#include <thread>
+
+#if _MSC_VER
+    #include <intrin.h>
+#endif
 
 
 
@@ -52,23 +59,100 @@ public:
 
 namespace Silex
 {
+    //===============================================================
+    // スピンロック
+    //---------------------------------------------------------------
+    // ・test-and-test-and-set: 取得に失敗したら、解放されるまで読み取りのみで待機する
+    //   （書き込みによるキャッシュラインの奪い合いを避ける）
+    // ・待機中は CPU の pause ヒントを挟み、回数を指数的に増やしていく
+    //   上限に達したら、ロック保持者に CPU を譲るためにスレッドを明け渡す
+    // ・SL_ENABLE_SPINLOCK_STATS が有効な場合、競合回数と待機ループ回数を計測する
+    //===============================================================
     class SpinLock
     {
+        static constexpr uint32 maxPauseCount = 64;
+
         mutable std::atomic_flag locked = ATOMIC_FLAG_INIT;
 
+#if SL_ENABLE_SPINLOCK_STATS
+        mutable std::atomic<uint64> contentionCount = 0;
+        mutable std::atomic<uint64> spinCount       = 0;
+#endif
+
     public:
 
         SL_FORCEINLINE void lock() const
         {
-            while (locked.test_and_set(std::memory_order_acquire))
-            {
-            }
+            if (!locked.test_and_set(std::memory_order_acquire)) SL_LIKELY
+                return;
+
+            _LockContended();
+        }
+
+        SL_FORCEINLINE bool try_lock() const
+        {
+            return !locked.test(std::memory_order_relaxed) && !locked.test_and_set(std::memory_order_acquire);
         }
 
         SL_FORCEINLINE void unlock() const
         {
             locked.clear(std::memory_order_release);
         }
+
+        // 競合（初回の取得に失敗した）回数と、待機ループの総回数
+        uint64 GetContentionCount() const
+        {
+#if SL_ENABLE_SPINLOCK_STATS
+            return contentionCount.load(std::memory_order_relaxed);
+#else
+            return 0;
+#endif
+        }
+
+        uint64 GetSpinCount() const
+        {
+#if SL_ENABLE_SPINLOCK_STATS
+            return spinCount.load(std::memory_order_relaxed);
+#else
+            return 0;
+#endif
+        }
+
+    private:
+
+        void _LockContended() const
+        {
+            uint32 pauseCount = 1;
+            uint64 spin       = 0;
+
+            do
+            {
+                while (locked.test(std::memory_order_relaxed))
+                {
+                    if (pauseCount <= maxPauseCount)
+                    {
+                        for (uint32 i = 0; i < pauseCount; i++)
+                            SL_CPU_PAUSE();
+
+                        pauseCount <<= 1;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    spin++;
+                }
+
+            } while (locked.test_and_set(std::memory_order_acquire));
+
+#if SL_ENABLE_SPINLOCK_STATS
+            contentionCount.fetch_add(1, std::memory_order_relaxed);
+            spinCount.fetch_add(spin, std::memory_order_relaxed);
+#else
+            SL_DONT_USE_VAR(spin);
+#endif
+        }
     };
 
 
@@ -115,26 +199,59 @@ namespace Silex
     };
 #endif
 
+    // 呼び出し箇所ごとの統計
+    struct MemoryCallsiteStats
+    {
+        const char*      desc             = nullptr;
+        const char*      file             = nullptr;
+        uint32           line             = 0;
+        std::string_view tag              = {};
+        int64            liveBytes        = 0;
+        int64            peakBytes        = 0;
+        int64            liveCount        = 0;
+        uint64           totalAllocations = 0;
+        uint64           frameAllocations = 0; // 前フレームの確保回数
+    };
+
+    // サブシステム（ソースディレクトリ）ごとの統計
+    struct MemoryTagStats
+    {
+        std::string_view tag              = {};
+        int64            liveBytes        = 0;
+        int64            peakBytes        = 0;
+        uint64           frameAllocations = 0;
+    };
+
+    //===============================================================
+    // メモリトラッカー
+    //---------------------------------------------------------------
+    // slnew の呼び出し箇所（ファイル・行）ごとに、固定長のロックフリーテーブルへ集計する
+    // 呼び出し箇所はソースディレクトリ名（Core, Rendering, ...）をタグとして、サブシステム単位でも集計する
+    //
+    // サンプリング間隔 N を指定すると、N 回に1回の確保のみ記録し、サイズ・回数を N 倍して推定する
+    // 記録した呼び出し箇所はプールブロックの利用者データに保持するので、解放時に検索は発生しない
+    //===============================================================
     class MemoryTracker
     {
     public:
 
         static void RecordAllocate(void* ptr, uint64 size, const char* desc, const char* file, uint64 line);
         static void RecordDeallocate(void* ptr);
-        static void DumpMemoryStats();
 
-    private:
+        // フレームごとの確保回数を確定する（フレーム先頭で呼び出す）
+        static void NewFrame();
 
-        // メモリデータ
-        struct AllocationElement
-        {
-            uint64      size = {};
-            const char* desc = {};
-            const char* file = {};
-            uint64      line = {};
-        };
+        // サンプリング間隔（1 で全ての確保を記録）
+        static void   SetSampleRate(uint32 rate);
+        static uint32 GetSampleRate();
+
+        static int64 GetLiveBytes();
+        static int64 GetPeakBytes();
+
+        static void GetCallsiteStats(std::vector<MemoryCallsiteStats>& outStats);
+        static void GetTagStats(std::vector<MemoryTagStats>& outStats);
 
-        static inline std::unordered_map<void*, AllocationElement> allocationMap;
+        static void DumpMemoryStats();
     };
 
 
@@ -151,11 +268,17 @@ namespace Silex
         static void* Allocate(uint64 sizeByte);
         static void  Deallocate(void* pointer);
 
-        static const std::array<MemoryPoolStatus, 6>& GetStatus()
+        static std::array<MemoryPoolStatus, MemoryPool::numStatus> GetStatus()
         {
             return pool.GetStatus();
         }
 
+        // 未使用ページを OS へ返却する
+        static void Trim()
+        {
+            pool.Trim();
+        }
+
     private:
 
         static inline MemoryPool pool;
@@ -201,12 +324,12 @@ namespace Silex
             std::free(ptr);
         }
 
-        // プールから確保
+        // プールから確保（256KB を超えるサイズは仮想メモリから確保される）
 #if SL_ENABLE_ALLOCATION_TRACKER
         template<typename T, typename... Args>
         static T* Allocate(const char* desc, const char* file, uint64 line, Args&& ... args)
         {
-            static_assert(sizeof(T) <= 1024);
+            static_assert(alignof(T) <= 16);
 
             void* ptr = PoolAllocator::Allocate(sizeof(T));
             MemoryTracker::RecordAllocate(ptr, sizeof(T), desc, file, line);
@@ -222,15 +345,35 @@ namespace Silex
 
             PoolAllocator::Deallocate((void*)ptr);
         }
+
+        template<typename T>
+        static T* AllocateArray(const char* desc, const char* file, uint64 line, uint64 count)
+        {
+            static_assert(alignof(T) <= arrayHeaderByteSize);
+
+            void* ptr = PoolAllocator::Allocate(arrayHeaderByteSize + sizeof(T) * count);
+            MemoryTracker::RecordAllocate(ptr, arrayHeaderByteSize + sizeof(T) * count, desc, file, line);
+
+            return _ConstructArray<T>(ptr, count);
+        }
+
+        template<typename T>
+        static void DeallocateArray(T* ptr)
+        {
+            void* block = _DestructArray(ptr);
+            MemoryTracker::RecordDeallocate(block);
+
+            PoolAllocator::Deallocate(block);
+        }
 #else
         template<typename T, typename... Args>
         static T* Allocate(Args&& ... args)
         {
-            static_assert(sizeof(T) <= 1024);
+            static_assert(alignof(T) <= 16);
 
             void* ptr = PoolAllocator::Allocate(sizeof(T));
             return Memory::Construct<T>(ptr, Traits::Forward<Args>(args)...);
-    }
+        }
 
         template<typename T>
         static void Deallocate(T* ptr)
@@ -238,7 +381,51 @@ namespace Silex
             Memory::Destruct(ptr);
             PoolAllocator::Deallocate((void*)ptr);
         }
+
+        template<typename T>
+        static T* AllocateArray(uint64 count)
+        {
+            static_assert(alignof(T) <= arrayHeaderByteSize);
+
+            void* ptr = PoolAllocator::Allocate(arrayHeaderByteSize + sizeof(T) * count);
+            return _ConstructArray<T>(ptr, count);
+        }
+
+        template<typename T>
+        static void DeallocateArray(T* ptr)
+        {
+            PoolAllocator::Deallocate(_DestructArray(ptr));
+        }
 #endif
+
+    private:
+
+        // 配列の先頭に要素数を格納する領域（要素のアライメントを保つため 16 byte）
+        static constexpr uint64 arrayHeaderByteSize = 16;
+
+        template<typename T>
+        static T* _ConstructArray(void* block, uint64 count)
+        {
+            *static_cast<uint64*>(block) = count;
+
+            T* elements = reinterpret_cast<T*>(static_cast<byte*>(block) + arrayHeaderByteSize);
+            for (uint64 i = 0; i < count; i++)
+            {
+                Memory::Construct<T>(elements + i);
+            }
+
+            return elements;
+        }
+
+        template<typename T>
+        static void* _DestructArray(T* elements)
+        {
+            void*  block = reinterpret_cast<byte*>(elements) - arrayHeaderByteSize;
+            uint64 count = *static_cast<uint64*>(block);
+
+            std::destroy_n(elements, count);
+            return block;
+        }
     };
 
 
@@ -290,133 +477,290 @@ namespace Silex
 
 
 
+    //=================================================
+    // リソースハンドル（インデックス + 世代）
+    //-------------------------------------------------
+    // 要素が解放されると世代が進むので、解放済みの要素を指すハンドルは O(1) で検出できる
+    // 世代 0 は無効なハンドルを表す
+    //=================================================
     template<class T>
     struct ResourceHandle
     {
-        uint64 id;
-        T*     ptr;
+        uint32 index      = 0;
+        uint32 generation = 0;
+
+        bool IsNull() const { return generation == 0; }
+
+        bool operator==(const ResourceHandle&) const = default;
     };
 
     //=================================================
-    // ポインタと検索用ID ハンドルを返すアロケータ
-    // TODO: 解放された ID に対するバリデーションが必要
+    // 世代付きハンドルを返すアロケータ
+    //-------------------------------------------------
+    // ・要素はチャンク単位で確保し、解放まで移動しない（ポインタを保持しても安全）
+    // ・生存中の要素のインデックスを密な配列で保持し、ForEach で生存要素のみを走査する
+    // ・THREAD_SAFE を指定すると、確保・解放・走査をスピンロックで保護する
+    //   （IsValid / GetData はロックを取らないので、解放と並行する場合は呼び出し側で寿命を保証すること）
+    // ・要素の構築・破棄はロック下で行うので、T のコンストラクタ・デストラクタから同じストレージを操作してはならない
     //=================================================
-    template<typename T, uint64 CHUNCK_ELEMENT = 65535>
+    template<typename T, bool THREAD_SAFE = false, uint32 CHUNK_ELEMENT = 256>
     class ResourceStorage
     {
+        static_assert(std::has_single_bit(CHUNK_ELEMENT), "チャンクの要素数は2の累乗である必要があります");
+
     public:
 
-        ResourceStorage()
-        {
-            elements_in_chunk = sizeof(T) > CHUNCK_ELEMENT? 1 : (CHUNCK_ELEMENT / sizeof(T));
-        }
+        using Handle = ResourceHandle<T>;
+
+        static constexpr uint32 maxChunks   = 256;
+        static constexpr uint32 maxElements = maxChunks * CHUNK_ELEMENT;
+
+    public:
+
+        ResourceStorage() = default;
 
         ~ResourceStorage()
         {
-            if (alloc_count)
+            for (uint32 index : dense)
             {
-                for (uint64 i = 0; i < max_alloc; i++)
-                {
-                    chunks[i / elements_in_chunk][i % elements_in_chunk].~T();
-                }
+                std::destroy_at(_GetNode(index)->Get());
             }
 
-            uint32 chunk_count = max_alloc / elements_in_chunk;
-            for (uint32 i = 0; i < chunk_count; i++)
+            for (uint32 i = 0; i < numChunks; i++)
             {
-                std::free(chunks[i]);
-                std::free(free_list_indices[i]);
+                std::free(chunks[i].load(std::memory_order_relaxed));
             }
+        }
 
-            if (chunks)
-            {
-                std::free(chunks);
-                std::free(free_list_indices);
-            }
+        ResourceStorage(const ResourceStorage&)            = delete;
+        ResourceStorage& operator=(const ResourceStorage&) = delete;
+
+        template<typename... Args>
+        Handle Allocate(Args&& ... args)
+        {
+            // 空きリストからの取り出し・構築・密な配列への公開を1回のロックで行う
+            // （構築中の要素を ForEach が走査したり、他のスレッドが同じ要素を取り出すことはない）
+            if constexpr (THREAD_SAFE) spinLock.lock();
+
+            // 空きがなければチャンクを追加する（追加したインデックスは空きリストに積む）
+            if (freeHead == invalidIndex) SL_UNLIKELY
+                _AddChunk();
+
+            const uint32 index = freeHead;
+            Node*        node  = _GetNode(index);
+
+            freeHead = node->nextFree;
+
+            const uint32 generation = node->generation.load(std::memory_order_relaxed);
+
+            std::construct_at(node->Get(), Traits::Forward<Args>(args)...);
+
+            node->denseSlot = (uint32)dense.size();
+            dense.push_back(index);
+
+            if constexpr (THREAD_SAFE) spinLock.unlock();
+
+            return { index, generation };
         }
 
-        ResourceHandle<T> Allocate(const T& value)
+        void Deallocate(Handle handle)
         {
-            uint32 id  = _AllocateID();
-            T* pointer = _GetPointer(id);
+            SL_ASSERT(IsValid(handle));
+            _Deallocate(handle.index);
+        }
 
-            std::construct_at(pointer, value);
+        // ポインタで確保・解放する（ハンドルを保持しない利用者向け）
+        // 解放済み・他から確保したポインタの解放は、アサートで検出される
+        template<typename... Args>
+        T* New(Args&& ... args)
+        {
+            return _GetNode(Allocate(Traits::Forward<Args>(args)...).index)->Get();
+        }
 
-            return { id, pointer };
+        void Delete(T* pointer)
+        {
+            SL_ASSERT(Contains(pointer));
+            _Deallocate(_GetNode(pointer)->index);
         }
 
-        void Deallocate(ResourceHandle<T> handle)
+        bool IsValid(Handle handle) const
         {
-            _Deallocate(handle.id);
+            if (handle.IsNull() || handle.index >= numAllocated.load(std::memory_order_acquire))
+                return false;
+
+            return _GetNode(handle.index)->generation.load(std::memory_order_acquire) == handle.generation;
         }
 
-        T* GetData(ResourceHandle<T> handle)
+        // 解放済みのハンドルには nullptr を返す
+        T* GetData(Handle handle) const
         {
-            return _GetPointer(handle.id);
+            return IsValid(handle) ? _GetNode(handle.index)->Get() : nullptr;
         }
 
-    private:
+        // このストレージから確保され、まだ解放されていない要素か
+        bool Contains(const T* pointer) const
+        {
+            // 他から確保したポインタのノードには触れないように、先にチャンクの範囲内かを確認する
+            if (!_IsInChunk(pointer))
+                return false;
+
+            const Node* node = _GetNode(pointer);
+
+            // denseSlot は他の要素の解放時に書き換わるので、ロック下で読む
+            if constexpr (THREAD_SAFE) spinLock.lock();
+
+            const bool contains = node->generation.load(std::memory_order_acquire) != 0 && node->denseSlot != invalidIndex;
+
+            if constexpr (THREAD_SAFE) spinLock.unlock();
+
+            return contains;
+        }
 
-        uint32 _AllocateID()
+        Handle GetHandle(const T* pointer) const
         {
-            if (alloc_count == max_alloc) SL_UNLIKELY
+            const Node* node = _GetNode(pointer);
+            return { node->index, node->generation.load(std::memory_order_acquire) };
+        }
+
+        // 生存中の要素を密な配列の順に走査する
+        template<typename Func>
+        void ForEach(Func&& func)
+        {
+            if constexpr (THREAD_SAFE) spinLock.lock();
+
+            for (uint32 index : dense)
             {
-                uint32 chunk_count = alloc_count == 0? 0 : (max_alloc / elements_in_chunk);
+                func(*_GetNode(index)->Get());
+            }
 
-                chunks              = (T**)std::realloc(chunks, sizeof(T*) * (chunk_count + 1));
-                chunks[chunk_count] = (T* )std::malloc(sizeof(T) * elements_in_chunk);
+            if constexpr (THREAD_SAFE) spinLock.unlock();
+        }
 
-                free_list_indices              = (uint32**)std::realloc(free_list_indices, sizeof(uint32*) * (chunk_count + 1));
-                free_list_indices[chunk_count] = (uint32* )std::malloc(sizeof(uint32) * elements_in_chunk);
+        uint32 GetCount() const
+        {
+            if constexpr (THREAD_SAFE) spinLock.lock();
 
-                for (uint32 i = 0; i < elements_in_chunk; i++)
-                {
-                    free_list_indices[chunk_count][i] = alloc_count + i;
-                }
+            const uint32 count = (uint32)dense.size();
 
-                max_alloc += elements_in_chunk;
-            }
+            if constexpr (THREAD_SAFE) spinLock.unlock();
+
+            return count;
+        }
+
+    private:
+
+        static constexpr uint32 invalidIndex = UINT32_MAX;
+        static constexpr uint32 chunkShift   = std::countr_zero(CHUNK_ELEMENT);
+        static constexpr uint32 chunkMask    = CHUNK_ELEMENT - 1;
+
+        struct Node
+        {
+            std::atomic<uint32> generation;
+            uint32              index;
+            uint32              denseSlot; // 解放中は invalidIndex
+            uint32              nextFree;
+
+            alignas(T) byte storage[sizeof(T)];
+
+            T*       Get()       { return reinterpret_cast<T*>(storage);       }
+            const T* Get() const { return reinterpret_cast<const T*>(storage); }
+        };
+
+        Node* _GetNode(uint32 index) const
+        {
+            return &chunks[index >> chunkShift].load(std::memory_order_acquire)[index & chunkMask];
+        }
+
+        static Node* _GetNode(const T* pointer)
+        {
+            return reinterpret_cast<Node*>((byte*)pointer - offsetof(Node, storage));
+        }
 
-            uint32 free_index   = free_list_indices[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
-            uint32 free_chunk   = free_index / elements_in_chunk;
-            uint32 free_element = free_index % elements_in_chunk;
+        // いずれかのチャンク内の要素の先頭を指しているか（チャンクは追加のみなので、ロックは不要）
+        bool _IsInChunk(const T* pointer) const
+        {
+            const uintptr_t address  = reinterpret_cast<uintptr_t>(pointer);
+            const uint32    numChunk = numAllocated.load(std::memory_order_acquire) >> chunkShift;
 
-            alloc_count++;
+            for (uint32 i = 0; i < numChunk; i++)
+            {
+                const uintptr_t begin = reinterpret_cast<uintptr_t>(chunks[i].load(std::memory_order_acquire)) + offsetof(Node, storage);
+                const uintptr_t end   = begin + sizeof(Node) * CHUNK_ELEMENT;
 
-            return free_index;
+                if (address >= begin && address < end)
+                    return (address - begin) % sizeof(Node) == 0;
+            }
+
+            return false;
         }
 
-        void _Deallocate(uint32 id)
+        void _Deallocate(uint32 index)
         {
-            alloc_count--;
+            Node* node = _GetNode(index);
+
+            // 走査対象からの除外・破棄・空きリストへの返却を1回のロックで行う
+            // （破棄前の要素が再確保されたり、破棄中の要素を ForEach が走査することはない）
+            if constexpr (THREAD_SAFE) spinLock.lock();
+
+            // 解放済みの要素の二重解放
+            SL_ASSERT(node->denseSlot != invalidIndex);
+
+            // 世代を進めて、既存のハンドルを無効にする（0 は無効値なので飛ばす）
+            uint32 generation = node->generation.load(std::memory_order_relaxed) + 1;
+            node->generation.store(generation == 0 ? 1 : generation, std::memory_order_release);
+
+            // 密な配列の末尾と入れ替えて詰める（以降 ForEach の走査対象から外れる）
+            const uint32 slot = node->denseSlot;
+            const uint32 last = dense.back();
+
+            dense[slot]                = last;
+            _GetNode(last)->denseSlot = slot;
+            dense.pop_back();
 
-            uint32 chunk   = id / elements_in_chunk;
-            uint32 element = id % elements_in_chunk;
+            node->denseSlot = invalidIndex;
 
-            // デストラクタ
-            std::destroy_at(&chunks[chunk][element]);
+            std::destroy_at(node->Get());
 
-            // 破棄されたインデックスを、次の割り当て時に使用できるインデックスとして割り当てる
-            free_list_indices[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = id;
+            node->nextFree = freeHead;
+            freeHead       = index;
+
+            if constexpr (THREAD_SAFE) spinLock.unlock();
         }
 
-        T* _GetPointer(uint32 id)
+        void _AddChunk()
         {
-            uint32 free_chunk   = id / elements_in_chunk;
-            uint32 free_element = id % elements_in_chunk;
+            SL_ASSERT(numChunks < maxChunks);
+
+            Node*        chunk = (Node*)std::malloc(sizeof(Node) * CHUNK_ELEMENT);
+            const uint32 base  = numChunks << chunkShift;
+
+            // 先頭のインデックスから割り当てられるように、逆順に空きリストへ積む
+            for (uint32 i = CHUNK_ELEMENT; i > 0; i--)
+            {
+                Node* node = &chunk[i - 1];
+                std::construct_at(&node->generation, 1u);
+                node->index     = base + i - 1;
+                node->denseSlot = invalidIndex;
+                node->nextFree  = freeHead;
+                freeHead        = node->index;
+            }
 
-            return &chunks[free_chunk][free_element];
+            chunks[numChunks].store(chunk, std::memory_order_release);
+            numChunks++;
+
+            numAllocated.store(numChunks << chunkShift, std::memory_order_release);
         }
 
     private:
 
-        T**      chunks            = nullptr;
-        uint32** free_list_indices = nullptr;
+        std::array<std::atomic<Node*>, maxChunks> chunks = {};
+        std::vector<uint32>                       dense;
 
-        uint32 max_alloc   = 0;
-        uint32 alloc_count = 0;
+        uint32              numChunks    = 0;
+        uint32              freeHead     = invalidIndex;
+        std::atomic<uint32> numAllocated = 0;
 
-        uint32 elements_in_chunk;
+        SpinLock spinLock;
     };
 
 
@@ -500,7 +844,7 @@ namespace Silex
         {
             if (!p_allow_unfreed || !std::is_trivially_destructible_v<T>)
             {
-                SL_ASSERT(num_free < num_page * page_size);
+                SL_ASSERT(num_free == num_page * page_size);
             }
 
             if (num_page)
@@ -578,4 +922,250 @@ namespace Silex
             if constexpr (THREAD_SAFE) spin_lock.unlock();
         }
     };
+
+
+    //===============================================================
+    // スレッドキャッシュ付きページアロケーター
+    //---------------------------------------------------------------
+    // ・スレッドごとにヒープ（空きリストとページ）を持ち、同一スレッドでの確保・解放はロックを取らない
+    // ・他スレッドで確保された要素の解放は、所有ヒープのリモート解放キュー（MPSC スタック）へ積む
+    //   所有スレッドは空きリストが尽きた時に、キューを丸ごと取り出して再利用する
+    // ・スレッド終了時にヒープは放棄され、次に新しく確保を行うスレッドが引き継ぐ
+    // ・アロケーターは、使用する全てのスレッドより長く生存すること
+    // ・ヒープ・ページは Memory を経由せず malloc で確保する（静的変数として Memory::Finalize 後に破棄されてもよい）
+    //===============================================================
+    template <typename T, uint32 PAGE_ELEMENT = 256>
+    class ConcurrentPagedAllocator
+    {
+        static_assert(alignof(T) <= 16, "ページは malloc で確保するので、16 バイトを超えるアライメントは未対応です");
+        static_assert(PAGE_ELEMENT > 0);
+
+        struct Heap;
+
+        struct Slot
+        {
+            Heap* heap;
+
+            // 空きスロットの間はリンクとして使用する
+            union
+            {
+                Slot* next;
+                alignas(T) byte storage[sizeof(T)];
+            };
+        };
+
+        struct Heap
+        {
+            // 所有スレッドのみがアクセスする
+            Slot*                                       localFree = nullptr;
+            std::vector<Slot*, DefaultAllocator<Slot*>> pages;
+
+            // 他スレッドからも書き込まれるので、所有スレッド側の変数とキャッシュラインを分ける
+            byte padding[64];
+
+            std::atomic<Slot*> remoteFree = nullptr;
+            std::atomic<bool>  inUse      = false;
+            Heap*              next       = nullptr;
+        };
+
+        // スレッドが使用中のヒープ（アロケーターごと）
+        struct ThreadHeaps
+        {
+            struct Entry
+            {
+                uint64 allocatorID;
+                Heap*  heap;
+            };
+
+            std::vector<Entry, DefaultAllocator<Entry>> entries;
+
+            ThreadHeaps() { alive = true; }
+
+            ~ThreadHeaps()
+            {
+                for (Entry& entry : entries)
+                    entry.heap->inUse.store(false, std::memory_order_release);
+
+                alive = false;
+            }
+        };
+
+        inline static thread_local ThreadHeaps threadHeaps;
+        inline static thread_local bool        alive = false; // トリビアル型なので、ThreadHeaps 破棄後も参照できる
+
+        inline static std::atomic<uint64> nextAllocatorID = 1;
+
+    public:
+
+        ConcurrentPagedAllocator()
+            : allocatorID(nextAllocatorID.fetch_add(1, std::memory_order_relaxed))
+        {
+        }
+
+        ~ConcurrentPagedAllocator()
+        {
+            // 生成したスレッドで破棄されることが多いので、このスレッドの登録だけは解除しておく
+            if (alive)
+            {
+                auto& entries = threadHeaps.entries;
+                std::erase_if(entries, [this](const auto& entry) { return entry.allocatorID == allocatorID; });
+            }
+
+            uint64 numFree = 0;
+            for (Heap* heap = heaps.load(std::memory_order_acquire); heap; heap = heap->next)
+            {
+                for (Slot* slot = heap->localFree; slot; slot = slot->next)
+                    numFree++;
+
+                for (Slot* slot = heap->remoteFree.load(std::memory_order_acquire); slot; slot = slot->next)
+                    numFree++;
+            }
+
+            bool leaked = numFree < (uint64)numPages.load(std::memory_order_relaxed) * PAGE_ELEMENT;
+            if (leaked)
+            {
+                // メモリリーク: 解放されていない要素がヒープを参照しているので、ページもヒープも破棄しない
+                return;
+            }
+
+            Heap* heap = heaps.load(std::memory_order_acquire);
+            while (heap)
+            {
+                Heap* next = heap->next;
+
+                for (Slot* page : heap->pages)
+                    std::free(page);
+
+                std::destroy_at(heap);
+                std::free(heap);
+                heap = next;
+            }
+        }
+
+        ConcurrentPagedAllocator(const ConcurrentPagedAllocator&)            = delete;
+        ConcurrentPagedAllocator& operator=(const ConcurrentPagedAllocator&) = delete;
+
+        template <typename... Args>
+        T* Alloc(Args&&... args)
+        {
+            Heap* heap = _FindHeap();
+            if (!heap) SL_UNLIKELY
+                heap = _AcquireHeap();
+
+            Slot* slot = heap->localFree;
+            if (!slot) SL_UNLIKELY
+                slot = _Refill(heap);
+
+            heap->localFree = slot->next;
+
+            return std::construct_at(reinterpret_cast<T*>(slot->storage), Traits::Forward<Args>(args)...);
+        }
+
+        void Free(T* ptr)
+        {
+            std::destroy_at(ptr);
+
+            Slot* slot = reinterpret_cast<Slot*>(reinterpret_cast<byte*>(ptr) - offsetof(Slot, storage));
+            Heap* heap = slot->heap;
+
+            // 自スレッドのヒープなら、空きリストに戻すだけ
+            if (heap == _FindHeap()) SL_LIKELY
+            {
+                slot->next      = heap->localFree;
+                heap->localFree = slot;
+                return;
+            }
+
+            // 他スレッドのヒープなら、リモート解放キューに積む
+            // 取り出し側は常にリスト全体を取り出すので、ABA 問題は発生しない
+            Slot* head = heap->remoteFree.load(std::memory_order_relaxed);
+            do
+            {
+                slot->next = head;
+
+            } while (!heap->remoteFree.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // 確保済みページ数（全スレッド合計）
+        uint32 GetPageCount() const
+        {
+            return numPages.load(std::memory_order_relaxed);
+        }
+
+    private:
+
+        Heap* _FindHeap() const
+        {
+            for (const auto& entry : threadHeaps.entries)
+            {
+                if (entry.allocatorID == allocatorID)
+                    return entry.heap;
+            }
+
+            return nullptr;
+        }
+
+        Heap* _AcquireHeap()
+        {
+            Heap* heap = nullptr;
+
+            // 終了したスレッドが放棄したヒープがあれば引き継ぐ
+            for (Heap* h = heaps.load(std::memory_order_acquire); h; h = h->next)
+            {
+                bool expected = false;
+                if (h->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    heap = h;
+                    break;
+                }
+            }
+
+            if (!heap)
+            {
+                heap = std::construct_at((Heap*)std::malloc(sizeof(Heap)));
+                heap->inUse.store(true, std::memory_order_relaxed);
+
+                // ヒープリストは追加のみ（アロケーター破棄まで削除しない）
+                Heap* head = heaps.load(std::memory_order_relaxed);
+                do
+                {
+                    heap->next = head;
+
+                } while (!heaps.compare_exchange_weak(head, heap, std::memory_order_release, std::memory_order_relaxed));
+            }
+
+            threadHeaps.entries.push_back({ allocatorID, heap });
+            return heap;
+        }
+
+        Slot* _Refill(Heap* heap)
+        {
+            // 他スレッドが解放した要素をまとめて回収する
+            Slot* list = heap->remoteFree.exchange(nullptr, std::memory_order_acquire);
+            if (list)
+                return list;
+
+            // 回収できるものが無ければ、新しいページを確保する
+            Slot* page = (Slot*)std::malloc(sizeof(Slot) * PAGE_ELEMENT);
+            if (!page) SL_UNLIKELY
+                throw std::bad_alloc();
+
+            for (uint32 i = 0; i < PAGE_ELEMENT; i++)
+            {
+                page[i].heap = heap;
+                page[i].next = (i + 1 < PAGE_ELEMENT) ? &page[i + 1] : nullptr;
+            }
+
+            heap->pages.push_back(page);
+            numPages.fetch_add(1, std::memory_order_relaxed);
+
+            return page;
+        }
+
+    private:
+
+        const uint64        allocatorID;
+        std::atomic<Heap*>  heaps    = nullptr;
+        std::atomic<uint32> numPages = 0;
+    };
 }
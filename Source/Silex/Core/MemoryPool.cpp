@@ -4,6 +4,12 @@
 #include "Core/MemoryPool.h"
 #include "Core/Memory.h"
 
+#include <bit>
+
+#ifndef SL_PLATFORM_WINDOWS
+#include <sys/mman.h>
+#endif
+
 
 namespace Silex
 {
@@ -43,6 +49,8 @@ namespace Silex
         // m_BlockSize[3] ==  256
         // m_BlockSize[4] ==  512
         // m_BlockSize[5] == 1024
+        //      ...
+        // m_BlockSize[13] == 256KB
 
         //template<class Size>
         //static constexpr uint32 SelectPoolIndexFromSize(Size requestByteSize)
@@ -59,8 +67,10 @@ namespace Silex
 
         //====================================================
         // if分岐の方がパフォーマンスが良かったので、ビット操作を行わない
+        // （頻度の低い 1024 byte を超えるサイズのみ、ビット幅から求める）
+        // ※ AllocatorBenchmark の select_pool_index で、ビット走査版と比較できる
         //====================================================
-        static uint32 SelectPoolIndex(uint32 requestByteSize)
+        static uint32 SelectPoolIndex(uint64 requestByteSize)
         {
             if      (  1 <= requestByteSize && requestByteSize <=   32) { return 0; }
             else if ( 33 <= requestByteSize && requestByteSize <=   64) { return 1; }
@@ -68,45 +78,332 @@ namespace Silex
             else if (129 <= requestByteSize && requestByteSize <=  256) { return 3; }
             else if (257 <= requestByteSize && requestByteSize <=  512) { return 4; }
             else if (513 <= requestByteSize && requestByteSize <= 1024) { return 5; }
+            else if (requestByteSize > 1024)                            { return (uint32)std::bit_width(requestByteSize - 1) - 5; }
 
             return 0;
         }
+
+        //====================================================
+        // 仮想メモリ（巨大確保用）
+        //====================================================
+        static constexpr uint64 virtualPageByteSize = 4096;
+
+        static void* AllocateVirtualMemory(uint64 size)
+        {
+#ifdef SL_PLATFORM_WINDOWS
+            return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+            void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+        }
+
+        static void FreeVirtualMemory(void* ptr, uint64 size)
+        {
+#ifdef SL_PLATFORM_WINDOWS
+            VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+            munmap(ptr, size);
+#endif
+        }
+
+        // アクセスすると例外が発生するようにする
+        static void ProtectVirtualMemory(void* ptr, uint64 size)
+        {
+#ifdef SL_PLATFORM_WINDOWS
+            DWORD oldProtect;
+            VirtualProtect(ptr, size, PAGE_NOACCESS, &oldProtect);
+#else
+            mprotect(ptr, size, PROT_NONE);
+#endif
+        }
     }
 
 
     //============================================================================
     // プールデータ
     //============================================================================
-    void MemoryPool::Pool::Create(const uint32 chunkSize, const uint32 poolSize)
+
+    // マガジンの最大容量（サイズクラスごとの上限は Pool::magazineLimit）
+    static constexpr uint32 magazineCapacity = 64;
+
+    // ページの最小バイトサイズ（ページヘッダーを含む）
+    static constexpr uint32 minPageByteSize = 64 * 1024;
+
+    // 1ページに配置する最小ブロック数（大きいサイズクラスのページサイズを決める）
+    static constexpr uint32 minBlocksPerPage = 8;
+
+    // スレッドキャッシュが1サイズクラスに保持するバイト数の目安
+    static constexpr uint32 magazineByteSize = 256 * 1024;
+
+    // 即座に解放せずに再利用のために残す、空きページ数
+    static constexpr uint32 maxEmptyPages = 2;
+
+    namespace Internal
     {
-        blockByteSize = chunkSize;
-        numBlocks     = poolSize / blockByteSize;
-        ptr           = Memory::Malloc(poolSize + (numBlocks * sizeof(Header)));
+        template<typename PageType>
+        static void LinkPage(PageType*& list, PageType* page)
+        {
+            page->prev = nullptr;
+            page->next = list;
+
+            if (list)
+                list->prev = page;
 
-        for (uint32 i = 0; i < numBlocks; i++)
+            list = page;
+        }
+
+        template<typename PageType>
+        static void UnlinkPage(PageType*& list, PageType* page)
         {
-            uint64 address = (uint64)ptr + (i * sizeof(Header)) + (i * blockByteSize);
-            PushFront(reinterpret_cast<Header*>(address));
+            if (page->prev) page->prev->next = page->next;
+            else            list             = page->next;
+
+            if (page->next)
+                page->next->prev = page->prev;
+
+            page->prev = nullptr;
+            page->next = nullptr;
         }
     }
 
+    void MemoryPool::Pool::Create(const uint32 index, const uint32 blockSize)
+    {
+        const uint32 blockStride = sizeof(Header) + blockSize;
+        const uint32 pageSize    = std::max<uint32>(minPageByteSize, sizeof(Page) + blockStride * minBlocksPerPage);
+
+        poolIndex     = index;
+        blockByteSize = blockSize;
+        pageByteSize  = (pageSize + minPageByteSize - 1) & ~(minPageByteSize - 1);
+        blocksPerPage = (pageByteSize - sizeof(Page)) / blockStride;
+        magazineLimit = std::clamp<uint32>(magazineByteSize / blockSize, 2, magazineCapacity);
+        numPages      = 0;
+        numEmptyPages = 0;
+
+        SL_ASSERT(blocksPerPage != 0);
+    }
+
     void MemoryPool::Pool::Destroy()
     {
-        Memory::Free(ptr);
-        ptr = nullptr;
+        for (Page** list : { &availablePages, &fullPages })
+        {
+            while (*list)
+            {
+                Page* page = *list;
+                *list = page->next;
+
+                Memory::Destruct(page);
+                Memory::Free(page);
+            }
+        }
+
+        numPages      = 0;
+        numEmptyPages = 0;
     }
 
     MemoryPool::Header* MemoryPool::Pool::PopFront()
     {
-        Header* top = head;
-        head = head->next;
+        // 空きブロックがなければ、ページを追加する
+        if (!availablePages) SL_UNLIKELY
+            _Grow();
+
+        Page*   page = availablePages;
+        Header* top  = page->freeList;
+
+        page->freeList = top->next;
+
+        if (page->numUsed++ == 0)
+            numEmptyPages--;
+
+        // ページが満杯になった
+        if (!page->freeList)
+        {
+            Internal::UnlinkPage(availablePages, page);
+            Internal::LinkPage(fullPages, page);
+        }
+
         return top;
     }
 
     void MemoryPool::Pool::PushFront(Header* header)
     {
-        header->next = head;
-        head = header;
+        Page* page = header->page;
+
+        // 満杯だったページに空きができた
+        if (!page->freeList)
+        {
+            Internal::UnlinkPage(fullPages, page);
+            Internal::LinkPage(availablePages, page);
+        }
+
+        header->next   = page->freeList;
+        page->freeList = header;
+
+        if (--page->numUsed == 0)
+        {
+            numEmptyPages++;
+
+            if (numEmptyPages > maxEmptyPages)
+                _ReleasePage(page);
+        }
+    }
+
+    void MemoryPool::Pool::Trim(uint32 keepPages)
+    {
+        Page* page = availablePages;
+        while (page && numEmptyPages > keepPages)
+        {
+            Page* next = page->next;
+
+            if (page->numUsed == 0)
+                _ReleasePage(page);
+
+            page = next;
+        }
+    }
+
+    void MemoryPool::Pool::_Grow()
+    {
+        void* memory = Memory::Malloc(pageByteSize);
+        SL_ASSERT(memory != nullptr);
+
+        Page* page = Memory::Construct<Page>(memory);
+        page->poolIndex = poolIndex;
+
+        // ページヘッダーの直後にブロックを並べる（先頭のブロックから払い出されるように逆順に積む）
+        const uint64 blockStride = sizeof(Header) + blockByteSize;
+        const uint64 firstBlock  = (uint64)memory + sizeof(Page);
+
+        for (uint32 i = blocksPerPage; i > 0; i--)
+        {
+            Header* header = reinterpret_cast<Header*>(firstBlock + (i - 1) * blockStride);
+            header->page   = page;
+            header->next   = page->freeList;
+            page->freeList = header;
+        }
+
+        Internal::LinkPage(availablePages, page);
+
+        numPages++;
+        numEmptyPages++;
+    }
+
+    void MemoryPool::Pool::_ReleasePage(Page* page)
+    {
+        SL_ASSERT(page->numUsed == 0);
+
+        Internal::UnlinkPage(availablePages, page);
+
+        Memory::Destruct(page);
+        Memory::Free(page);
+
+        numPages--;
+        numEmptyPages--;
+    }
+
+
+    //============================================================================
+    // スレッドキャッシュ
+    //============================================================================
+
+    struct MemoryPool::ThreadCache
+    {
+        struct Magazine
+        {
+            uint32  count = 0;
+            Header* blocks[magazineCapacity];
+        };
+
+        MemoryPool*                                    owner = nullptr;
+        std::array<Magazine, numSizeClass>             magazines;
+        std::array<std::atomic<int64>, numSizeClass>   allocated = {};
+
+        // このスレッドのみが書き込むので、アトミックな読み書きのみで加算する
+        void AddAllocated(uint32 index, int64 size)
+        {
+            allocated[index].store(allocated[index].load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+        }
+
+        ~ThreadCache()
+        {
+            // スレッド終了時: 保持しているブロックと統計をデポに返却する
+            if (owner)
+                owner->_UnregisterThreadCache(this);
+        }
+    };
+
+    thread_local MemoryPool::ThreadCache MemoryPool::threadCache;
+
+
+    MemoryPool::ThreadCache* MemoryPool::_GetThreadCache()
+    {
+        ThreadCache* cache = &threadCache;
+
+        if (cache->owner == this) SL_LIKELY
+            return cache;
+
+        // 初回はこのプールに登録する（別のプールに登録済みのスレッドは、デポから直接確保する）
+        if (cache->owner == nullptr)
+        {
+            _RegisterThreadCache(cache);
+            return cache;
+        }
+
+        return nullptr;
+    }
+
+    void MemoryPool::_RegisterThreadCache(ThreadCache* cache)
+    {
+        std::lock_guard<std::mutex> lock(threadCacheMutex);
+
+        cache->owner = this;
+        threadCaches.push_back(cache);
+    }
+
+    void MemoryPool::_UnregisterThreadCache(ThreadCache* cache)
+    {
+        // Finalize と競合した場合は、既に登録解除されているので何もしない
+        std::lock_guard<std::mutex> lock(threadCacheMutex);
+        if (cache->owner != this)
+            return;
+
+        for (uint32 i = 0; i < numSizeClass; i++)
+        {
+            _Flush(i, cache, cache->magazines[i].count);
+            retiredAllocated[i] += cache->allocated[i].load(std::memory_order_relaxed);
+        }
+
+        std::erase(threadCaches, cache);
+        cache->owner = nullptr;
+    }
+
+    void MemoryPool::_Refill(uint32 index, ThreadCache* cache)
+    {
+        ThreadCache::Magazine& magazine = cache->magazines[index];
+
+        std::lock_guard<std::mutex> lock(poolMutex[index]);
+
+        // デポが空の場合は、PopFront 内でページが追加される
+        Pool& pool = pools[index];
+        while (magazine.count < pool.magazineLimit / 2)
+        {
+            magazine.blocks[magazine.count++] = pool.PopFront();
+        }
+    }
+
+    void MemoryPool::_Flush(uint32 index, ThreadCache* cache, uint32 count)
+    {
+        ThreadCache::Magazine& magazine = cache->magazines[index];
+        if (count == 0)
+            return;
+
+        std::lock_guard<std::mutex> lock(poolMutex[index]);
+
+        Pool& pool = pools[index];
+        for (uint32 i = 0; i < count; i++)
+        {
+            pool.PushFront(magazine.blocks[--magazine.count]);
+        }
     }
 
 
@@ -115,36 +412,86 @@ namespace Silex
     //============================================================================
     void MemoryPool::Initialize()
     {
-        const uint64 minPoolBlockByteSize = 32;
-        const uint64 poolByteSize         = 10 * 1024 * 1024;
-
+        // ページは最初の確保時に追加されるので、ここではメモリを確保しない
         for (uint32 i = 0; i < pools.size(); i++)
         {
-            uint64 blockSize = minPoolBlockByteSize << i;
-            pools[i].Create(blockSize, poolByteSize);
-
-            status[i] = MemoryPoolStatus(blockSize, 0, poolByteSize);
+            pools[i].Create(i, (uint32)(minBlockByteSize << i));
+            retiredAllocated[i] = 0;
         }
     }
 
     void MemoryPool::Finalize()
     {
+        {
+            // プールごと解放されるので、登録済みキャッシュのブロックは返却せずに破棄する
+            std::lock_guard<std::mutex> lock(threadCacheMutex);
+
+            for (ThreadCache* cache : threadCaches)
+            {
+                cache->owner = nullptr;
+
+                for (uint32 i = 0; i < numSizeClass; i++)
+                {
+                    cache->magazines[i].count = 0;
+                    cache->allocated[i].store(0, std::memory_order_relaxed);
+                }
+            }
+
+            threadCaches.clear();
+        }
+
         for (uint32 i = 0; i < pools.size(); i++)
         {
             pools[i].Destroy();
         }
+
+        // 解放されていない巨大確保
+        std::lock_guard<std::mutex> lock(hugeMutex);
+
+        while (hugePages)
+        {
+            HugePage* page = static_cast<HugePage*>(hugePages);
+            hugePages = page->next;
+
+            Internal::FreeVirtualMemory(page, page->regionByteSize);
+        }
+
+        hugeAllocatedBytes = 0;
+        hugeReservedBytes  = 0;
     }
 
     void* MemoryPool::Allocate(const uint64 allocationSize)
     {
+        if (allocationSize > maxBlockByteSize) SL_UNLIKELY
+            return _AllocateHuge(allocationSize);
+
         // バイトサイズからプールを選択
-        uint32 index = Internal::SelectPoolIndex(allocationSize);
+        uint32  index  = Internal::SelectPoolIndex(allocationSize);
+        Header* header = nullptr;
 
-        // ヘッダーにプールインデックスを格納
-        Header* header = pools[index].PopFront();
-        header->blockIndex = index;
+        if (ThreadCache* cache = _GetThreadCache()) SL_LIKELY
+        {
+            // スレッドキャッシュから確保（空ならデポからまとめて補充）
+            ThreadCache::Magazine& magazine = cache->magazines[index];
+            if (magazine.count == 0) SL_UNLIKELY
+                _Refill(index, cache);
 
-        status[index].totalAllocated += pools[index].blockByteSize;
+            header = magazine.blocks[--magazine.count];
+            cache->AddAllocated(index, pools[index].blockByteSize);
+        }
+        else
+        {
+            {
+                std::lock_guard<std::mutex> lock(poolMutex[index]);
+                header = pools[index].PopFront();
+            }
+
+            // ロック順序（threadCacheMutex → poolMutex）を守るため、プールのロックを解放してから記録する
+            std::lock_guard<std::mutex> lock(threadCacheMutex);
+            retiredAllocated[index] += pools[index].blockByteSize;
+        }
+
+        header->userData = 0;
 
         // ヘッダー分ポインタをずらす
         return ++header;
@@ -156,8 +503,149 @@ namespace Silex
         Header* header = static_cast<Header*>(pointer);
         --header;
 
-        uint32 index = header->blockIndex;
-        pools[index].PushFront(header);
-        status[index].totalAllocated -= pools[index].blockByteSize;
+        uint32 index = header->page->poolIndex;
+
+        if (index == hugePoolIndex) SL_UNLIKELY
+        {
+            _DeallocateHuge(header);
+            return;
+        }
+
+        if (ThreadCache* cache = _GetThreadCache()) SL_LIKELY
+        {
+            // 別スレッドで確保されたブロックも、解放したスレッドのキャッシュに戻す（満杯なら半分をデポへ返却）
+            ThreadCache::Magazine& magazine = cache->magazines[index];
+            const uint32           limit    = pools[index].magazineLimit;
+
+            if (magazine.count >= limit) SL_UNLIKELY
+                _Flush(index, cache, limit / 2);
+
+            magazine.blocks[magazine.count++] = header;
+            cache->AddAllocated(index, -(int64)pools[index].blockByteSize);
+        }
+        else
+        {
+            {
+                std::lock_guard<std::mutex> lock(poolMutex[index]);
+                pools[index].PushFront(header);
+            }
+
+            std::lock_guard<std::mutex> lock(threadCacheMutex);
+            retiredAllocated[index] -= pools[index].blockByteSize;
+        }
+    }
+
+    std::array<MemoryPoolStatus, MemoryPool::numStatus> MemoryPool::GetStatus() const
+    {
+        std::array<MemoryPoolStatus, numStatus> status;
+
+        std::lock_guard<std::mutex> lock(threadCacheMutex);
+
+        for (uint32 i = 0; i < numSizeClass; i++)
+        {
+            int64 allocated = retiredAllocated[i];
+            for (const ThreadCache* cache : threadCaches)
+            {
+                allocated += cache->allocated[i].load(std::memory_order_relaxed);
+            }
+
+            status[i].chunkSize      = pools[i].blockByteSize;
+            status[i].totalAllocated = (uint64)allocated;
+        }
+
+        for (uint32 i = 0; i < numSizeClass; i++)
+        {
+            std::lock_guard<std::mutex> poolLock(poolMutex[i]);
+            status[i].totalSize = (uint64)pools[i].numPages * pools[i].blocksPerPage * pools[i].blockByteSize;
+        }
+
+        {
+            std::lock_guard<std::mutex> hugeLock(hugeMutex);
+
+            MemoryPoolStatus& huge = status[numSizeClass];
+            huge.chunkSize      = 0;
+            huge.totalAllocated = hugeAllocatedBytes;
+            huge.totalSize      = hugeReservedBytes;
+        }
+
+        return status;
+    }
+
+    void MemoryPool::Trim()
+    {
+        for (uint32 i = 0; i < numSizeClass; i++)
+        {
+            std::lock_guard<std::mutex> lock(poolMutex[i]);
+            pools[i].Trim(0);
+        }
+    }
+
+    //============================================================================
+    // 巨大確保
+    //----------------------------------------------------------------------------
+    // [HugePage][...][Header][ブロック][ガードページ（デバッグのみ）]
+    // ブロックを領域の末尾に寄せて配置し、直後のガードページで範囲外への書き込みを検出する
+    //============================================================================
+    void* MemoryPool::_AllocateHuge(uint64 allocationSize)
+    {
+#if SL_DEBUG
+        const uint64 guardByteSize = Internal::virtualPageByteSize;
+#else
+        const uint64 guardByteSize = 0;
+#endif
+        const uint64 blockSize  = (allocationSize + 15) & ~15ull;
+        const uint64 bodySize   = (sizeof(HugePage) + sizeof(Header) + blockSize + Internal::virtualPageByteSize - 1) & ~(Internal::virtualPageByteSize - 1);
+        const uint64 regionSize = bodySize + guardByteSize;
+
+        void* region = Internal::AllocateVirtualMemory(regionSize);
+        SL_ASSERT(region != nullptr);
+
+        if (guardByteSize)
+            Internal::ProtectVirtualMemory((byte*)region + bodySize, guardByteSize);
+
+        HugePage* page = Memory::Construct<HugePage>(region);
+        page->poolIndex      = hugePoolIndex;
+        page->numUsed        = 1;
+        page->regionByteSize = regionSize;
+        page->blockByteSize  = blockSize;
+
+        Header* header = reinterpret_cast<Header*>((byte*)region + bodySize - blockSize) - 1;
+        header->page     = page;
+        header->userData = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(hugeMutex);
+
+            page->next = hugePages;
+            if (hugePages)
+                hugePages->prev = page;
+
+            hugePages = page;
+
+            hugeAllocatedBytes += blockSize;
+            hugeReservedBytes  += regionSize;
+        }
+
+        return ++header;
+    }
+
+    void MemoryPool::_DeallocateHuge(Header* header)
+    {
+        HugePage* page = static_cast<HugePage*>(header->page);
+
+        {
+            std::lock_guard<std::mutex> lock(hugeMutex);
+
+            if (page->prev) page->prev->next = page->next;
+            else            hugePages        = page->next;
+
+            if (page->next)
+                page->next->prev = page->prev;
+
+            hugeAllocatedBytes -= page->blockByteSize;
+            hugeReservedBytes  -= page->regionByteSize;
+        }
+
+        Internal::FreeVirtualMemory(page, page->regionByteSize);
     }
 }
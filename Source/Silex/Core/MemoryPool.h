@@ -1,21 +1,51 @@
-
 #pragma once
 
 #include "Core/CoreType.h"
+#include <array>
+#include <mutex>
+#include <vector>
 
 
 namespace Silex
 {
     struct MemoryPoolStatus
     {
-        uint32 chunkSize      = 0;
-        uint32 totalAllocated = 0;
-        uint32 totalSize      = 0;
+        uint64 chunkSize      = 0; // 巨大確保は 0
+        uint64 totalAllocated = 0;
+        uint64 totalSize      = 0;
     };
 
 
+    //==================================================================
+    // サイズクラス別 メモリープール
+    //------------------------------------------------------------------
+    // 32 byte ～ 256 KB を2の累乗のサイズクラスに分けてプールから確保し
+    // それを超える巨大確保は、OS の仮想メモリから個別に確保する（デバッグビルドでは末尾にガードページを配置）
+    // どの段階で確保したブロックも同じヘッダーを持つので、解放・利用者データは共通で扱える
+    //
+    // 各プールは固定サイズのページを連結して構成し、ブロックが不足すると新しいページを追加する
+    // 全ブロックが空きになったページは、一定数を超えた分を即座に解放し、残りは Trim で解放する
+    //
+    // 各スレッドがサイズクラスごとにブロックのキャッシュ（マガジン）を持ち、確保・解放はキャッシュ内で完結させる
+    // キャッシュが空・満杯になった時のみ、共有プール（デポ）とまとめてブロックを受け渡すので
+    // 複数スレッドから slnew / sldelete を呼び出してもロックの競合はほとんど発生しない
+    //
+    // 統計情報もスレッドごとに記録し、GetStatus 呼び出し時に集計する
+    //==================================================================
     class MemoryPool
     {
+    public:
+
+        static constexpr uint32 numSizeClass     = 14;
+        static constexpr uint64 minBlockByteSize = 32;
+        static constexpr uint64 maxBlockByteSize = minBlockByteSize << (numSizeClass - 1); // 256KB
+
+        // 統計の要素数（最後の要素は巨大確保）
+        static constexpr uint32 numStatus = numSizeClass + 1;
+
+        // 巨大確保のページに設定されるプールインデックス
+        static constexpr uint32 hugePoolIndex = numSizeClass;
+
     public:
 
         MemoryPool()  = default;
@@ -27,33 +57,111 @@ namespace Silex
         void* Allocate(const uint64 allocationSize);
         void  Deallocate(void* pointer);
 
-        const std::array<MemoryPoolStatus, 6>& GetStatus() const { return status; }
+        // 各スレッドの統計を集計して返す
+        std::array<MemoryPoolStatus, numStatus> GetStatus() const;
+
+        // 全ブロックが空きのページを OS へ返却する（スレッドキャッシュが保持するブロックは対象外）
+        void Trim();
+
+        // 確保したブロックに付随する 64bit の利用者データ（確保時に 0 で初期化される）
+        static void   SetUserData(void* pointer, uint64 data) { (static_cast<Header*>(pointer) - 1)->userData = data; }
+        static uint64 GetUserData(const void* pointer)        { return (static_cast<const Header*>(pointer) - 1)->userData; }
 
     private:
 
+        struct Page;
+
+        // next は空きリスト内でのみ使用するので、確保中は利用者データとして使用する
         struct Header
         {
-            uint32  blockIndex;
-            Header* next;
+            Page* page;
+
+            union
+            {
+                Header* next;
+                uint64  userData;
+            };
+        };
+
+        //===========================================
+        // ページ
+        //-------------------------------------------
+        // プールはページ単位で必要に応じて拡張される
+        // ブロックはページ内の空きリストで管理し、ページごとに使用数を記録する
+        //===========================================
+        struct alignas(16) Page
+        {
+            Page*   prev      = nullptr;
+            Page*   next      = nullptr;
+            Header* freeList  = nullptr;
+            uint32  numUsed   = 0;
+            uint32  poolIndex = 0;
+        };
+
+        // 巨大確保の領域（領域の先頭に配置し、ブロックのヘッダーから参照される）
+        struct HugePage : Page
+        {
+            uint64 regionByteSize = 0;
+            uint64 blockByteSize  = 0;
         };
 
         struct Pool
         {
-            Header* head = nullptr;
-            void*   ptr  = nullptr;
+            Page* availablePages = nullptr; // 空きブロックのあるページ
+            Page* fullPages      = nullptr; // 空きブロックのないページ
 
+            uint32 poolIndex     = 0;
             uint32 blockByteSize = 0;
-            uint32 numBlocks     = 0;
+            uint32 pageByteSize  = 0;
+            uint32 blocksPerPage = 0;
+            uint32 numPages      = 0;
+            uint32 numEmptyPages = 0;
 
-            void Create(const uint32 chunkSize, const uint32 poolSize);
+            // スレッドキャッシュに保持するブロック数の上限（大きいブロックほど少なくする）
+            uint32 magazineLimit = 0;
+
+            void Create(const uint32 index, const uint32 blockSize);
             void Destroy();
 
             void    PushFront(Header* header);
             Header* PopFront();
+
+            // 全ブロックが空きのページを解放する（keepPages 分は再利用のために残す）
+            void Trim(uint32 keepPages);
+
+            void _Grow();
+            void _ReleasePage(Page* page);
         };
 
-        std::array<Pool,             6> pools;
-        std::array<MemoryPoolStatus, 6> status;
+        // スレッドキャッシュ（MemoryPool.cpp で定義）
+        struct ThreadCache;
+
+        ThreadCache* _GetThreadCache();
+        void         _Refill(uint32 index, ThreadCache* cache);
+        void         _Flush(uint32 index, ThreadCache* cache, uint32 count);
+        void         _RegisterThreadCache(ThreadCache* cache);
+        void         _UnregisterThreadCache(ThreadCache* cache);
+
+        void* _AllocateHuge(uint64 allocationSize);
+        void  _DeallocateHuge(Header* header);
+
+        // 共有プール（デポ）: サイズクラスごとにロックを分ける
+        std::array<Pool,               numSizeClass> pools;
+        mutable std::array<std::mutex, numSizeClass> poolMutex;
+
+        // 登録済みスレッドキャッシュと、終了したスレッドの統計
+        mutable std::mutex               threadCacheMutex;
+        std::vector<ThreadCache*>        threadCaches;
+        std::array<int64, numSizeClass>  retiredAllocated = {};
+
+        // 巨大確保
+        mutable std::mutex hugeMutex;
+        Page*              hugePages          = nullptr;
+        uint64             hugeAllocatedBytes = 0;
+        uint64             hugeReservedBytes  = 0;
+
+        // 呼び出しスレッドのキャッシュ（最初に使用したプールに登録される）
+        static thread_local ThreadCache threadCache;
 
     private:
 
@@ -0,0 +1,42 @@
+
+#include "PCH.h"
+#include "Core/MemoryResource.h"
+
+
+namespace Silex
+{
+    //===============================================================
+    // ArenaMemoryResource
+    //===============================================================
+    ArenaMemoryResource::ArenaMemoryResource(uint64 blockSize)
+        : allocator(&ownedAllocator)
+    {
+        ownedAllocator.Initialize(blockSize);
+    }
+
+    ArenaMemoryResource::ArenaMemoryResource(LinearAllocator* linearAllocator)
+        : allocator(linearAllocator)
+    {
+        SL_ASSERT(linearAllocator != nullptr);
+    }
+
+    void ArenaMemoryResource::Reset()
+    {
+        allocator->Reset();
+    }
+
+    void* ArenaMemoryResource::do_allocate(size_t bytes, size_t alignment)
+    {
+        return allocator->Allocate(std::max<uint64>(bytes, 1), std::max<uint64>(alignment, LinearAllocator::defaultAlignment));
+    }
+
+    void ArenaMemoryResource::do_deallocate(void* ptr, size_t bytes, size_t alignment)
+    {
+        // 個別には解放しない（Reset で一括解放）
+    }
+
+    bool ArenaMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+}
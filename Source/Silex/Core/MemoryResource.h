@@ -0,0 +1,55 @@
+#pragma once
+#include "Core/Memory.h"
+#include "Core/LinearAllocator.h"
+#include <memory_resource>
+
+
+//==================================================================
+// std::pmr メモリリソース
+//------------------------------------------------------------------
+// エンジンのアロケーターを std::pmr::memory_resource として公開する
+// std::pmr::vector / std::pmr::unordered_map などのコンテナに渡すことで
+// コンテナのコードを変えずに、確保先だけを切り替えられる
+//
+// ※ pmr コンテナはコピー構築時にリソースを引き継がない（既定リソースが使われる）ので
+//    引き継ぐ必要がある場合は、コピー先をリソース指定で構築してから代入すること
+//==================================================================
+namespace Silex
+{
+    //===============================================================
+    // アリーナリソース
+    //---------------------------------------------------------------
+    // LinearAllocator から確保し、個別の解放は行わない（Reset で一括解放）
+    // インポート処理単位のアリーナとして所有するか、フレームアロケーターを参照して使用する
+    //===============================================================
+    class ArenaMemoryResource final : public std::pmr::memory_resource
+    {
+    public:
+
+        // 専用のリニアアロケーターを所有する
+        explicit ArenaMemoryResource(uint64 blockSize = 1024 * 1024); // 1MB
+
+        // 既存のリニアアロケーターを参照する（Reset の管理は所有者に従う）
+        explicit ArenaMemoryResource(LinearAllocator* linearAllocator);
+
+        ArenaMemoryResource(const ArenaMemoryResource&)            = delete;
+        ArenaMemoryResource& operator=(const ArenaMemoryResource&) = delete;
+
+        // 確保済みの全てのメモリを破棄する（このリソースを使用するコンテナは事前に破棄すること）
+        void Reset();
+
+        uint64 GetUsedSize() const { return allocator->GetUsedSize(); }
+        uint64 GetCapacity() const { return allocator->GetCapacity(); }
+
+    protected:
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void  do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+        bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+
+        LinearAllocator  ownedAllocator;
+        LinearAllocator* allocator = nullptr;
+    };
+}
@@ -3,6 +3,7 @@
 #include "Core/OS.h"
 #include "Core/Logger.h"
 #include "Core/TypeInfo.h"
+#include "Core/FlatHashMap.h"
 #include <atomic>
 
 
@@ -36,12 +37,16 @@ namespace Silex
 
     private:
 
-        static inline std::unordered_map<std::string, TypeInfo> classInfoMap;
+        static inline FlatHashMap<std::string, TypeInfo> classInfoMap;
     };
 
 
     //========================================
     // 参照カウントオブジェクト
+    //----------------------------------------
+    // 参照カウントの操作はアトミックに行う
+    // 生成から破棄まで単一スレッドでしか扱わない派生クラスは、
+    // atomicRefCount = false を宣言すると、ロック命令なしの読み書きで操作される
     //========================================
     class Object : public Class
     {
@@ -49,17 +54,34 @@ namespace Silex
 
     public:
 
+        static constexpr bool atomicRefCount = true;
+
         Object()              {};
         Object(const Object&) {};
 
     public:
 
-        uint32 GetRefCount() const { return refCount; }
+        uint32 GetRefCount() const { return refCount.load(std::memory_order_relaxed); }
 
     private:
 
-        void IncRefCount() const { ++refCount; }
-        void DecRefCount() const { --refCount; }
+        // 解放するスレッドが、他スレッドでの最後の書き込みを観測できるように、減算は acq_rel で行う
+        // 減算後の値で判定しないと、複数スレッドが同時に 0 を観測して二重解放になる
+        void   IncRefCount() const { refCount.fetch_add(1, std::memory_order_relaxed); }
+        uint32 DecRefCount() const { return refCount.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+
+        void IncRefCountNonAtomic() const
+        {
+            refCount.store(refCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        uint32 DecRefCountNonAtomic() const
+        {
+            const uint32 count = refCount.load(std::memory_order_relaxed) - 1;
+            refCount.store(count, std::memory_order_relaxed);
+
+            return count;
+        }
 
         mutable std::atomic<uint32> refCount = 0;
 
@@ -0,0 +1,170 @@
+#pragma once
+#include "Core/ThreadPool.h"
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+
+namespace Silex
+{
+    namespace Internal
+    {
+        // スレッドあたりの分割数（タスクごとの処理時間のばらつきをワークスティーリングで吸収させる）
+        static constexpr uint64 parallelChunksPerThread = 4;
+
+        // 隣接するチャンクの書き込みが同一キャッシュラインに乗らないように、分割単位をこの倍数に切り上げる
+        // (粒度の指定に関わらず、チャンクの要素数がこの値以下の場合のみ揃えない)
+        static constexpr uint64 parallelChunkAlignment = 64;
+
+        // これ以下の要素数ではタスク投入のコストが上回るので、呼び出しスレッドで直接処理する
+        static constexpr uint64 parallelDefaultGrainSize = 256;
+
+        // 要素数とワーカー数から1チャンクあたりの要素数を求める
+        inline uint64 ComputeParallelChunkSize(uint64 count, uint64 grainSize)
+        {
+            const uint64 minSize     = grainSize == 0 ? parallelDefaultGrainSize : grainSize;
+            const uint64 threadCount = (uint64)ThreadPool::GetThreadCount() + 1;
+            const uint64 chunkCount  = threadCount * parallelChunksPerThread;
+
+            uint64 chunkSize = (count + chunkCount - 1) / chunkCount;
+            chunkSize = std::max(chunkSize, minSize);
+
+            if (chunkSize > parallelChunkAlignment)
+                chunkSize = (chunkSize + parallelChunkAlignment - 1) / parallelChunkAlignment * parallelChunkAlignment;
+
+            return chunkSize;
+        }
+    }
+
+
+    //==================================================================
+    // [begin, end) の範囲を分割して並列実行する
+    //------------------------------------------------------------------
+    // func(uint64 chunkBegin, uint64 chunkEnd) が各チャンクごとに呼び出される
+    // 呼び出しスレッドも最初のチャンクを処理し、全チャンクの完了まで戻らない
+    //==================================================================
+    template<typename Func>
+    void ParallelForRange(uint64 begin, uint64 end, Func&& func, uint64 grainSize = 0)
+    {
+        if (begin >= end)
+            return;
+
+        const uint64 count     = end - begin;
+        const uint64 chunkSize = Internal::ComputeParallelChunkSize(count, grainSize);
+
+        // 分割する意味がなければ直接処理
+        if (count <= chunkSize || ThreadPool::GetThreadCount() == 0)
+        {
+            func(begin, end);
+            return;
+        }
+
+        TaskCounter counter;
+        for (uint64 chunkBegin = begin + chunkSize; chunkBegin < end; chunkBegin += chunkSize)
+        {
+            const uint64 chunkEnd = std::min(chunkBegin + chunkSize, end);
+            ThreadPool::AddTask([&func, chunkBegin, chunkEnd]() { func(chunkBegin, chunkEnd); }, &counter);
+        }
+
+        func(begin, std::min(begin + chunkSize, end));
+        ThreadPool::Wait(counter);
+    }
+
+    //==================================================================
+    // [begin, end) の各インデックスに対して func(uint64 index) を並列実行する
+    //==================================================================
+    template<typename Func>
+    void ParallelFor(uint64 begin, uint64 end, Func&& func, uint64 grainSize = 0)
+    {
+        ParallelForRange(begin, end, [&func](uint64 chunkBegin, uint64 chunkEnd)
+        {
+            for (uint64 i = chunkBegin; i < chunkEnd; i++)
+                func(i);
+
+        }, grainSize);
+    }
+
+    //==================================================================
+    // [begin, end) をチャンクごとに集計し、その結果を reduce で結合する
+    //------------------------------------------------------------------
+    // func(uint64 chunkBegin, uint64 chunkEnd) -> T   : チャンクの集計
+    // reduce(const T& a, const T& b)         -> T   : 集計結果の結合（結合則を満たすこと）
+    // 結合はチャンク順に行うので、浮動小数点の加算でも実行ごとに結果が変わらない
+    //==================================================================
+    template<typename T, typename Func, typename Reduce>
+    T ParallelReduce(uint64 begin, uint64 end, const T& identity, Func&& func, Reduce&& reduce, uint64 grainSize = 0)
+    {
+        if (begin >= end)
+            return identity;
+
+        const uint64 count      = end - begin;
+        const uint64 chunkSize  = Internal::ComputeParallelChunkSize(count, grainSize);
+        const uint64 chunkCount = (count + chunkSize - 1) / chunkSize;
+
+        if (chunkCount <= 1 || ThreadPool::GetThreadCount() == 0)
+            return reduce(identity, func(begin, end));
+
+        std::vector<T> partials(chunkCount, identity);
+        ParallelFor(0, chunkCount, [&](uint64 chunk)
+        {
+            const uint64 chunkBegin = begin + chunk * chunkSize;
+            const uint64 chunkEnd   = std::min(chunkBegin + chunkSize, end);
+            partials[chunk] = func(chunkBegin, chunkEnd);
+
+        }, 1);
+
+        T result = identity;
+        for (const T& partial : partials)
+            result = reduce(result, partial);
+
+        return result;
+    }
+
+    //==================================================================
+    // ランダムアクセスイテレーター範囲の並列ソート（安定ではない）
+    //------------------------------------------------------------------
+    // チャンクごとに std::sort した後、隣接チャンクを並列にマージしていく
+    //==================================================================
+    template<typename Iterator, typename Compare = std::less<>>
+    void ParallelSort(Iterator first, Iterator last, Compare compare = Compare(), uint64 grainSize = 0)
+    {
+        static_assert(std::random_access_iterator<Iterator>);
+
+        const uint64 count     = (uint64)std::distance(first, last);
+        const uint64 chunkSize = Internal::ComputeParallelChunkSize(count, grainSize == 0 ? 4096 : grainSize);
+
+        if (count <= chunkSize || ThreadPool::GetThreadCount() == 0)
+        {
+            std::sort(first, last, compare);
+            return;
+        }
+
+        const uint64 chunkCount = (count + chunkSize - 1) / chunkSize;
+
+        // 各チャンクをソート
+        ParallelFor(0, chunkCount, [&](uint64 chunk)
+        {
+            const uint64 chunkBegin = chunk * chunkSize;
+            const uint64 chunkEnd   = std::min(chunkBegin + chunkSize, count);
+            std::sort(first + chunkBegin, first + chunkEnd, compare);
+
+        }, 1);
+
+        // 幅を倍にしながら隣接するソート済み範囲をマージ
+        for (uint64 width = chunkSize; width < count; width *= 2)
+        {
+            const uint64 mergeCount = (count + width * 2 - 1) / (width * 2);
+
+            ParallelFor(0, mergeCount, [&](uint64 merge)
+            {
+                const uint64 mergeBegin = merge * width * 2;
+                const uint64 mergeMid   = std::min(mergeBegin + width, count);
+                const uint64 mergeEnd   = std::min(mergeBegin + width * 2, count);
+
+                if (mergeMid < mergeEnd)
+                    std::inplace_merge(first + mergeBegin, first + mergeMid, first + mergeEnd, compare);
+
+            }, 1);
+        }
+    }
+}
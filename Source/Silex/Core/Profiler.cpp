@@ -0,0 +1,291 @@
+
+#include "PCH.h"
+#include "Core/Profiler.h"
+
+#include <fstream>
+
+
+namespace Silex
+{
+    namespace Internal
+    {
+        //==============================================================
+        // スレッドごとのゾーンバッファ
+        //--------------------------------------------------------------
+        // 書き込みは所有スレッドのみ、読み出しは NewFrame（メインスレッド）のみの SPSC リングバッファ
+        // 回収されていない領域は上書きせず、満杯の間に終了したゾーンは破棄する
+        //==============================================================
+        struct ProfileThreadBuffer
+        {
+            static constexpr uint64 capacity = 16384;
+            static constexpr uint64 mask     = capacity - 1;
+
+            alignas(64) std::atomic<uint64> writeCount = 0;
+            alignas(64) std::atomic<uint64> readCount  = 0;
+
+            uint32       depth       = 0; // 所有スレッドのみ
+            uint32       threadIndex = 0;
+            std::string  name;            // threadMutex で保護
+            ProfileEvent events[capacity];
+        };
+
+        static std::mutex                                        threadMutex;
+        static std::vector<std::unique_ptr<ProfileThreadBuffer>> threadBuffers;
+
+        // 所有スレッドが終了してもバッファは破棄しない（回収前のゾーンを失わないため）
+        static thread_local ProfileThreadBuffer* currentThreadBuffer = nullptr;
+
+        static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+        // フレーム履歴（メインスレッドのみ）
+        static std::vector<ProfileFrame> frames;
+        static uint64                    frameCount  = 0; // 履歴に保存した総フレーム数
+        static uint64                    frameNumber = 0;
+        static uint64                    frameBegin  = 0;
+        static bool                      paused      = false;
+
+        static ProfileThreadBuffer* GetThreadBuffer()
+        {
+            if (currentThreadBuffer) SL_LIKELY
+                return currentThreadBuffer;
+
+            auto buffer = std::make_unique<ProfileThreadBuffer>();
+
+            std::lock_guard<std::mutex> lock(threadMutex);
+
+            buffer->threadIndex = (uint32)threadBuffers.size() + 1;
+            buffer->name        = std::format("Thread {}", buffer->threadIndex);
+
+            currentThreadBuffer = buffer.get();
+            threadBuffers.push_back(std::move(buffer));
+
+            return currentThreadBuffer;
+        }
+
+        // 前回の回収以降に記録されたゾーンを frame に追加する（frame が nullptr なら破棄する）
+        static void CollectEvents(ProfileThreadBuffer& buffer, ProfileFrame* frame)
+        {
+            const uint64 writeCount = buffer.writeCount.load(std::memory_order_acquire);
+            const uint64 readCount  = buffer.readCount.load(std::memory_order_relaxed);
+
+            if (frame)
+            {
+                for (uint64 i = readCount; i < writeCount; i++)
+                {
+                    frame->events.push_back(buffer.events[i & ProfileThreadBuffer::mask]);
+                }
+            }
+
+            // コピーし終えた領域を所有スレッドに開放する
+            buffer.readCount.store(writeCount, std::memory_order_release);
+        }
+
+        static void AppendEscaped(std::string& out, std::string_view text)
+        {
+            for (char c : text)
+            {
+                switch (c)
+                {
+                    case '"'  : out += "\\\""; break;
+                    case '\\' : out += "\\\\"; break;
+                    case '\n' : out += "\\n";  break;
+                    case '\t' : out += "\\t";  break;
+
+                    default: out += c; break;
+                }
+            }
+        }
+
+        static void AppendTraceEvent(std::string& out, std::string_view name, uint32 threadIndex, uint64 begin, uint64 end)
+        {
+            // ts / dur はマイクロ秒
+            out += ",\n{\"ph\":\"X\",\"pid\":0,\"name\":\"";
+            AppendEscaped(out, name);
+            std::format_to(std::back_inserter(out), "\",\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", threadIndex, begin / 1000.0, (end - begin) / 1000.0);
+        }
+
+        static void AppendThreadName(std::string& out, uint32 threadIndex, std::string_view name)
+        {
+            std::format_to(std::back_inserter(out), ",\n{{\"ph\":\"M\",\"pid\":0,\"tid\":{},\"name\":\"thread_name\",\"args\":{{\"name\":\"", threadIndex);
+            AppendEscaped(out, name);
+            out += "\"}}";
+        }
+    }
+
+
+    void Profiler::Initialize()
+    {
+        using namespace Internal;
+
+        frames.assign(frameHistoryCount, {});
+        frameCount  = 0;
+        frameNumber = 0;
+        frameBegin  = GetTimestamp();
+        paused      = false;
+
+        SetThreadName("Main");
+    }
+
+    void Profiler::Finalize()
+    {
+        using namespace Internal;
+
+        // スレッドのバッファは、終了していないスレッドが参照しうるので破棄しない
+        frames     = {};
+        frameCount = 0;
+    }
+
+    void Profiler::SetThreadName(std::string_view name)
+    {
+        Internal::ProfileThreadBuffer* buffer = Internal::GetThreadBuffer();
+
+        std::lock_guard<std::mutex> lock(Internal::threadMutex);
+        buffer->name = name;
+    }
+
+    void Profiler::NewFrame()
+    {
+        using namespace Internal;
+
+        const uint64 now = GetTimestamp();
+
+        ProfileFrame* frame = nullptr;
+        if (!paused && !frames.empty())
+        {
+            frame = &frames[frameCount % frameHistoryCount];
+            frame->frameNumber = frameNumber;
+            frame->begin       = frameBegin;
+            frame->end         = now;
+            frame->events.clear();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(threadMutex);
+
+            for (auto& buffer : threadBuffers)
+            {
+                CollectEvents(*buffer, frame);
+            }
+        }
+
+        if (frame)
+        {
+            frameCount++;
+        }
+
+        frameNumber++;
+        frameBegin = now;
+    }
+
+    void Profiler::SetPaused(bool paused)
+    {
+        Internal::paused = paused;
+    }
+
+    bool Profiler::IsPaused()
+    {
+        return Internal::paused;
+    }
+
+    uint64 Profiler::GetFrameCount()
+    {
+        return std::min(Internal::frameCount, frameHistoryCount);
+    }
+
+    const ProfileFrame& Profiler::GetFrame(uint64 framesAgo)
+    {
+        SL_ASSERT(framesAgo < GetFrameCount());
+        return Internal::frames[(Internal::frameCount - 1 - framesAgo) % frameHistoryCount];
+    }
+
+    std::vector<ProfileThreadInfo> Profiler::GetThreads()
+    {
+        std::lock_guard<std::mutex> lock(Internal::threadMutex);
+
+        std::vector<ProfileThreadInfo> threads;
+        threads.reserve(Internal::threadBuffers.size());
+
+        for (auto& buffer : Internal::threadBuffers)
+        {
+            threads.push_back({ buffer->threadIndex, buffer->name });
+        }
+
+        return threads;
+    }
+
+    bool Profiler::ExportChromeTrace(const std::filesystem::path& filePath)
+    {
+        using namespace Internal;
+
+        std::string json;
+        json.reserve(1024 * 1024);
+
+        // スレッド番号 0 は、フレームの区間を表示するための仮想スレッド
+        json += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        json += "{\"ph\":\"M\",\"pid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"Silex\"}}";
+
+        AppendThreadName(json, 0, "Frame");
+        for (const ProfileThreadInfo& thread : GetThreads())
+        {
+            AppendThreadName(json, thread.threadIndex, thread.name);
+        }
+
+        // 古いフレームから順に出力する
+        for (uint64 i = GetFrameCount(); i > 0; i--)
+        {
+            const ProfileFrame& frame = GetFrame(i - 1);
+
+            AppendTraceEvent(json, std::format("Frame {}", frame.frameNumber), 0, frame.begin, frame.end);
+
+            for (const ProfileEvent& event : frame.events)
+            {
+                AppendTraceEvent(json, event.name, event.threadIndex, event.begin, event.end);
+            }
+        }
+
+        json += "\n]}\n";
+
+        std::error_code error;
+        if (filePath.has_parent_path())
+        {
+            std::filesystem::create_directories(filePath.parent_path(), error);
+        }
+
+        std::ofstream file(filePath, std::ios::binary);
+        if (!file)
+        {
+            SL_LOG_ERROR("プロファイル結果を出力できませんでした: {}", filePath.string());
+            return false;
+        }
+
+        file.write(json.data(), json.size());
+        return true;
+    }
+
+    uint64 Profiler::GetTimestamp()
+    {
+        auto elapsed = std::chrono::steady_clock::now() - Internal::epoch;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+    void Profiler::BeginZone()
+    {
+        Internal::GetThreadBuffer()->depth++;
+    }
+
+    void Profiler::EndZone(const char* name, uint64 begin)
+    {
+        const uint64 end = GetTimestamp();
+
+        // BeginZone で取得済み
+        Internal::ProfileThreadBuffer* buffer = Internal::currentThreadBuffer;
+        buffer->depth--;
+
+        const uint64 index = buffer->writeCount.load(std::memory_order_relaxed);
+        if (index - buffer->readCount.load(std::memory_order_acquire) >= Internal::ProfileThreadBuffer::capacity) SL_UNLIKELY
+            return;
+
+        buffer->events[index & Internal::ProfileThreadBuffer::mask] = { name, begin, end, buffer->threadIndex, buffer->depth };
+        buffer->writeCount.store(index + 1, std::memory_order_release);
+    }
+}
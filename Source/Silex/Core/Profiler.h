@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Core/CoreType.h"
+#include "Core/Macros.h"
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace Silex
+{
+    // 計測区間（ゾーン）の記録
+    struct ProfileEvent
+    {
+        const char* name;        // 文字列リテラル（ポインターのみ保持する）
+        uint64      begin;       // Profiler::Initialize からの経過時間（ナノ秒）
+        uint64      end;
+        uint32      threadIndex; // 1 から始まるスレッド番号
+        uint32      depth;       // 同一スレッド内の入れ子の深さ（0 が最上位）
+    };
+
+    // 1 フレームの間に終了したゾーン
+    struct ProfileFrame
+    {
+        uint64                    frameNumber = 0;
+        uint64                    begin       = 0;
+        uint64                    end         = 0;
+        std::vector<ProfileEvent> events;
+    };
+
+    struct ProfileThreadInfo
+    {
+        uint32      threadIndex;
+        std::string name;
+    };
+
+
+    //==================================================================
+    // 階層型 CPU プロファイラー
+    //------------------------------------------------------------------
+    // ・ゾーンの終了時に、スレッドごとのリングバッファ（書き込みは所有スレッドのみ、ロックフリー）へ記録する
+    // ・NewFrame でメインスレッドが全スレッドのバッファを回収し、フレーム履歴に保存する
+    //   （描画スレッドのゾーンは、回収時点までに終了したフレームに入る）
+    // ・時刻はナノ秒の 64 bit 整数で保持し、長時間の実行でも精度が落ちない
+    // ・履歴は Chrome Trace 形式（chrome://tracing / Perfetto で読める JSON）で出力できる
+    //
+    // NewFrame / GetFrame / Export はメインスレッドからのみ呼ぶこと
+    //==================================================================
+    class Profiler
+    {
+    public:
+
+        static constexpr uint64 frameHistoryCount = 300;
+
+        static void Initialize();
+        static void Finalize();
+
+        // 呼び出したスレッドの表示名を設定する
+        static void SetThreadName(std::string_view name);
+
+        // フレームの区切り（メインループの末尾で呼ぶ）
+        static void NewFrame();
+
+        // 一時停止中は回収したゾーンを破棄し、履歴を更新しない
+        static void SetPaused(bool paused);
+        static bool IsPaused();
+
+        // 保持しているフレーム数と、framesAgo フレーム前（0 が直近）のフレーム
+        static uint64              GetFrameCount();
+        static const ProfileFrame& GetFrame(uint64 framesAgo);
+
+        static std::vector<ProfileThreadInfo> GetThreads();
+
+        // 保持している全フレームを、Chrome Trace 形式の JSON で出力する
+        static bool ExportChromeTrace(const std::filesystem::path& filePath);
+
+        static uint64 GetTimestamp();
+
+        // ProfileScope から呼ばれる
+        static void BeginZone();
+        static void EndZone(const char* name, uint64 begin);
+    };
+
+
+    // 生成されてから破棄されるまでをゾーンとして記録する
+    class ProfileScope
+    {
+    public:
+
+        ProfileScope(const char* name)
+            : name(name)
+        {
+            Profiler::BeginZone();
+            begin = Profiler::GetTimestamp();
+        }
+
+        ~ProfileScope()
+        {
+            Profiler::EndZone(name, begin);
+        }
+
+        ProfileScope(const ProfileScope&)            = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+
+        const char* name;
+        uint64      begin;
+    };
+}
+
+#if SL_ENABLE_PROFILER
+    #define SL_SCOPE_PROFILE(name) Silex::ProfileScope SL_COMBINE(profileScope, __LINE__)(name);
+#else
+    #define SL_SCOPE_PROFILE(name)
+#endif
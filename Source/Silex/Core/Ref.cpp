@@ -0,0 +1,79 @@
+
+#include "PCH.h"
+#include "Core/Ref.h"
+
+
+namespace Silex
+{
+    void DeferredRelease::Initialize()
+    {
+        enabled.store(true, std::memory_order_release);
+    }
+
+    void DeferredRelease::Finalize()
+    {
+        enabled.store(false, std::memory_order_release);
+
+        // 破棄中に解放されたオブジェクトも積まれうるので、空になるまで繰り返す
+        while (true)
+        {
+            std::vector<const Object*> objects;
+
+            {
+                std::lock_guard<SpinLock> guard(lock);
+                objects.swap(pending[0]);
+                objects.insert(objects.end(), pending[1].begin(), pending[1].end());
+                pending[1].clear();
+            }
+
+            if (objects.empty())
+                break;
+
+            _Destroy(objects);
+        }
+    }
+
+    void DeferredRelease::NewFrame()
+    {
+        // 前回のセーフポイントより前に積まれたリストを取り出し、以降は空になったそのリストに積む
+        std::vector<const Object*> objects;
+
+        {
+            std::lock_guard<SpinLock> guard(lock);
+
+            currentIndex ^= 1;
+            objects.swap(pending[currentIndex]);
+        }
+
+        _Destroy(objects);
+    }
+
+    void DeferredRelease::Release(const Object* object)
+    {
+        if (enabled.load(std::memory_order_acquire)) SL_LIKELY
+        {
+            std::lock_guard<SpinLock> guard(lock);
+            pending[currentIndex].push_back(object);
+            return;
+        }
+
+        sldelete(object);
+    }
+
+    uint64 DeferredRelease::GetPendingCount()
+    {
+        std::lock_guard<SpinLock> guard(lock);
+        return pending[0].size() + pending[1].size();
+    }
+
+    void DeferredRelease::_Destroy(std::vector<const Object*>& objects)
+    {
+        // 破棄の連鎖で Release が呼ばれるので、ロックは保持しない
+        for (const Object* object : objects)
+        {
+            sldelete(object);
+        }
+
+        objects.clear();
+    }
+}
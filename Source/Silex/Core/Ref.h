@@ -13,8 +13,64 @@ namespace Silex
     // * DecRef関数: 参照カウントが0になった場合の解放処理
     // * Create関数: ユーティリティ関数
     // * As関数:     静的キャスト
+    // * 参照カウントポリシー: atomicRefCount = false の型は非アトミックに操作する
+    // * RefView:    参照カウントを操作しない借用参照
+    // * DeferredRelease: 参照カウントが 0 になったオブジェクトの遅延解放
     //*********************************************************************************************************************
 
+    template<typename T>
+    class RefView;
+
+    namespace Internal
+    {
+        // 型が atomicRefCount = false を宣言していれば非アトミック、それ以外（非公開継承で参照できない場合も含む）はアトミック
+        template<typename T>
+        consteval bool IsAtomicRefCount()
+        {
+            if constexpr (requires { { T::atomicRefCount } -> std::convertible_to<bool>; })
+                return T::atomicRefCount;
+            else
+                return true;
+        }
+    }
+
+
+    //==================================================================
+    // 参照カウントが 0 になったオブジェクトの遅延解放
+    //------------------------------------------------------------------
+    // ・有効な間は、参照カウントが 0 になったオブジェクトを即座に破棄せずにキューへ積む
+    // ・NewFrame（セーフポイント）では、1 つ前のセーフポイントより前に積まれたオブジェクトのみ破棄する
+    //   → セーフポイント間で生成された RefView（描画スナップショット等）は、
+    //     次のセーフポイントまでの間、参照先が解放されないことが保証される
+    // ・積むのはどのスレッドからでも可能。NewFrame / Finalize は描画スレッドの待機中にメインスレッドから呼ぶこと
+    // ・無効な間（初期化前 / 終了処理中）は、従来通りその場で破棄する
+    //==================================================================
+    class DeferredRelease
+    {
+    public:
+
+        static void Initialize();
+        static void Finalize();
+
+        // セーフポイント: 1 つ前のセーフポイントより前に積まれたオブジェクトを破棄する
+        static void NewFrame();
+
+        // 遅延解放が有効ならキューに積み、無効ならその場で破棄する
+        static void Release(const Object* object);
+
+        static uint64 GetPendingCount();
+
+    private:
+
+        static void _Destroy(std::vector<const Object*>& objects);
+
+        static inline SpinLock                   lock;
+        static inline std::vector<const Object*> pending[2];
+        static inline uint32                     currentIndex = 0;
+        static inline std::atomic<bool>          enabled      = false;
+    };
+
+
     template<typename T>
     class Ref
     {
@@ -195,25 +251,103 @@ namespace Silex
             return Ref<T2>(static_cast<T2*>(this->Get()));
         }
 
+        // 参照カウントを操作せずにキャストした借用参照を返す
+        template<class T2>
+        RefView<T2> AsView() const
+        {
+            return RefView<T2>(static_cast<T2*>(this->Get()));
+        }
+
     private:
 
+        // ポリシーは不完全型のメンバー宣言を妨げないように、操作時に判定する
         void IncRef(const Object* object)
         {
-            object->IncRefCount();
+            if constexpr (Internal::IsAtomicRefCount<T>()) object->IncRefCount();
+            else                                           object->IncRefCountNonAtomic();
         }
 
         void DecRef(const Object* object)
         {
-            object->DecRefCount();
+            uint32 count;
+            if constexpr (Internal::IsAtomicRefCount<T>()) count = object->DecRefCount();
+            else                                           count = object->DecRefCountNonAtomic();
 
-            if (object->GetRefCount() == 0)
+            if (count == 0)
             {
-                sldelete(object);
+                DeferredRelease::Release(object);
             }
         }
     };
 
 
+    //==================================================================
+    // 借用参照（参照カウントを操作しない）
+    //------------------------------------------------------------------
+    // ・読み取り専用の受け渡しや、フレーム内のスナップショット用
+    //   コピー / 破棄はポインタの複製のみで、アトミック操作を伴わない
+    // ・参照先の寿命は保証しないので、所有する Ref が別に存在する間に限って使用すること
+    //   （所有者が手放しても、DeferredRelease が有効なら次のセーフポイントまでは有効）
+    // ・保持し続ける場合は ToRef で所有権を得ること（所有する Ref が存在する間に限る）
+    //==================================================================
+    template<typename T>
+    class RefView
+    {
+    private:
+
+        template<typename T2> friend class RefView;
+
+        T* instance = nullptr;
+
+    public:
+
+        RefView()               {}
+        RefView(std::nullptr_t) {}
+
+        explicit RefView(T* ptr) : instance(ptr) {}
+
+        template<typename T2 = T>
+        RefView(const Ref<T2>& r) : instance(r.Get()) {}
+
+        template<typename T2 = T>
+        RefView(const RefView<T2>& r) : instance(r.instance) {}
+
+        // 一時オブジェクトからの借用は、直後に参照先が解放されうるので禁止
+        template<typename T2 = T>
+        RefView(Ref<T2>&& r) = delete;
+
+        template<typename T2 = T>
+        bool operator==(const RefView<T2>& r) const { return instance == r.instance; }
+
+        template<typename T2 = T>
+        bool operator==(const Ref<T2>& r) const { return instance == r.Get(); }
+
+        bool operator==(std::nullptr_t) const { return instance == nullptr; }
+        bool operator!=(std::nullptr_t) const { return instance != nullptr; }
+
+        T* operator->() const { return instance;  }
+        T& operator*()  const { return *instance; }
+        T* Get()        const { return instance;  }
+
+        operator bool() const { return instance != nullptr; }
+        bool IsValid()  const { return instance != nullptr; }
+
+        // 所有参照に昇格する（参照カウントを加算）
+        // 参照カウントが 0 のオブジェクトは DeferredRelease に積まれていて、セーフポイントで破棄されるので昇格できない
+        Ref<T> ToRef() const
+        {
+            SL_ASSERT(!instance || ((const Object*)instance)->GetRefCount() > 0);
+            return Ref<T>(instance);
+        }
+
+        template<class T2>
+        RefView<T2> As() const
+        {
+            return RefView<T2>(static_cast<T2*>(instance));
+        }
+    };
+
+
     template<class T, class... Args>
     static Ref<T> CreateRef(Args&&... args)
     {
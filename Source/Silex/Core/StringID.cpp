@@ -0,0 +1,100 @@
+
+#include "PCH.h"
+#include "Core/StringID.h"
+#include "Core/LinearAllocator.h"
+
+#include <shared_mutex>
+
+
+namespace Silex
+{
+    namespace Internal
+    {
+        //==============================================================
+        // 文字列テーブル
+        //--------------------------------------------------------------
+        // 文字列本体はリニアアロケーターに詰めて格納し、個別には解放しない
+        // 登録済みかの確認は共有ロックで行い、新規登録時のみ排他ロックを取る
+        //==============================================================
+        class StringTable
+        {
+        public:
+
+            static StringTable& Get()
+            {
+                static StringTable table;
+                return table;
+            }
+
+            StringTable()
+            {
+                storage.Initialize(64 * 1024); // 64KB
+                entries.reserve(1024);
+            }
+
+            void Intern(uint64 id, std::string_view str)
+            {
+                {
+                    std::shared_lock lock(mutex);
+
+                    auto it = entries.find(id);
+                    if (it != entries.end()) SL_LIKELY
+                    {
+                        SL_ASSERT(it->second == str, "StringID: ハッシュ値が衝突しました");
+                        return;
+                    }
+                }
+
+                std::unique_lock lock(mutex);
+
+                // ロックを取り直す間に、他のスレッドが登録している場合がある
+                if (entries.contains(id))
+                    return;
+
+                char* data = static_cast<char*>(storage.Allocate(str.size() + 1, 1));
+                std::memcpy(data, str.data(), str.size());
+                data[str.size()] = '\0';
+
+                entries.emplace(id, std::string_view(data, str.size()));
+            }
+
+            std::string_view Find(uint64 id) const
+            {
+                std::shared_lock lock(mutex);
+
+                auto it = entries.find(id);
+                return it != entries.end() ? it->second : std::string_view("");
+            }
+
+        private:
+
+            mutable std::shared_mutex               mutex;
+            FlatHashMap<uint64, std::string_view>   entries;
+            LinearAllocator                         storage;
+        };
+    }
+
+
+    StringID::StringID(std::string_view str)
+        : id(str.empty() ? 0 : Hash::XXH3(str))
+    {
+        if (id != 0)
+        {
+            Internal::StringTable::Get().Intern(id, str);
+        }
+    }
+
+    std::string_view StringID::GetString() const
+    {
+        if (id == 0)
+            return "";
+
+        return Internal::StringTable::Get().Find(id);
+    }
+
+    // 登録された文字列は終端文字を含めて格納している
+    const char* StringID::c_str() const
+    {
+        return GetString().data();
+    }
+}
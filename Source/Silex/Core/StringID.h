@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Core/CoreType.h"
+#include "Core/Hash.h"
+#include "Core/FlatHashMap.h"
+
+#include <string>
+#include <string_view>
+
+
+//==================================================================
+// 文字列インターン（StringID）
+//------------------------------------------------------------------
+// ・文字列の XXH3 ハッシュ値（64bit）のみを保持し、比較 / ハッシュは整数演算で済む
+// ・文字列から生成すると、グローバルな文字列テーブルに登録され、GetString / c_str で逆引きできる
+//   （登録された文字列は解放されず、アドレスはプログラム終了まで有効）
+// ・Lookup は登録せずに ID のみ求める（検索キー用。未登録の文字列は逆引きできない）
+// ・Static はコンパイル時に ID を求める（リテラル同士 / 登録済み文字列との比較用）
+// ・空文字列は ID 0（None）として扱い、テーブルには登録しない
+// ・テーブルは共有ロックで保護しているので、どのスレッドからも生成 / 逆引きできる
+//==================================================================
+namespace Silex
+{
+    class StringID
+    {
+    public:
+
+        constexpr StringID() = default;
+
+        explicit StringID(std::string_view str);
+        explicit StringID(const std::string& str) : StringID(std::string_view(str)) {}
+        explicit StringID(const char* str)        : StringID(std::string_view(str)) {}
+
+        // テーブルに登録せずに ID を求める
+        static StringID Lookup(std::string_view str)
+        {
+            return StringID(str.empty() ? 0 : Hash::XXH3(str), 0);
+        }
+
+        // コンパイル時に ID を求める
+        static consteval StringID Static(std::string_view str)
+        {
+            return StringID(str.empty() ? 0 : Hash::StaticXXH3(str), 0);
+        }
+
+    public:
+
+        uint64 GetID()  const { return id;      }
+        bool   IsNone() const { return id == 0; }
+
+        // 登録済みの文字列を返す（未登録 / None は空文字列）
+        std::string_view GetString() const;
+        const char*      c_str()     const;
+        std::string      ToString()  const { return std::string(GetString()); }
+
+        explicit operator bool() const { return id != 0; }
+
+        constexpr bool operator==(const StringID& other) const = default;
+        constexpr auto operator<=>(const StringID& other) const = default;
+
+    private:
+
+        constexpr StringID(uint64 hash, int)
+            : id(hash)
+        {}
+
+        uint64 id = 0;
+    };
+
+
+    // ID 自体が XXH3 のハッシュ値なので、再度混合する必要はない
+    template<>
+    struct FlatHash<StringID>
+    {
+        uint64 operator()(StringID sid) const
+        {
+            return sid.GetID();
+        }
+    };
+}
+
+
+template<>
+struct std::hash<Silex::StringID>
+{
+    std::size_t operator()(Silex::StringID sid) const noexcept
+    {
+        return static_cast<std::size_t>(sid.GetID());
+    }
+};
@@ -0,0 +1,185 @@
+
+#include "PCH.h"
+#include "TaskGraph.h"
+
+
+namespace Silex
+{
+    //==================================================================
+    // TaskNode
+    //==================================================================
+    TaskNode::TaskNode(TaskGraph* owner, Task&& function)
+        : graph(owner)
+        , task(std::move(function))
+    {
+    }
+
+    TaskNode* TaskNode::Precede(TaskNode* next)
+    {
+        graph->AddDependency(this, next);
+        return this;
+    }
+
+    TaskNode* TaskNode::Succeed(TaskNode* prev)
+    {
+        graph->AddDependency(prev, this);
+        return this;
+    }
+
+    TaskNode* TaskNode::Then(Task&& continuation)
+    {
+        return graph->AddTask(std::move(continuation), { this });
+    }
+
+
+    //==================================================================
+    // TaskGraph
+    //==================================================================
+    TaskGraph::~TaskGraph()
+    {
+        // 実行中のタスクがノードを参照しているので、完了まで破棄できない
+        Wait();
+    }
+
+    TaskNode* TaskGraph::AddTask(Task&& task)
+    {
+        SL_ASSERT(IsCompleted());
+
+        return &nodes.emplace_back(this, std::move(task));
+    }
+
+    TaskNode* TaskGraph::AddTask(Task&& task, std::initializer_list<TaskNode*> dependencies)
+    {
+        return AddTask(std::move(task), std::span<TaskNode* const>(dependencies.begin(), dependencies.size()));
+    }
+
+    TaskNode* TaskGraph::AddTask(Task&& task, std::span<TaskNode* const> dependencies)
+    {
+        TaskNode* node = AddTask(std::move(task));
+        for (TaskNode* dependency : dependencies)
+        {
+            AddDependency(dependency, node);
+        }
+
+        return node;
+    }
+
+    void TaskGraph::AddDependency(TaskNode* before, TaskNode* after)
+    {
+        SL_ASSERT(IsCompleted());
+        SL_ASSERT(before && after && before != after);
+        SL_ASSERT(before->graph == this && after->graph == this);
+
+        before->successors.push_back(after);
+        after->predecessorCount++;
+    }
+
+    void TaskGraph::Run()
+    {
+        SL_ASSERT(IsCompleted());
+
+        if (nodes.empty())
+            return;
+
+        // 循環したノードは実行されず、待機が終わらなくなるので投入前に検出する
+        if (HasCycle())
+        {
+            SL_LOG_ERROR("TaskGraph: 依存関係が循環しています");
+            SL_ASSERT(false);
+            return;
+        }
+
+        // 全ノードのカウンターを先に設定してから投入しないと、先に完了したタスクが未設定のノードを参照してしまう
+        // graphCounter もグラフ全体分を先に加算しておき、後続ノードの投入前に 0 にならないようにする
+        for (TaskNode& node : nodes)
+        {
+            node.pendingCount.store(node.predecessorCount, std::memory_order_relaxed);
+            node.counter.Increment();
+            graphCounter.Increment();
+        }
+
+        for (TaskNode& node : nodes)
+        {
+            if (node.predecessorCount == 0)
+                Schedule(&node);
+        }
+    }
+
+    void TaskGraph::Wait()
+    {
+        ThreadPool::Wait(graphCounter);
+    }
+
+    void TaskGraph::Wait(TaskNode* node)
+    {
+        SL_ASSERT(node->graph == this);
+        ThreadPool::Wait(node->counter);
+    }
+
+    void TaskGraph::Wait(std::span<TaskNode* const> waitNodes)
+    {
+        for (TaskNode* node : waitNodes)
+        {
+            Wait(node);
+        }
+    }
+
+    void TaskGraph::Clear()
+    {
+        SL_ASSERT(IsCompleted());
+        nodes.clear();
+    }
+
+    void TaskGraph::Schedule(TaskNode* node)
+    {
+        ThreadPool::AddTask([this, node]() { Execute(node); });
+    }
+
+    void TaskGraph::Execute(TaskNode* node)
+    {
+        if (node->task)
+            node->task();
+
+        // 最後の先行タスクが完了したノードを投入する
+        for (TaskNode* successor : node->successors)
+        {
+            if (successor->pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Schedule(successor);
+        }
+
+        node->counter.Decrement();
+
+        // 最後のノードの完了後はグラフが破棄されうるので、以降はグラフに触れない
+        graphCounter.Decrement();
+    }
+
+    bool TaskGraph::HasCycle()
+    {
+        // 先行タスクを持たないノードから順に取り除き、取り除けないノードが残れば循環している
+        // （未実行の状態でのみ呼び出されるので、pendingCount を作業領域として使う）
+        std::vector<TaskNode*> ready;
+
+        for (TaskNode& node : nodes)
+        {
+            node.pendingCount.store(node.predecessorCount, std::memory_order_relaxed);
+            if (node.predecessorCount == 0)
+                ready.push_back(&node);
+        }
+
+        uint64 visitedCount = 0;
+        while (!ready.empty())
+        {
+            TaskNode* node = ready.back();
+            ready.pop_back();
+            visitedCount++;
+
+            for (TaskNode* successor : node->successors)
+            {
+                if (successor->pendingCount.fetch_sub(1, std::memory_order_relaxed) == 1)
+                    ready.push_back(successor);
+            }
+        }
+
+        return visitedCount != nodes.size();
+    }
+}
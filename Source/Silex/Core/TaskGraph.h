@@ -0,0 +1,107 @@
+#pragma once
+#include "Core/ThreadPool.h"
+#include <vector>
+#include <deque>
+#include <span>
+
+
+namespace Silex
+{
+    class TaskGraph;
+
+
+    //==================================================================
+    // タスクグラフのノード
+    //------------------------------------------------------------------
+    // TaskGraph::AddTask で生成され、グラフが破棄されるまで有効
+    // 依存関係（先行タスク）がすべて完了した時点でスレッドプールに投入される
+    //==================================================================
+    class TaskNode
+    {
+    public:
+
+        TaskNode(TaskGraph* owner, Task&& function);
+        TaskNode(const TaskNode&)            = delete;
+        TaskNode& operator=(const TaskNode&) = delete;
+
+        // this → next の順に実行されるように依存関係を追加する
+        TaskNode* Precede(TaskNode* next);
+
+        // prev → this の順に実行されるように依存関係を追加する
+        TaskNode* Succeed(TaskNode* prev);
+
+        // このタスクの完了後に実行される継続タスクを生成する
+        TaskNode* Then(Task&& continuation);
+
+        bool IsCompleted() const { return counter.IsCompleted(); }
+
+    private:
+
+        TaskGraph*             graph            = nullptr;
+        Task                   task;
+        std::vector<TaskNode*> successors;
+        uint32                 predecessorCount = 0;
+        std::atomic<uint32>    pendingCount     = 0;
+        TaskCounter            counter;
+
+        friend class TaskGraph;
+    };
+
+
+    //==================================================================
+    // タスクグラフ
+    //------------------------------------------------------------------
+    // タスク間の依存関係（DAG）を構築し、先行タスクが完了したタスクから順に並列実行する
+    // 構築 → Run → Wait の流れで使用し、実行中のノード追加・依存関係の変更はできない
+    // 一度構築したグラフは、完了後に再度 Run することで繰り返し実行できる
+    // 依存関係が循環している場合、Run はエラーとなり何も実行しない
+    //==================================================================
+    class TaskGraph
+    {
+    public:
+
+        TaskGraph() = default;
+        ~TaskGraph();
+
+        TaskGraph(const TaskGraph&)            = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+
+        // タスクを追加する（dependencies のタスクがすべて完了してから実行される）
+        TaskNode* AddTask(Task&& task);
+        TaskNode* AddTask(Task&& task, std::initializer_list<TaskNode*> dependencies);
+        TaskNode* AddTask(Task&& task, std::span<TaskNode* const> dependencies);
+
+        // before → after の依存関係を追加する
+        void AddDependency(TaskNode* before, TaskNode* after);
+
+        // 先行タスクを持たないノードからスレッドプールに投入する
+        void Run();
+
+        // グラフ全体の完了を待機する（待機中は呼び出しスレッドもタスクを実行する）
+        void Wait();
+
+        // 指定ノード（とその先行タスク）の完了を待機する
+        void Wait(TaskNode* node);
+        void Wait(std::span<TaskNode* const> nodes);
+
+        // 全ノードを破棄する（実行中は不可）
+        void Clear();
+
+        bool   IsCompleted()  const { return graphCounter.IsCompleted(); }
+        uint32 GetNodeCount() const { return (uint32)nodes.size();       }
+
+    private:
+
+        void Schedule(TaskNode* node);
+        void Execute(TaskNode* node);
+
+        // 依存関係が循環しているか（ルートを経由しない循環も検出する）
+        bool HasCycle();
+
+    private:
+
+        // ノードのアドレスを固定するため deque で保持する
+        std::deque<TaskNode> nodes;
+        TaskCounter          graphCounter;
+    };
+}
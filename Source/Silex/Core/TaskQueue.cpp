@@ -0,0 +1,177 @@
+
+#include "PCH.h"
+#include "Core/TaskQueue.h"
+
+
+namespace Silex
+{
+    void TaskQueue::Initialize(uint64 chunkSize)
+    {
+        SL_ASSERT(chunkByteSize == 0);
+
+        chunkByteSize = (chunkSize + taskAlignment - 1) & ~(taskAlignment - 1);
+
+        for (ChunkList& list : lists)
+        {
+            list.head = _AllocateChunk(chunkByteSize);
+            list.current.store(list.head, std::memory_order_release);
+        }
+    }
+
+    void TaskQueue::Release()
+    {
+        if (chunkByteSize == 0)
+            return;
+
+        // 投入先が切り替わるので、両方のリストを実行する
+        Execute();
+        Execute();
+
+        for (ChunkList& list : lists)
+        {
+            Chunk* chunk = list.head;
+            while (chunk)
+            {
+                Chunk* next = chunk->next;
+                Memory::Destruct(chunk);
+                Memory::Free(chunk);
+
+                chunk = next;
+            }
+
+            list.head = nullptr;
+            list.current.store(nullptr, std::memory_order_release);
+        }
+
+        chunkByteSize = 0;
+    }
+
+    void TaskQueue::Execute()
+    {
+        ChunkList& list = _SwapList();
+
+        for (Chunk* chunk = list.head; chunk; chunk = chunk->next)
+        {
+            byte*        data = chunk->GetData();
+            const uint64 end  = chunk->committed.load(std::memory_order_acquire);
+
+            for (uint64 offset = 0; offset < end;)
+            {
+                ITask* task = reinterpret_cast<ITask*>(data + offset);
+                offset += task->size;
+
+                task->Execute();
+                Memory::Destruct(task);
+            }
+        }
+
+        _ResetList(list);
+    }
+
+    bool TaskQueue::IsEmpty() const
+    {
+        const ChunkList& list = lists[epoch.load(std::memory_order_acquire) & 1];
+
+        for (const Chunk* chunk = list.head; chunk; chunk = chunk->next)
+        {
+            if (chunk->reserved.load(std::memory_order_relaxed) != 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    TaskQueue::Reservation TaskQueue::_Reserve(uint64 size)
+    {
+        SL_ASSERT(chunkByteSize != 0);
+
+        while (true)
+        {
+            // 投入先リストの書き込み数を増やしてから、投入先が切り替わっていないかを確認する
+            // (切り替わっていた場合、実行側はこの書き込みを待たないので、やり直す)
+            const uint32 current = epoch.load(std::memory_order_seq_cst);
+            ChunkList&   list    = lists[current & 1];
+
+            list.writers.fetch_add(1, std::memory_order_seq_cst);
+
+            if (epoch.load(std::memory_order_seq_cst) != current)
+            {
+                list.writers.fetch_sub(1, std::memory_order_release);
+                continue;
+            }
+
+            while (true)
+            {
+                Chunk* chunk  = list.current.load(std::memory_order_acquire);
+                uint64 offset = chunk->reserved.fetch_add(size, std::memory_order_relaxed);
+
+                if (offset + size <= chunk->capacity)
+                    return { &list, chunk, chunk->GetData() + offset };
+
+                // 容量不足: 以降の予約も全て失敗するので、次のチャンクへ切り替える
+                _Grow(list, chunk, size);
+            }
+        }
+    }
+
+    void TaskQueue::_Commit(const Reservation& reservation, uint64 size)
+    {
+        reservation.chunk->committed.fetch_add(size, std::memory_order_relaxed);
+        reservation.list->writers.fetch_sub(1, std::memory_order_release);
+    }
+
+    void TaskQueue::_Grow(ChunkList& list, Chunk* full, uint64 size)
+    {
+        std::lock_guard<std::mutex> lock(list.growMutex);
+
+        // 他のスレッドが既に切り替えている
+        if (list.current.load(std::memory_order_relaxed) != full)
+            return;
+
+        // 前回までに確保したチャンクが残っていれば再利用する
+        Chunk* next = full->next;
+        if (!next || next->capacity < size)
+        {
+            Chunk* chunk = _AllocateChunk(std::max(chunkByteSize, size));
+            chunk->next = next;
+            full->next  = chunk;
+            next        = chunk;
+        }
+
+        list.current.store(next, std::memory_order_release);
+    }
+
+    TaskQueue::ChunkList& TaskQueue::_SwapList()
+    {
+        const uint32 previous = epoch.fetch_add(1, std::memory_order_seq_cst);
+        ChunkList&   list     = lists[previous & 1];
+
+        // 切り替え前に予約した書き込みの完了を待つ
+        while (list.writers.load(std::memory_order_acquire) != 0)
+        {
+            std::this_thread::yield();
+        }
+
+        return list;
+    }
+
+    void TaskQueue::_ResetList(ChunkList& list)
+    {
+        for (Chunk* chunk = list.head; chunk; chunk = chunk->next)
+        {
+            chunk->reserved.store(0, std::memory_order_relaxed);
+            chunk->committed.store(0, std::memory_order_relaxed);
+        }
+
+        list.current.store(list.head, std::memory_order_release);
+    }
+
+    TaskQueue::Chunk* TaskQueue::_AllocateChunk(uint64 capacity)
+    {
+        void*  memory = Memory::Malloc(sizeof(Chunk) + capacity);
+        Chunk* chunk  = Memory::Construct<Chunk>(memory);
+        chunk->capacity = capacity;
+
+        return chunk;
+    }
+}
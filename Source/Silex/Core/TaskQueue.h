@@ -1,12 +1,18 @@
-
 #pragma once
 #include "Core/Memory.h"
+#include <atomic>
+#include <mutex>
 
 
 //==================================================================
 // デリゲートクラスではバッファが固定サイズで、ラムダ式のキャプチャが多くなった際に
 // サイズが足りなくなるため、可変長サイズな関数オブジェクトを受け取って実行する
 // キュークラス
+//------------------------------------------------------------------
+// ・チャンク単位で確保し、容量が足りなくなれば次のチャンクを追加する
+// ・Enqueue は複数スレッドから同時に呼び出し可能（チャンク内の領域をアトミックに予約する）
+// ・Execute は Enqueue と並行して呼び出し可能だが、実行側は1スレッドに限る
+//   （実行中に追加されたタスクは次回の実行に回される）
 //==================================================================
 namespace Silex
 {
@@ -22,25 +28,19 @@ namespace Silex
     {
     public:
 
-        void Initialize(uint64 allocateByteSize = 1024 * 1024) // 1MB
-        {
-            buffer         = (byte*)Memory::Malloc(allocateByteSize);
-            insertLocation = buffer;
+        // タスク配置のアライメント
+        static constexpr uint64 taskAlignment = 16;
 
-            std::memset(buffer, 0, allocateByteSize);
-        }
+    public:
 
-        void Release()
-        {
-            if (buffer)
-            {
-                Execute();
-
-                Memory::Free(buffer);
-                buffer         = nullptr;
-                insertLocation = nullptr;
-            }
-        }
+        TaskQueue()  = default;
+        ~TaskQueue() { Release(); }
+
+        TaskQueue(const TaskQueue&)            = delete;
+        TaskQueue& operator=(const TaskQueue&) = delete;
+
+        void Initialize(uint64 chunkSize = 64 * 1024); // 64KB
+        void Release();
 
         //****************************************
         // 右辺値参照のみ受け取る
@@ -53,10 +53,15 @@ namespace Silex
         template<typename Func>
         void Enqueue(const char* taskName, Func&& fn)
         {
-            Memory::Construct<Task<Func>>(insertLocation, taskName, fn);
+            using TaskType = Task<std::remove_cvref_t<Func>>;
+            static_assert(alignof(TaskType) <= taskAlignment, "タスクのアライメントが大きすぎます");
+
+            constexpr uint64 size = (sizeof(TaskType) + taskAlignment - 1) & ~(taskAlignment - 1);
 
-            insertLocation += sizeof(Task<Func>);
-            taskCount++;
+            Reservation reservation = _Reserve(size);
+
+            Memory::Construct<TaskType>(reservation.ptr, taskName, (uint32)size, Traits::Forward<Func>(fn));
+            _Commit(reservation, size);
         }
 
         template<typename Func>
@@ -65,22 +70,11 @@ namespace Silex
             static_assert(sizeof(Func) == 0, "コピーを避けるために、右辺値が渡されることを期待します");
         }
 
-        void Execute()
-        {
-            byte* ptr = buffer;
+        // 積まれたタスクを投入順に呼び出しスレッドで実行する
+        void Execute();
 
-            for (uint32 i = 0; i < taskCount; i++)
-            {
-                ITask* task = reinterpret_cast<ITask*>(ptr);
-                task->Execute();
-                ptr += task->GetSize();
-
-                Memory::Destruct(task);
-            }
-
-            insertLocation = buffer;
-            taskCount      = 0;
-        }
+        // 前回の実行以降にタスクが追加されたか
+        bool IsEmpty() const;
 
     private:
 
@@ -92,35 +86,87 @@ namespace Silex
         //===========================================
         struct ITask
         {
+            ITask(const char* name, uint32 size)
+                : name(name)
+                , size(size)
+            {}
+
             virtual ~ITask() {}
+            virtual void Execute() = 0;
 
-            virtual void        Execute() const = 0;
-            virtual uint32      GetSize() const = 0;
-            virtual const char* GetName() const = 0;
+            const char* name;
+            uint32      size;
         };
 
         template <Callable Functor>
         struct Task : ITask
         {
-            Functor     func;
-            uint32      size;
-            const char* name;
+            Functor func;
 
-            Task(const char* name, Functor fn)
-                : func(Traits::Forward<Functor>(fn))
-                , size(sizeof(Task))
-                , name(name)
+            template<typename F>
+            Task(const char* name, uint32 size, F&& fn)
+                : ITask(name, size)
+                , func(Traits::Forward<F>(fn))
             {}
 
-            void        Execute() const override { std::invoke(func); }
-            uint32      GetSize() const override { return size;       }
-            const char* GetName() const override { return name;       }
+            void Execute() override { std::invoke(func); }
         };
 
+        //===========================================
+        // タスク格納チャンク
+        //-------------------------------------------
+        // reserved : 予約済みバイト数（容量を超えた予約は失敗として次のチャンクへ）
+        // committed: 構築が完了したバイト数（成功した予約は先頭から連続するので、実行範囲となる）
+        //===========================================
+        struct alignas(taskAlignment) Chunk
+        {
+            std::atomic<uint64> reserved  = 0;
+            std::atomic<uint64> committed = 0;
+            uint64              capacity  = 0;
+            Chunk*              next      = nullptr;
+
+            // タスク領域はヘッダの直後に続く
+            byte* GetData() { return reinterpret_cast<byte*>(this + 1); }
+        };
+
+        //===========================================
+        // チャンクリスト
+        //-------------------------------------------
+        // 投入側と実行側で2つのリストを交互に使用し、実行中のリストへは追加されないようにする
+        // 実行後もチャンクは解放せずに再利用する
+        //===========================================
+        struct ChunkList
+        {
+            Chunk*              head    = nullptr;
+            std::atomic<Chunk*> current = nullptr;
+            std::atomic<uint32> writers = 0;
+            std::mutex          growMutex;
+        };
+
+        // 予約した領域（構築完了後に _Commit で公開する）
+        struct Reservation
+        {
+            ChunkList* list  = nullptr;
+            Chunk*     chunk = nullptr;
+            byte*      ptr   = nullptr;
+        };
+
+    private:
+
+        Reservation _Reserve(uint64 size);
+        void        _Commit(const Reservation& reservation, uint64 size);
+        void        _Grow(ChunkList& list, Chunk* full, uint64 size);
+
+        // 投入先を切り替えて、それまでの投入先リストの書き込み完了を待つ
+        ChunkList& _SwapList();
+        void       _ResetList(ChunkList& list);
+
+        Chunk* _AllocateChunk(uint64 capacity);
+
     private:
 
-        byte*  buffer         = nullptr;
-        byte*  insertLocation = nullptr;
-        uint32 taskCount      = 0;
+        ChunkList           lists[2];
+        std::atomic<uint32> epoch         = 0;
+        uint64              chunkByteSize = 0;
     };
 }
@@ -1,55 +1,321 @@
 
 #include "PCH.h"
 #include "ThreadPool.h"
+#include "Core/Profiler.h"
 
 
 namespace Silex
 {
+    namespace Internal
+    {
+        struct Job
+        {
+            Task              task;
+            TaskCounter*      counter = nullptr;
+            CancellationToken token;
+        };
+
+        // 優先度・キューの種類を問わず、ジョブを受け付けるミューテックス付きキュー
+        class LockedQueue
+        {
+        public:
+
+            void Push(Job* job)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push_back(job);
+                count.fetch_add(1, std::memory_order_release);
+            }
+
+            Job* Pop()
+            {
+                if (count.load(std::memory_order_acquire) == 0)
+                    return nullptr;
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (queue.empty())
+                    return nullptr;
+
+                Job* job = queue.front();
+                queue.pop_front();
+                count.fetch_sub(1, std::memory_order_release);
+
+                return job;
+            }
+
+            // 現時点で積まれているジョブをすべて取り出す
+            void PopAll(std::deque<Job*>& out)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                out.swap(queue);
+                count.store(0, std::memory_order_release);
+            }
+
+            bool IsEmpty() const { return count.load(std::memory_order_acquire) == 0; }
+
+        private:
+
+            std::mutex          mutex;
+            std::deque<Job*>    queue;
+            std::atomic<uint32> count = 0;
+        };
+
+        //==================================================================================
+        // Chase-Lev ワークスティーリング両端キュー
+        // https://www.di.ens.fr/~zappa/readings/ppopp13.pdf (Correct and Efficient Work-Stealing for Weak Memory Models)
+        //----------------------------------------------------------------------------------
+        // Push / Pop は所有スレッドのみ (bottom 側)、Steal は他スレッドから (top 側) 呼び出される
+        // 容量を超えた場合は Push が失敗するので、呼び出し側でグローバルキューに退避させる
+        //==================================================================================
+        class WorkQueue
+        {
+        public:
+
+            static constexpr int64 capacity = 4096;
+            static constexpr int64 mask     = capacity - 1;
+
+            bool Push(Job* job)
+            {
+                int64 b = bottom.load(std::memory_order_relaxed);
+                int64 t = top.load(std::memory_order_acquire);
+
+                if (b - t >= capacity) SL_UNLIKELY
+                    return false;
+
+                buffer[b & mask].store(job, std::memory_order_relaxed);
+                bottom.store(b + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            Job* Pop()
+            {
+                int64 b = bottom.load(std::memory_order_relaxed) - 1;
+                bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64 t = top.load(std::memory_order_relaxed);
+
+                if (t > b)
+                {
+                    // 空だった
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                Job* job = buffer[b & mask].load(std::memory_order_relaxed);
+
+                // 最後の1要素は Steal と競合するので CAS で取り合う
+                if (t == b)
+                {
+                    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                        job = nullptr;
+
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                }
+
+                return job;
+            }
+
+            Job* Steal()
+            {
+                int64 t = top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64 b = bottom.load(std::memory_order_acquire);
+
+                if (t >= b)
+                    return nullptr;
+
+                Job* job = buffer[t & mask].load(std::memory_order_relaxed);
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    return nullptr;
+
+                return job;
+            }
+
+        private:
+
+            // top と bottom は別スレッドから書き込まれるので、キャッシュラインを分ける
+            alignas(64) std::atomic<int64> top    = 0;
+            alignas(64) std::atomic<int64> bottom = 0;
+            alignas(64) std::array<std::atomic<Job*>, capacity> buffer = {};
+        };
+    }
+
+    using Internal::Job;
+    using Internal::WorkQueue;
+    using Internal::LockedQueue;
+
+
+    static constexpr uint32 priorityCount = (uint32)TaskPriority::Count;
+
+    // ブロッキング I/O 専用スレッド数
+    static constexpr uint32 ioThreadCount = 2;
+
+    // スレッドインデックス: メインスレッド = 0, ワーカースレッド = 1 ~ threadCount
+    static constexpr uint32 invalidThreadIndex = UINT32_MAX;
+    thread_local uint32     threadIndex        = invalidThreadIndex;
+
     static uint32                   threadCount        = 0;
     static std::atomic<uint32>      workingThreadCount = 0;
-    static std::mutex               taskMutex;
-    static std::condition_variable  condition;
+    static std::atomic<bool>        isStopping         = false;
     static std::vector<std::thread> threads;
-    static std::deque<Task>         taskQueue;
-    static bool                     isStopping;
+    static std::vector<std::thread> ioThreads;
+
+    // スレッド・優先度ごとのキュー (queueCount = threadCount + 1, インデックス = スレッド * priorityCount + 優先度)
+    static std::unique_ptr<WorkQueue[]> queues;
+    static uint32                       queueCount = 0;
+
+    // キューを持たないスレッドからの投入 / キュー溢れ時の退避先
+    static LockedQueue globalQueues[priorityCount];
 
-    thread_local uint32        threadID        = 0;
-    static std::atomic<uint32> threadIDCounter = 0;
+    // メインスレッド専用キュー
+    static LockedQueue mainThreadQueue;
 
-    //--------------------------------------------------------------------------------
-    // std::condition_variable::wait()
-    //--------------------------------------------------------------------------------
-    // 条件が指定されているなら、満たされるまで(whileでビジーループ)
-    // そうでないならなら、notify_one() / notify_all() が呼び出されるまで 待機する
-    //--------------------------------------------------------------------------------
+    // I/O スレッド専用キュー
+    static LockedQueue             ioQueue;
+    static std::mutex              ioWakeMutex;
+    static std::condition_variable ioWakeCondition;
 
-    static void ThreadLoop()
+    // 待機中スレッドを起こすためのシグナル (タスク追加・カウンターの完了・メインスレッドキューへの追加ごとに値が変わる)
+    // アイドル状態のワーカーと Wait 中のスレッドは、どちらもこのシグナルで待機する
+    static std::atomic<uint32> wakeSignal = 0;
+
+    // Wait 中のスレッド数 (0 なら、カウンター完了時の notify_all を省略する)
+    static std::atomic<uint32> waitingThreadCount = 0;
+
+    // Wait 中のスレッドを全て起こす
+    static void WakeWaitingThreads()
     {
-        threadID = threadIDCounter++;
-        SL_LOG_DEBUG("Invoke Thread[{}]", threadID);
+        wakeSignal.fetch_add(1, std::memory_order_seq_cst);
 
-        while (true)
+        if (waitingThreadCount.load(std::memory_order_seq_cst) != 0)
+            wakeSignal.notify_all();
+    }
+
+    void Internal::NotifyCounterCompleted()
+    {
+        WakeWaitingThreads();
+    }
+
+    // 全タスクの完了待ち用
+    static TaskCounter allTaskCounter;
+
+    // ジョブはワーカー間で生成・破棄されるので、スレッドごとにキャッシュを持つアロケータから確保する
+    // （生成スレッドと異なるワーカーでの解放は、生成スレッドのリモート解放キューに戻る）
+    static ConcurrentPagedAllocator<Job> jobAllocator;
+
+
+    static WorkQueue& GetQueue(uint32 thread, uint32 priority)
+    {
+        return queues[thread * priorityCount + priority];
+    }
+
+    Job* ThreadPool::_CreateJob(Task&& task, TaskCounter* counter, const CancellationToken& token)
+    {
+        Job* job = jobAllocator.Alloc();
+        job->task    = std::move(task);
+        job->counter = counter;
+        job->token   = token;
+
+        if (counter)
+            counter->Increment();
+
+        allTaskCounter.Increment();
+
+        return job;
+    }
+
+    void ThreadPool::_RunJob(Job* job)
+    {
+        // キャンセル済みのタスクは実行せず、完了扱いにする
+        if (!job->token.IsCancelled())
+            job->task();
+
+        TaskCounter* counter = job->counter;
+        jobAllocator.Free(job);
+
+        if (counter)
+            counter->Decrement();
+
+        allTaskCounter.Decrement();
+    }
+
+    static Job* FindJob()
+    {
+        const uint32 self = threadIndex;
+
+        // 優先度の高いレーンから探索する
+        for (uint32 priority = 0; priority < priorityCount; priority++)
         {
-            Task task;
+            // 自身のキュー (LIFO)
+            if (self < queueCount)
+            {
+                if (Job* job = GetQueue(self, priority).Pop())
+                    return job;
+            }
+
+            // グローバルキュー
+            if (Job* job = globalQueues[priority].Pop())
+                return job;
 
+            // 他スレッドのキューから盗む (FIFO)
+            const uint32 start = self < queueCount? self : 0;
+            for (uint32 i = 1; i <= queueCount; i++)
             {
-                std::unique_lock<std::mutex> lock(taskMutex);
+                uint32 victim = (start + i) % queueCount;
+                if (victim == self)
+                    continue;
+
+                if (Job* job = GetQueue(victim, priority).Steal())
+                    return job;
+            }
+        }
+
+        return nullptr;
+    }
 
-                // タスクが空の場合は wait する
-                while (!isStopping && taskQueue.empty())
-                    condition.wait(lock);
+    static void ThreadLoop(uint32 index)
+    {
+        threadIndex = index;
+        SL_LOG_DEBUG("Invoke Thread[{}]", threadIndex);
+
+        Profiler::SetThreadName(std::format("Worker {}", threadIndex));
+
+        while (true)
+        {
+            // タスク探索前にシグナル値を取得しておくことで、探索中に追加されたタスクの通知を取りこぼさない
+            uint32 signal = wakeSignal.load(std::memory_order_acquire);
+
+            if (ThreadPool::ExecuteOneTask())
+                continue;
 
-                if (isStopping && taskQueue.empty())
-                    return;
+            if (isStopping.load(std::memory_order_acquire))
+                return;
+
+            // シグナル値が変わるまで待機
+            wakeSignal.wait(signal, std::memory_order_acquire);
+        }
+    }
+
+    void ThreadPool::_IOThreadLoop(uint32 index)
+    {
+        SL_LOG_DEBUG("Invoke IO Thread[{}]", index);
 
-                task = taskQueue.front();
-                taskQueue.pop_front();
+        Profiler::SetThreadName(std::format("IO {}", index));
+
+        while (true)
+        {
+            if (Job* job = ioQueue.Pop())
+            {
+                _RunJob(job);
+                continue;
             }
 
-            // タスク実行
-            workingThreadCount++;
-            task();
-            workingThreadCount--;
+            std::unique_lock<std::mutex> lock(ioWakeMutex);
+            ioWakeCondition.wait(lock, [] { return !ioQueue.IsEmpty() || isStopping.load(std::memory_order_acquire); });
+
+            if (ioQueue.IsEmpty() && isStopping.load(std::memory_order_acquire))
+                return;
         }
     }
 
@@ -60,17 +326,22 @@ namespace Silex
         //---------------------------
 
         isStopping  = false;
-        threadCount = std::thread::hardware_concurrency() - 1;
+        threadIndex = 0;
+
+        // hardware_concurrency は取得できない場合 0 を返すので、最低1スレッドは確保する
+        threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+        queueCount  = threadCount + 1;
+        queues      = std::make_unique<WorkQueue[]>(queueCount * priorityCount);
 
         // スレッドループを予約
         for (uint32 i = 0; i < threadCount; i++)
         {
-            threads.emplace_back(std::thread(&Silex::ThreadLoop));
-            
-            while (!threads[i].joinable())
-            {
-                break;
-            }
+            threads.emplace_back(&Silex::ThreadLoop, i + 1);
+        }
+
+        for (uint32 i = 0; i < ioThreadCount; i++)
+        {
+            ioThreads.emplace_back(&ThreadPool::_IOThreadLoop, i);
         }
     }
 
@@ -82,71 +353,179 @@ namespace Silex
 
         // 実行中のタスクを完了させる
         WaitAll();
-        taskQueue.clear();
+
+        // 終了フラグを立てて、全ての待機スレッドを起動
+        isStopping.store(true, std::memory_order_release);
+        wakeSignal.fetch_add(1, std::memory_order_release);
+        wakeSignal.notify_all();
 
         {
-            // 終了フラグを立てる
-            std::unique_lock<std::mutex> lock(taskMutex);
-            isStopping = true;
+            std::lock_guard<std::mutex> lock(ioWakeMutex);
+            ioWakeCondition.notify_all();
         }
 
-        // 全ての wait スレッド起動
-        condition.notify_all();
-
         // 全スレッドが終了するまで待機
         for (auto& thread : threads)
             thread.join();
 
+        for (auto& thread : ioThreads)
+            thread.join();
+
         threads.clear();
+        ioThreads.clear();
+        queues.reset();
+        queueCount = 0;
     }
 
-    void ThreadPool::AddTask(Task&& task)
+    void ThreadPool::AddTask(Task&& task, TaskCounter* counter, TaskPriority priority, const CancellationToken& token)
     {
-        //---------------------------
-        // SL_ASSERT(IsMainThread());
-        //---------------------------
+        SL_ASSERT(priority < TaskPriority::Count);
 
+        Job* job = _CreateJob(std::move(task), counter, token);
+        const uint32 lane = (uint32)priority;
+
+        // 自身のキューに追加 (キューを持たないスレッド・容量超過時はグローバルキューへ)
+        const uint32 self = threadIndex;
+        if (self >= queueCount || !GetQueue(self, lane).Push(job))
         {
-            // キューにタスクを追加
-            std::unique_lock<std::mutex> lock(taskMutex);
-            taskQueue.emplace_back(std::bind(std::forward<Task>(task)));
+            globalQueues[lane].Push(job);
         }
 
         // 待機中のスレッドを1つだけ起動させる
-        condition.notify_one();
+        wakeSignal.fetch_add(1, std::memory_order_release);
+        wakeSignal.notify_one();
     }
 
-    void ThreadPool::WaitAll()
+    void ThreadPool::AddMainThreadTask(Task&& task, TaskCounter* counter, const CancellationToken& token)
     {
-        //---------------------------
-        // SL_ASSERT(IsMainThread());
-        //---------------------------
-        while (HasRunningTask())
+        Job* job = _CreateJob(std::move(task), counter, token);
+        mainThreadQueue.Push(job);
+
+        // Wait 中のメインスレッドを起こす
+        WakeWaitingThreads();
+    }
+
+    void ThreadPool::AddIOTask(Task&& task, TaskCounter* counter, const CancellationToken& token)
+    {
+        Job* job = _CreateJob(std::move(task), counter, token);
+        ioQueue.Push(job);
+
+        // 待機判定とのすれ違いを防ぐため、ロックを取得してから通知する
+        std::lock_guard<std::mutex> lock(ioWakeMutex);
+        ioWakeCondition.notify_one();
+    }
+
+    bool ThreadPool::ExecuteOneTask()
+    {
+        Job* job = FindJob();
+        if (!job)
+            return false;
+
+        // ワーカースレッドのみを稼働数としてカウントする
+        const bool isWorker = threadIndex != 0 && threadIndex != invalidThreadIndex;
+
+        // タスク実行
+        if (isWorker) workingThreadCount++;
+        _RunJob(job);
+        if (isWorker) workingThreadCount--;
+
+        return true;
+    }
+
+    void ThreadPool::ExecuteMainThreadTasks()
+    {
+        SL_ASSERT(IsMainThread());
+
+        std::deque<Job*> jobs;
+        mainThreadQueue.PopAll(jobs);
+
+        for (Job* job : jobs)
+            _RunJob(job);
+    }
+
+    void ThreadPool::Wait(TaskCounter& counter)
+    {
+        const bool isMainThread = IsMainThread();
+
+        // 一定回数はタスク探索を続け、それでも完了しない場合はスレッドプールのシグナルを待つ
+        // （カウンター自体では待機しない。完了直後に破棄されうるため、通知側はカウンターに触れられない）
+        // 待機中もタスクの追加で起こされるので、入れ子の Wait でもワーカーはタスクを実行し続ける
+        const uint32 maxSpinCount = 64;
+        uint32       spinCount    = 0;
+
+        waitingThreadCount.fetch_add(1, std::memory_order_seq_cst);
+
+        while (true)
         {
-            OS::Get()->Sleep(16);
+            // 確認より前に値を読んでおき、確認後の追加・完了を取りこぼさない
+            const uint32 signal = wakeSignal.load(std::memory_order_seq_cst);
+
+            if (counter.IsCompleted())
+                break;
+
+            // メインスレッドキューのタスクを待っている可能性があるので、メインスレッドでは先に消化する
+            if (isMainThread)
+            {
+                if (Job* job = mainThreadQueue.Pop())
+                {
+                    _RunJob(job);
+                    spinCount = 0;
+                    continue;
+                }
+            }
+
+            if (ExecuteOneTask())
+            {
+                spinCount = 0;
+                continue;
+            }
+
+            if (spinCount++ < maxSpinCount)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // タスクの追加・カウンターの完了・メインスレッドキューへの追加でシグナルの値が変わるまで待機
+            wakeSignal.wait(signal, std::memory_order_seq_cst);
+            spinCount = 0;
         }
-    }
 
+        waitingThreadCount.fetch_sub(1, std::memory_order_seq_cst);
+    }
 
+    void ThreadPool::WaitAll()
+    {
+        Wait(allTaskCounter);
+    }
 
+    bool ThreadPool::IsMainThread()
+    {
+        return threadIndex == 0;
+    }
 
     uint32 ThreadPool::GetThreadCount()
-    { 
+    {
         return threadCount;
     }
 
+    uint32 ThreadPool::GetIOThreadCount()
+    {
+        return (uint32)ioThreads.size();
+    }
+
     uint32 ThreadPool::GetWorkingThreadCount()
-    { 
+    {
         return workingThreadCount;
     }
 
     uint32 ThreadPool::GetIdleThreadCount()
-    { 
+    {
         return threadCount - workingThreadCount;
     }
 
     bool ThreadPool::HasRunningTask()
-    { 
-        return GetIdleThreadCount() != GetThreadCount();
+    {
+        return !allTaskCounter.IsCompleted();
     }
 }
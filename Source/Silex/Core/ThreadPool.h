@@ -1,13 +1,127 @@
-
 #pragma once
 #include "Core/CoreType.h"
 #include <functional>
+#include <atomic>
+#include <memory>
 
 
 namespace Silex
 {
     using Task = std::function<void()>;
 
+    namespace Internal
+    {
+        struct Job;
+    }
+
+    //==================================================================
+    // タスクの優先度
+    //------------------------------------------------------------------
+    // ワーカーは優先度の高いレーンから順にタスクを探索する
+    //==================================================================
+    enum class TaskPriority : uint8
+    {
+        High,       // フレーム処理に必要なタスク
+        Normal,     // 通常のタスク
+        Background, // サムネイル生成・インポートなど、遅延しても問題ないタスク
+
+        Count,
+    };
+
+
+    namespace Internal
+    {
+        // Wait 中のスレッドを起こす（カウンター自体には触れない）
+        void NotifyCounterCompleted();
+    }
+
+
+    //==================================================================
+    // タスク完了待ちカウンター
+    //------------------------------------------------------------------
+    // AddTask 時にインクリメントされ、タスク完了時にデクリメントされる
+    // ThreadPool::Wait に渡すと、0 になるまで呼び出しスレッドもタスクを実行する
+    //
+    // 0 になった直後に待機側が戻ってカウンターを破棄する可能性があるので
+    // 最後のデクリメント以降はカウンターに触れず、スレッドプール側のシグナルで通知する
+    //==================================================================
+    class TaskCounter
+    {
+    public:
+
+        TaskCounter()                              = default;
+        TaskCounter(const TaskCounter&)            = delete;
+        TaskCounter& operator=(const TaskCounter&) = delete;
+
+        bool   IsCompleted() const { return count.load(std::memory_order_acquire) == 0; }
+        uint32 GetCount()    const { return count.load(std::memory_order_acquire);      }
+
+    private:
+
+        void Increment() { count.fetch_add(1, std::memory_order_relaxed); }
+        void Decrement()
+        {
+            if (count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Internal::NotifyCounterCompleted();
+        }
+
+        std::atomic<uint32> count = 0;
+
+        friend class ThreadPool;
+        friend class TaskGraph;
+    };
+
+
+    //==================================================================
+    // 協調的キャンセル
+    //------------------------------------------------------------------
+    // CancellationSource::Cancel 後は、そのトークンを持つ未実行タスクは実行されずに完了扱いとなる
+    // 実行中のタスクは IsCancelled を確認して自ら中断する必要がある
+    //==================================================================
+    class CancellationToken
+    {
+    public:
+
+        CancellationToken() = default;
+
+        bool IsCancelled() const { return state && state->load(std::memory_order_acquire); }
+        bool IsValid()     const { return state != nullptr; }
+
+    private:
+
+        explicit CancellationToken(const std::shared_ptr<std::atomic<bool>>& s) : state(s) {}
+
+        std::shared_ptr<std::atomic<bool>> state;
+
+        friend class CancellationSource;
+    };
+
+    class CancellationSource
+    {
+    public:
+
+        CancellationSource() : state(std::make_shared<std::atomic<bool>>(false)) {}
+
+        void Cancel()            { state->store(true, std::memory_order_release); }
+        bool IsCancelled() const { return state->load(std::memory_order_acquire); }
+
+        CancellationToken GetToken() const { return CancellationToken(state); }
+
+    private:
+
+        std::shared_ptr<std::atomic<bool>> state;
+    };
+
+
+    //==================================================================
+    // ワークスティーリング スレッドプール
+    //------------------------------------------------------------------
+    // 各ワーカー（メインスレッドを含む）が優先度ごとにロックフリーな両端キューを持ち
+    // 自身のキューが空になると、他スレッドのキューからタスクを盗んで実行する
+    //
+    // ・メインスレッドキュー: Engine::MainLoop の先頭でまとめて実行される
+    // ・I/O キュー          : ブロッキング処理専用スレッドで実行され、ワーカーを占有しない
+    //==================================================================
     class ThreadPool
     {
     public:
@@ -15,13 +129,34 @@ namespace Silex
         static void Initialize();
         static void Finalize();
 
-        static void AddTask(Task&& task);
+        static void AddTask(Task&& task, TaskCounter* counter = nullptr, TaskPriority priority = TaskPriority::Normal, const CancellationToken& token = {});
+        static void AddMainThreadTask(Task&& task, TaskCounter* counter = nullptr, const CancellationToken& token = {});
+        static void AddIOTask(Task&& task, TaskCounter* counter = nullptr, const CancellationToken& token = {});
+
+        // カウンターが 0 になるまで、呼び出しスレッドもタスクを実行しながら待機する
+        static void Wait(TaskCounter& counter);
         static void WaitAll();
 
+        // キューからタスクを1つ取り出して実行する（実行するタスクがなければ false）
+        static bool ExecuteOneTask();
+
+        // メインスレッドキューに積まれたタスクを実行する（実行中に追加されたタスクは次回に持ち越す）
+        static void ExecuteMainThreadTasks();
+
+        // Initialize を呼び出したスレッドであるか
+        static bool IsMainThread();
+
         static uint32 GetThreadCount();
+        static uint32 GetIOThreadCount();
         static uint32 GetWorkingThreadCount();
         static uint32 GetIdleThreadCount();
         static bool   HasRunningTask();
+
+    private:
+
+        static Internal::Job* _CreateJob(Task&& task, TaskCounter* counter, const CancellationToken& token);
+        static void           _RunJob(Internal::Job* job);
+        static void           _IOThreadLoop(uint32 index);
     };
 }
 
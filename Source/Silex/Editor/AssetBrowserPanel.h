@@ -18,6 +18,9 @@ namespace Silex
     {
     public:
 
+        // エディターのメインスレッドでのみ扱うので、参照カウントは非アトミックで良い
+        static constexpr bool atomicRefCount = false;
+
         AssetBrowserItem(AssetItemType type, AssetID id, const std::string& name)
             : m_Type(type)
             , m_ID(id)
@@ -52,6 +55,8 @@ namespace Silex
 
     struct DirectoryNode : Object
     {
+        static constexpr bool atomicRefCount = false;
+
         Ref<DirectoryNode>                              ParentDirectory;
         std::unordered_map<AssetID, Ref<DirectoryNode>> ChildDirectory;
 
@@ -2,6 +2,8 @@
 #include "PCH.h"
 #include "ConsoleLogger.h"
 
+#include <imgui/imgui.h>
+
 
 namespace Silex
 {
@@ -11,4 +13,175 @@ namespace Silex
     {
         return s_ConsoleLogger;
     }
-}
\ No newline at end of file
+
+    static ImVec4 GetLogLevelColor(LogLevel level)
+    {
+        switch (level)
+        {
+            case LogLevel::Fatal : return ImVec4(0.8f, 0.0f, 0.8f, 1.0f);
+            case LogLevel::Error : return ImVec4(0.8f, 0.2f, 0.2f, 1.0f);
+            case LogLevel::Warn  : return ImVec4(0.8f, 0.6f, 0.0f, 1.0f);
+            case LogLevel::Info  : return ImVec4(0.0f, 0.6f, 0.0f, 1.0f);
+            case LogLevel::Trace : return ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
+            case LogLevel::Debug : return ImVec4(0.0f, 0.5f, 0.8f, 1.0f);
+
+            default: return ImVec4(1, 1, 1, 1);
+        }
+    }
+
+    void ConsoleLogger::Write(const LogMessage& message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // 最初の書き込みで確保する（エディターを使わない場合に領域を持たない）
+        if (textArena.empty())
+        {
+            textArena.resize(textArenaSize);
+            entries.Reset(maxLineCount);
+
+            for (Ring<uint32>& index : levelIndices)
+                index.Reset(maxLineCount);
+        }
+
+        // 2 行目以降は、レベル表記と同じ幅だけ字下げする
+        const std::string_view prefix = Logger::GetLevelPrefix(message.level);
+        const std::string_view indent = std::string_view("                ").substr(0, prefix.size());
+
+        std::string_view text  = message.text;
+        bool             first = true;
+
+        while (true)
+        {
+            const uint64 newline = text.find('\n');
+            _PushLine(message.level, first ? prefix : indent, text.substr(0, newline));
+
+            if (newline == std::string_view::npos || newline + 1 == text.size())
+                break;
+
+            text.remove_prefix(newline + 1);
+            first = false;
+        }
+    }
+
+    void ConsoleLogger::SetCapacity(uint64 maxLineCount, uint64 textArenaSize)
+    {
+        SL_ASSERT(maxLineCount > 0 && maxLineCount <= UINT32_MAX);
+        SL_ASSERT(textArenaSize > 0);
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        this->maxLineCount  = maxLineCount;
+        this->textArenaSize = textArenaSize;
+
+        // 次の書き込みで確保し直す
+        textArena         = {};
+        textWritePosition = 0;
+        entries           = {};
+
+        for (Ring<uint32>& index : levelIndices)
+            index = {};
+    }
+
+    void ConsoleLogger::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        textWritePosition = 0;
+        entries.Clear();
+
+        for (Ring<uint32>& index : levelIndices)
+            index.Clear();
+    }
+
+    void ConsoleLogger::LevelFilter()
+    {
+        static const char* levelNames[] = { "Fatal", "Error", "Warn", "Info", "Trace", "Debug" };
+        static_assert(std::size(levelNames) == levelCount);
+
+        int32 level = (int32)displayLevel;
+
+        ImGui::SetNextItemWidth(100.0f);
+        if (ImGui::Combo("##LogLevel", &level, levelNames, levelCount))
+            displayLevel = (LogLevel)level;
+
+        ImGui::SameLine();
+        ImGui::Checkbox("Auto Scroll", &autoScroll);
+    }
+
+    void ConsoleLogger::LogData()
+    {
+        ImGui::BeginChild("ScrollingRegion", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            // 書き込みスレッドを止めるのは、表示範囲の行を描画する間だけ
+            const Ring<uint32>& index = levelIndices[(uint64)displayLevel];
+
+            ImGuiListClipper clipper;
+            clipper.Begin((int32)index.count);
+
+            while (clipper.Step())
+            {
+                for (int32 i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                {
+                    const LogEntry& entry = entries.data[index[i]];
+                    const char*     text  = textArena.data() + entry.offset % textArenaSize;
+
+                    ImGui::PushStyleColor(ImGuiCol_Text, GetLogLevelColor(entry.level));
+                    ImGui::TextUnformatted(text, text + entry.length);
+                    ImGui::PopStyleColor();
+                }
+            }
+
+            clipper.End();
+        }
+
+        // 最下部を表示している場合のみ追従する（遡って読んでいる間は動かさない）
+        if (autoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
+            ImGui::SetScrollHereY(1.0f);
+
+        ImGui::EndChild();
+    }
+
+    void ConsoleLogger::_PushLine(LogLevel level, std::string_view prefix, std::string_view line)
+    {
+        const uint64 length = std::min<uint64>(prefix.size() + line.size(), textArenaSize);
+
+        // テキスト領域の末尾をまたぐ場合は、残りを捨てて先頭から書き込む
+        uint64 offset = textWritePosition;
+        if (offset % textArenaSize + length > textArenaSize)
+            offset += textArenaSize - offset % textArenaSize;
+
+        const uint64 end = offset + length;
+
+        // 行数の上限を超える行と、本文が上書きされる行を古い順に捨てる
+        while (entries.count > 0 && (entries.IsFull() || entries.Front().offset + textArenaSize < end))
+            _PopFrontEntry();
+
+        char*        dest       = textArena.data() + offset % textArenaSize;
+        const uint64 prefixSize = std::min<uint64>(prefix.size(), length);
+
+        std::memcpy(dest, prefix.data(), prefixSize);
+        std::memcpy(dest + prefixSize, line.data(), length - prefixSize);
+
+        textWritePosition = end;
+
+        const uint32 slot = (uint32)entries.GetTail();
+        entries.PushBack({ offset, (uint32)length, level });
+
+        for (uint64 i = (uint64)level; i < levelCount; i++)
+            levelIndices[i].PushBack(slot);
+    }
+
+    void ConsoleLogger::_PopFrontEntry()
+    {
+        // 最も古い行は、その行を含む全てのインデックスでも先頭にある
+        const LogLevel level = entries.Front().level;
+
+        for (uint64 i = (uint64)level; i < levelCount; i++)
+            levelIndices[i].PopFront();
+
+        entries.PopFront();
+    }
+}
@@ -1,80 +1,94 @@
 #pragma once
 
 #include "Core/Core.h"
-#include <imgui/imgui.h>
 
 
 namespace Silex
 {
-    class ConsoleLogger
+    //==================================================================
+    // エディターのコンソールウィンドウ
+    // ログの書き込みスレッドから追加され、UI スレッドから描画される
+    //------------------------------------------------------------------
+    // ・行はリングバッファに保持し、本文は 1 つの連続したテキスト領域（こちらもリング）に書き込む
+    //   （行ごとの文字列確保は無く、上限を超えた古い行から上書きされる）
+    // ・重要度ごとに「そのレベル以上の行」のインデックスを持つので、フィルター後の i 行目を O(1) で引ける
+    // ・描画は ImGuiListClipper で表示範囲の行だけを処理する
+    // ・複数行のメッセージは 1 行ずつに分割する（行の高さを揃え、クリッパーの計算を正確にする）
+    //==================================================================
+    class ConsoleLogger : public LogSink
     {
     public:
 
+        static constexpr uint64 defaultMaxLineCount  = 256 * 1024;
+        static constexpr uint64 defaultTextArenaSize = 32 * 1024 * 1024;
+
         static ConsoleLogger& Get();
 
-        void Log(LogLevel level, const std::string& message)
-        {
-            std::lock_guard<std::mutex> lock(mutex);
+        void Write(const LogMessage& message) override;
 
-            // 一定サイズなら、先頭要素を消す
-            if (logEntries.size() > maxLogEntory)
-                logEntries.pop_front();
+        // 保持する行数とテキスト領域のサイズを変更する（保持していたログは消える）
+        void SetCapacity(uint64 maxLineCount, uint64 textArenaSize);
 
-            LogEntry entry;
-            entry.level = level;
-            entry.text  = message;
+        void Clear();
 
-            logEntries.emplace_back(entry);
-        }
+        // 表示する重要度の選択
+        void LevelFilter();
 
-        void Clear()
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            logEntries.clear();
-        }
-
-        void LogData()
-        {
-            ImGui::BeginChild("ScrollingRegion", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
-
-            for (auto& entry : logEntries)
-            {
-                ImVec4 color;
-                
-                switch(entry.level)
-                {
-                    case LogLevel::Fatal : color = ImVec4(0.8f, 0.0f, 0.8f, 1.0f); break;
-                    case LogLevel::Error : color = ImVec4(0.8f, 0.2f, 0.2f, 1.0f); break;
-                    case LogLevel::Warn  : color = ImVec4(0.8f, 0.6f, 0.0f, 1.0f); break;
-                    case LogLevel::Info  : color = ImVec4(0.0f, 0.6f, 0.0f, 1.0f); break;
-                    case LogLevel::Trace : color = ImVec4(0.5f, 0.5f, 0.5f, 1.0f); break;
-                    case LogLevel::Debug : color = ImVec4(0.0f, 0.5f, 0.8f, 1.0f); break;
-                
-                    default: color = ImVec4(1, 1, 1, 1); break;
-                }
-
-                ImGui::PushStyleColor(ImGuiCol_Text, color);
-                ImGui::Text("%s", entry.text.c_str());
-                ImGui::PopStyleColor();
-            }
-
-            ImGui::EndChild();
-        }
+        // ログの描画
+        void LogData();
 
     private:
 
         struct LogEntry
         {
-            std::string text;
-            LogLevel    level;
+            uint64   offset; // テキスト領域の通算位置（テキスト領域のサイズで割った余りが実際の位置）
+            uint32   length;
+            LogLevel level;
         };
 
+        // 固定容量のリングバッファ（満杯かどうかは呼び出し側が管理する）
+        template<typename T>
+        struct Ring
+        {
+            std::vector<T> data;
+            uint64         head  = 0;
+            uint64         count = 0;
+
+            void Reset(uint64 capacity) { data.assign(capacity, T{}); head = 0; count = 0; }
+            void Clear()                { head = 0; count = 0; }
+
+            bool   IsFull()  const { return count == data.size(); }
+            uint64 GetTail() const { return (head + count) % data.size(); }
+
+            const T& Front()                 const { return data[head]; }
+            const T& operator[](uint64 index) const { return data[(head + index) % data.size()]; }
+
+            void PushBack(const T& value) { data[GetTail()] = value; count++; }
+            void PopFront()               { head = (head + 1) % data.size(); count--; }
+        };
+
+        void _PushLine(LogLevel level, std::string_view prefix, std::string_view line);
+        void _PopFrontEntry();
+
     private:
 
-        const uint64 maxLogEntory = 1024;
+        static constexpr uint64 levelCount = (uint64)LogLevel::Count;
+
+        uint64 maxLineCount  = defaultMaxLineCount;
+        uint64 textArenaSize = defaultTextArenaSize;
+
+        // 本文（LogEntry::offset から length バイト、折り返しをまたがない）
+        std::vector<char> textArena;
+        uint64            textWritePosition = 0;
 
-        std::deque<LogEntry> logEntries;
-        std::mutex           mutex;
+        Ring<LogEntry> entries;
+
+        // levelIndices[L] は、重要度が L 以上（値が L 以下）の行の entries 上のスロット番号
+        Ring<uint32> levelIndices[levelCount];
+
+        LogLevel displayLevel = LogLevel::Debug;
+        bool     autoScroll   = true;
+
+        std::mutex mutex;
     };
 }
-
@@ -5,7 +5,7 @@
 #include "Editor/ConsoleLogger.h"
 #include "Editor/EditorSplashImage.h"
 
-#include "Core/Timer.h"
+#include "Core/Profiler.h"
 #include "Core/Random.h"
 #include "Core/Engine.h"
 #include "Rendering/Renderer.h"
@@ -31,8 +31,9 @@ namespace Silex
 
         assetBrowserPanel.Initialize();
 
-        // シーンレンダラー初期化
-        //sceneRenderer.Init();
+        // 描画スレッドは前フレームのスナップショットを描画するので、初回フレーム用に1つ確定させておく
+        scene->Update(0.0f, editorCamera, sceneRenderer.GetSimulationData());
+        sceneRenderer.Swap();
 
         INIT_PROCESS("Editor Init", 100.0f);
         OS::Get()->Sleep(500);
@@ -52,7 +53,14 @@ namespace Silex
         HandleInput(deltaTime);
         editorCamera.Update(deltaTime);
 
-        scene->Update(deltaTime, editorCamera, &sceneRenderer);
+        // 数フレーム前に要求したオブジェクトID の読み取り結果を反映する
+        int32 readbackID = -1;
+        if (Renderer::Get()->GetObjectIDReadback(readbackID))
+        {
+            ApplyViewportSelection(readbackID);
+        }
+
+        scene->Update(deltaTime, editorCamera, sceneRenderer.GetSimulationData());
     }
 
     void Editor::UpdateUI()
@@ -114,6 +122,7 @@ namespace Silex
                     ImGui::MenuItem("プロパティ",       nullptr, &showProperty);
                     ImGui::MenuItem("マテリアル",       nullptr, &showMaterial);
                     ImGui::MenuItem("アセットブラウザ",  nullptr, &showAssetBrowser);
+                    ImGui::MenuItem("メモリ",          nullptr, &showMemory);
                     ImGui::EndMenu();
                 }
 
@@ -129,6 +138,9 @@ namespace Silex
         // アセットブラウザ
         assetBrowserPanel.Render(&showAssetBrowser, &showMaterial);
 
+        // メモリ統計
+        memoryStatsPanel.Render(&showMemory);
+
         if (showScene)
         {
             ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
@@ -229,9 +241,12 @@ namespace Silex
         {
             ImGui::Begin("アウトプットログ", &showLogger, usingCameraFlag);
 
+            ConsoleLogger::Get().LevelFilter();
+            ImGui::SameLine();
+
             // Clear ボタンを右寄せするための計算
             float buttonWidth = 100.0f;
-            float spacingFromRightEdge = ImGui::GetWindowContentRegionMax().x - buttonWidth - 20;
+            float spacingFromRightEdge = ImGui::GetContentRegionAvail().x - buttonWidth - ImGui::GetStyle().ItemSpacing.x * 2;
 
             if (spacingFromRightEdge > 0)
                 ImGui::Dummy(ImVec2(spacingFromRightEdge, 0.0f));  // 空のスペースを追加してボタンを右に移動
@@ -268,18 +283,7 @@ namespace Silex
 
             ImGui::SeparatorText("");
 
-            for (const auto& [profile, time] : Engine::Get()->GetPerformanceData())
-            {
-                ImGui::Text("%-*s %.2f ms", 32, profile, time);
-            }
-
-            // メモリー使用量
-            //ImGui::SeparatorText("");
-            //auto status = PoolAllocator::GetStatus();
-            //for (uint32 i = 0; i < status.size(); i++)
-            //{
-            //    ImGui::Text("メモリプール[%4d byte]:%6d / %6d Block", 32 << i, status[i].TotalAllocated / (32 << i), status[i].TotalSize / (32 << i));
-            //}
+            profilerPanel.Render();
 
             ImGui::End();
         }
@@ -319,7 +323,7 @@ namespace Silex
             // オブジェクト選択
             if (Input::IsMouseButtonReleased(Mouse::Left) && !usingManipulater && hoveredViewport)
             {
-                // SelectViewportEntity();
+                SelectViewportEntity();
             }
 
             if (Input::IsKeyDown(Keys::LeftControl))
@@ -370,6 +374,11 @@ namespace Silex
         return &editorCamera;
     }
 
+    SceneRenderer* Editor::GetSceneRenderer()
+    {
+        return &sceneRenderer;
+    }
+
     bool Editor::IsUsingEditorCamera() const
     {
         return usingEditorCamera;
@@ -387,13 +396,20 @@ namespace Silex
         glm::ivec2 diff        = viewportPos - windowPos;
         glm::ivec2 mousediff   = mouse - diff;
 
+        // 描画中の Gバッファ を読み取らないように、描画フレームに読み取りを記録させて結果は後で受け取る
         if (mousediff.x >= 0 && mousediff.y >= 0)
         {
-            selectionID = Renderer::Get()->ReadPixelObjectID(mousediff.x, mousediff.y);
-            SL_LOG_DEBUG("Clicked: EntityID({}) : (x, y) = {}, {}", selectionID, mousediff.x, mousediff.y);
+            Renderer::Get()->RequestObjectIDReadback(mousediff.x, mousediff.y);
         }
+    }
 
-        if (selectionID >= 0)
+    void Editor::ApplyViewportSelection(int32 entityID)
+    {
+        selectionID = entityID;
+        SL_LOG_DEBUG("Clicked: EntityID({})", selectionID);
+
+        // 結果を受け取るまでの間にエンティティが削除されている可能性がある
+        if (selectionID >= 0 && scene->IsValidEntity((entt::entity)selectionID))
         {
             activeGizmoForcus = true;
 
@@ -431,6 +447,9 @@ namespace Silex
         currentSceneName = currentScenePath.stem().string();
 
         Window::Get()->SetTitle(("Silex - " + currentSceneName).c_str());
+
+        // 前のシーンで使用していたページを返却する
+        PoolAllocator::Trim();
     }
 
     void Editor::SaveScene(bool bForceSaveAs)
@@ -481,6 +500,9 @@ namespace Silex
         currentSceneName = "名称未指定";
 
         Window::Get()->SetTitle(("Silex - " + currentSceneName).c_str());
+
+        // 前のシーンで使用していたページを返却する
+        PoolAllocator::Trim();
     }
 
     // シーンアウトライナーでエンティティがクリックされた時のイベント
@@ -8,6 +8,8 @@
 #include "Scene/SceneRenderer.h"
 #include "Editor/ScenePropertyPanel.h"
 #include "Editor/AssetBrowserPanel.h"
+#include "Editor/MemoryStatsPanel.h"
+#include "Editor/ProfilerPanel.h"
 
 #include <imgui/imgui.h>
 #include <imguizmo/ImGuizmo.h>
@@ -41,7 +43,8 @@ namespace Silex
     public:
 
         const std::filesystem::path& GetAssetDirectory() const { return assetDirectory; }
-        Camera* GetEditorCamera();
+        Camera*        GetEditorCamera();
+        SceneRenderer* GetSceneRenderer();
 
         bool IsUsingEditorCamera() const;
 
@@ -54,6 +57,7 @@ namespace Silex
         void SaveSceneAs();
 
         void SelectViewportEntity();
+        void ApplyViewportSelection(int32 entityID);
         void HandleInput(float deltaTime);
 
     private:
@@ -79,6 +83,8 @@ namespace Silex
         // パネル
         ScenePropertyPanel scenePropertyPanel;
         AssetBrowserPanel  assetBrowserPanel;
+        MemoryStatsPanel   memoryStatsPanel;
+        ProfilerPanel      profilerPanel;
 
         std::filesystem::path assetDirectory = "Assets/";
 
@@ -99,5 +105,6 @@ namespace Silex
         bool showStats        = true;
         bool showMaterial     = true;
         bool showAssetBrowser = true;
+        bool showMemory       = false;
     };
 }
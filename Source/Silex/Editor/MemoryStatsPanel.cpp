@@ -0,0 +1,149 @@
+
+#include "PCH.h"
+
+#include "Editor/MemoryStatsPanel.h"
+
+#include <imgui/imgui.h>
+
+
+namespace Silex
+{
+    namespace Internal
+    {
+        static float ToKiloByte(int64 byte)
+        {
+            return (float)byte / 1024.0f;
+        }
+
+        // "…\Silex\Rendering\Renderer.cpp" → "Renderer.cpp"
+        static const char* GetFileName(const char* path)
+        {
+            const char* name = path;
+            for (const char* c = path; *c; c++)
+            {
+                if (*c == '\\' || *c == '/')
+                    name = c + 1;
+            }
+
+            return name;
+        }
+    }
+
+
+    void MemoryStatsPanel::Render(bool* showMemoryPannel)
+    {
+        if (!*showMemoryPannel)
+            return;
+
+        ImGui::Begin("メモリ", showMemoryPannel);
+
+        DrawSummary();
+        DrawTagStats();
+        DrawCallsiteStats();
+
+        ImGui::End();
+    }
+
+    void MemoryStatsPanel::DrawSummary()
+    {
+        ImGui::Text("使用中: %.1f KB", Internal::ToKiloByte(MemoryTracker::GetLiveBytes()));
+        ImGui::Text("ピーク: %.1f KB", Internal::ToKiloByte(MemoryTracker::GetPeakBytes()));
+
+        int32 sampleRate = MemoryTracker::GetSampleRate();
+        if (ImGui::InputInt("サンプリング間隔", &sampleRate))
+            MemoryTracker::SetSampleRate((uint32)std::max(sampleRate, 1));
+
+        if (ImGui::Button("未使用ページを解放"))
+            PoolAllocator::Trim();
+
+        // メモリープール使用量
+        ImGui::SeparatorText("メモリプール");
+
+        auto status = PoolAllocator::GetStatus();
+        for (uint32 i = 0; i < MemoryPool::numSizeClass; i++)
+        {
+            const uint64 blockSize = status[i].chunkSize;
+            ImGui::Text("[%6llu byte]: %6llu / %6llu Block", blockSize, status[i].totalAllocated / blockSize, status[i].totalSize / blockSize);
+        }
+
+        const MemoryPoolStatus& huge = status[MemoryPool::hugePoolIndex];
+        ImGui::Text("[巨大確保   ]: %.1f / %.1f KB", Internal::ToKiloByte(huge.totalAllocated), Internal::ToKiloByte(huge.totalSize));
+    }
+
+    void MemoryStatsPanel::DrawTagStats()
+    {
+        ImGui::SeparatorText("サブシステム");
+
+        MemoryTracker::GetTagStats(tagStats);
+
+        const ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+        if (ImGui::BeginTable("MemoryTagStats", 4, tableFlags))
+        {
+            ImGui::TableSetupColumn("タグ", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("使用中 (KB)");
+            ImGui::TableSetupColumn("ピーク (KB)");
+            ImGui::TableSetupColumn("確保/フレーム");
+            ImGui::TableHeadersRow();
+
+            for (const MemoryTagStats& stats : tagStats)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%.*s", (int32)stats.tag.size(), stats.tag.data());
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", Internal::ToKiloByte(stats.liveBytes));
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", Internal::ToKiloByte(stats.peakBytes));
+                ImGui::TableNextColumn(); ImGui::Text("%llu",  stats.frameAllocations);
+            }
+
+            ImGui::EndTable();
+        }
+    }
+
+    void MemoryStatsPanel::DrawCallsiteStats()
+    {
+        ImGui::SeparatorText("呼び出し箇所");
+
+        MemoryTracker::GetCallsiteStats(callsiteStats);
+
+        // 使用量の多い順
+        std::sort(callsiteStats.begin(), callsiteStats.end(), [](const MemoryCallsiteStats& a, const MemoryCallsiteStats& b)
+        {
+            return a.liveBytes > b.liveBytes;
+        });
+
+        const ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable("MemoryCallsiteStats", 7, tableFlags))
+        {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("型", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("タグ");
+            ImGui::TableSetupColumn("使用中 (KB)");
+            ImGui::TableSetupColumn("ピーク (KB)");
+            ImGui::TableSetupColumn("個数");
+            ImGui::TableSetupColumn("確保/フレーム");
+            ImGui::TableSetupColumn("場所");
+            ImGui::TableHeadersRow();
+
+            ImGuiListClipper clipper;
+            clipper.Begin((int32)callsiteStats.size());
+
+            while (clipper.Step())
+            {
+                for (int32 i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                {
+                    const MemoryCallsiteStats& stats = callsiteStats[i];
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::TextUnformatted(stats.desc);
+                    ImGui::TableNextColumn(); ImGui::Text("%.*s", (int32)stats.tag.size(), stats.tag.data());
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", Internal::ToKiloByte(stats.liveBytes));
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", Internal::ToKiloByte(stats.peakBytes));
+                    ImGui::TableNextColumn(); ImGui::Text("%lld", stats.liveCount);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", stats.frameAllocations);
+                    ImGui::TableNextColumn(); ImGui::Text("%s(%u)", Internal::GetFileName(stats.file), stats.line);
+                }
+            }
+
+            ImGui::EndTable();
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "Core/Memory.h"
+
+
+namespace Silex
+{
+    //==================================================================
+    // メモリ統計パネル
+    //------------------------------------------------------------------
+    // MemoryTracker の呼び出し箇所・サブシステムごとの統計と、メモリープールの使用量を表示する
+    //==================================================================
+    class MemoryStatsPanel
+    {
+    public:
+
+        MemoryStatsPanel()  = default;
+        ~MemoryStatsPanel() = default;
+
+        // 描画
+        void Render(bool* showMemoryPannel);
+
+    private:
+
+        void DrawSummary();
+        void DrawTagStats();
+        void DrawCallsiteStats();
+
+    private:
+
+        // 毎フレーム取得するので、容量を使い回す
+        std::vector<MemoryCallsiteStats> callsiteStats;
+        std::vector<MemoryTagStats>      tagStats;
+    };
+}
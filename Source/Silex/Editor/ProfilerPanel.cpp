@@ -0,0 +1,257 @@
+
+#include "PCH.h"
+
+#include "Editor/ProfilerPanel.h"
+#include "Rendering/Renderer.h"
+
+#include <imgui/imgui.h>
+
+
+namespace Silex
+{
+    namespace Internal
+    {
+        static float ToMilliSecond(uint64 nanoSecond)
+        {
+            return (float)((double)nanoSecond / 1'000'000.0);
+        }
+
+        // ゾーン名（文字列リテラルのアドレス）ごとに色を固定する
+        static ImU32 GetZoneColor(const char* name)
+        {
+            const uint64 hash = Internal::MixHash64((uint64)name);
+            const float  hue  = (float)(hash % 1024) / 1024.0f;
+
+            return ImColor::HSV(hue, 0.5f, 0.75f);
+        }
+    }
+
+
+    void ProfilerPanel::Render()
+    {
+        bool paused = Profiler::IsPaused();
+        if (ImGui::Checkbox("一時停止", &paused))
+        {
+            Profiler::SetPaused(paused);
+        }
+
+        ImGui::SameLine();
+
+        if (ImGui::Button("Chrome Trace 出力"))
+        {
+            if (Profiler::ExportChromeTrace(traceFilePath))
+                SL_LOG_INFO("プロファイル結果を出力しました: {}", traceFilePath);
+        }
+
+        const int32 frameCount = (int32)Profiler::GetFrameCount();
+        if (frameCount > 0)
+        {
+            // 記録中は常に直近のフレームを表示する
+            if (paused)
+            {
+                ImGui::SliderInt("フレーム (n フレーム前)", &selectedFrame, 0, frameCount - 1);
+            }
+
+            selectedFrame = paused ? std::clamp(selectedFrame, 0, frameCount - 1) : 0;
+
+            const ProfileFrame& frame = Profiler::GetFrame(selectedFrame);
+            ImGui::Text("Frame %llu: %.2f ms", frame.frameNumber, Internal::ToMilliSecond(frame.end - frame.begin));
+
+            DrawTimeline(frame);
+            DrawZoneSummary(frame);
+        }
+
+        // GPU の計測結果は一時停止の影響を受けず、CPU のフレーム履歴の有無に関わらず表示する
+        DrawGPUPasses();
+    }
+
+    void ProfilerPanel::DrawTimeline(const ProfileFrame& frame)
+    {
+        ImGui::SeparatorText("タイムライン");
+
+        threads = Profiler::GetThreads();
+
+        // スレッドごとの入れ子の深さから、各スレッドの表示行の位置を決める（ゾーンの無いスレッドは表示しない）
+        threadDepths.assign(threads.size() + 1, 0);
+
+        for (const ProfileEvent& event : frame.events)
+        {
+            if (event.threadIndex < threadDepths.size())
+                threadDepths[event.threadIndex] = std::max(threadDepths[event.threadIndex], event.depth + 1);
+        }
+
+        const float rowHeight  = ImGui::GetTextLineHeightWithSpacing();
+        const float labelWidth = 80.0f;
+        const float width      = std::max(ImGui::GetContentRegionAvail().x, labelWidth + 1.0f);
+
+        float height = 0.0f;
+        threadOffsets.assign(threads.size() + 1, 0.0f);
+
+        for (const ProfileThreadInfo& thread : threads)
+        {
+            if (threadDepths[thread.threadIndex] == 0)
+                continue;
+
+            threadOffsets[thread.threadIndex] = height;
+            height += threadDepths[thread.threadIndex] * rowHeight + ImGui::GetStyle().ItemSpacing.y;
+        }
+
+        if (height == 0.0f)
+            return;
+
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImGui::InvisibleButton("##ProfilerTimeline", ImVec2(width, height));
+
+        const bool   hovered = ImGui::IsItemHovered();
+        const ImVec2 mouse   = ImGui::GetMousePos();
+
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+        for (const ProfileThreadInfo& thread : threads)
+        {
+            if (threadDepths[thread.threadIndex] != 0)
+                drawList->AddText(ImVec2(origin.x, origin.y + threadOffsets[thread.threadIndex]), ImGui::GetColorU32(ImGuiCol_Text), thread.name.c_str());
+        }
+
+        // フレームの区間を、ラベルを除いた幅に合わせる（前フレームから続くゾーンは左端で切る）
+        const float  left  = origin.x + labelWidth;
+        const float  right = origin.x + width;
+        const double scale = (right - left) / (double)std::max<uint64>(frame.end - frame.begin, 1);
+
+        const ProfileEvent* hoveredEvent = nullptr;
+
+        drawList->PushClipRect(ImVec2(left, origin.y), ImVec2(right, origin.y + height), true);
+
+        for (const ProfileEvent& event : frame.events)
+        {
+            if (event.threadIndex >= threadOffsets.size())
+                continue;
+
+            const float x0 = std::max(left, left + (float)(((int64)event.begin - (int64)frame.begin) * scale));
+            const float x1 = std::min(right, std::max(x0 + 1.0f, left + (float)(((int64)event.end - (int64)frame.begin) * scale)));
+            const float y0 = origin.y + threadOffsets[event.threadIndex] + event.depth * rowHeight;
+            const float y1 = y0 + rowHeight - 1.0f;
+
+            drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), Internal::GetZoneColor(event.name));
+
+            // 名前が収まる幅のゾーンのみ、ゾーン内に名前を表示する
+            if (x1 - x0 > ImGui::CalcTextSize(event.name).x + 4.0f)
+                drawList->AddText(ImVec2(x0 + 2.0f, y0), IM_COL32(0, 0, 0, 255), event.name);
+
+            if (hovered && mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1)
+                hoveredEvent = &event;
+        }
+
+        drawList->PopClipRect();
+
+        if (hoveredEvent)
+        {
+            ImGui::BeginTooltip();
+            ImGui::Text("%s", hoveredEvent->name);
+            ImGui::Text("%.3f ms", Internal::ToMilliSecond(hoveredEvent->end - hoveredEvent->begin));
+            ImGui::EndTooltip();
+        }
+    }
+
+    void ProfilerPanel::DrawZoneSummary(const ProfileFrame& frame)
+    {
+        ImGui::SeparatorText("ゾーン");
+
+        zoneSummaries.clear();
+        zoneSummaryIndices.clear();
+
+        for (const ProfileEvent& event : frame.events)
+        {
+            auto [it, inserted] = zoneSummaryIndices.try_emplace(event.name, (uint32)zoneSummaries.size());
+            if (inserted)
+                zoneSummaries.push_back({ event.name, 0, 0 });
+
+            ZoneSummary& summary = zoneSummaries[it->second];
+            summary.totalTime += event.end - event.begin;
+            summary.count++;
+        }
+
+        // 合計時間の長い順
+        std::sort(zoneSummaries.begin(), zoneSummaries.end(), [](const ZoneSummary& a, const ZoneSummary& b)
+        {
+            return a.totalTime > b.totalTime;
+        });
+
+        const ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+        if (ImGui::BeginTable("ProfilerZoneSummary", 3, tableFlags))
+        {
+            ImGui::TableSetupColumn("ゾーン", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("合計 (ms)");
+            ImGui::TableSetupColumn("回数");
+            ImGui::TableHeadersRow();
+
+            for (const ZoneSummary& summary : zoneSummaries)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%s",   summary.name);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", Internal::ToMilliSecond(summary.totalTime));
+                ImGui::TableNextColumn(); ImGui::Text("%u",   summary.count);
+            }
+
+            ImGui::EndTable();
+        }
+    }
+
+    void ProfilerPanel::DrawGPUPasses()
+    {
+        ImGui::SeparatorText("GPU パス");
+
+        Renderer* renderer = Renderer::Get();
+        if (!renderer->IsGPUTimingSupported())
+        {
+            ImGui::TextDisabled("タイムスタンプクエリ非対応");
+            return;
+        }
+
+        bool useStatistics = renderer->IsPipelineStatisticsEnabled();
+
+        ImGui::BeginDisabled(!renderer->IsPipelineStatisticsSupported());
+        if (ImGui::Checkbox("パイプライン統計", &useStatistics))
+        {
+            renderer->SetPipelineStatisticsEnabled(useStatistics);
+        }
+        ImGui::EndDisabled();
+
+        const std::vector<GPUPassTiming>& timings = renderer->GetGPUPassTimings();
+        ImGui::Text("GPU: %.2f ms", renderer->GetGPUFrameTime());
+
+        const int32 columnCount = useStatistics? 5 : 2;
+
+        const ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+        if (ImGui::BeginTable("ProfilerGPUPasses", columnCount, tableFlags))
+        {
+            ImGui::TableSetupColumn("パス", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("時間 (ms)");
+
+            if (useStatistics)
+            {
+                ImGui::TableSetupColumn("頂点シェーダー");
+                ImGui::TableSetupColumn("プリミティブ");
+                ImGui::TableSetupColumn("フラグメントシェーダー");
+            }
+
+            ImGui::TableHeadersRow();
+
+            for (const GPUPassTiming& timing : timings)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%s",   timing.name);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", timing.time);
+
+                if (useStatistics)
+                {
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", timing.vertexInvocations);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", timing.clippingPrimitives);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", timing.fragmentInvocations);
+                }
+            }
+
+            ImGui::EndTable();
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Core/Profiler.h"
+#include "Core/FlatHashMap.h"
+
+
+namespace Silex
+{
+    //==================================================================
+    // プロファイラーパネル
+    //------------------------------------------------------------------
+    // 統計ウィンドウ内に、選択したフレームのスレッドごとのタイムラインと、ゾーンごとの合計時間を表示する
+    // 一時停止中は、履歴から表示するフレームを選択できる
+    // GPU のパスごとの時間は、履歴を持たず直近に完了したフレームの値を表示する
+    //==================================================================
+    class ProfilerPanel
+    {
+    public:
+
+        ProfilerPanel()  = default;
+        ~ProfilerPanel() = default;
+
+        // 描画（呼び出し側のウィンドウ内に描画する）
+        void Render();
+
+    private:
+
+        void DrawTimeline(const ProfileFrame& frame);
+        void DrawZoneSummary(const ProfileFrame& frame);
+        void DrawGPUPasses();
+
+    private:
+
+        struct ZoneSummary
+        {
+            const char* name;
+            uint64      totalTime;
+            uint32      count;
+        };
+
+        static constexpr const char* traceFilePath = "Logs/Trace.json";
+
+        int32 selectedFrame = 0; // 何フレーム前か
+
+        // 毎フレーム取得するので、容量を使い回す
+        std::vector<ProfileThreadInfo>   threads;
+        std::vector<uint32>              threadDepths;
+        std::vector<float>               threadOffsets;
+        std::vector<ZoneSummary>         zoneSummaries;
+        FlatHashMap<const char*, uint32> zoneSummaryIndices;
+    };
+}
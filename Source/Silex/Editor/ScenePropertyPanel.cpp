@@ -133,15 +133,21 @@ namespace Silex
             float pos = ImGui::GetCursorPosX();
             ImGui::SetCursorPosX(pos - 15.0f);
 
-            char buffer[256];
+            // StringID のテーブルは解放されないので、入力途中の文字列は登録しない
             auto& tag = instance.name;
-            memset(buffer, 0, sizeof(buffer));
-            strncpy_s(buffer, sizeof(buffer), tag.c_str(), sizeof(buffer));
+            if (!editingName)
+            {
+                memset(nameBuffer, 0, sizeof(nameBuffer));
+                strncpy_s(nameBuffer, sizeof(nameBuffer), tag.c_str(), sizeof(nameBuffer));
+            }
 
             ImGui::PushItemWidth(windowWidth - 15.0f);
 
-            if (ImGui::InputText("##Tag", buffer, sizeof(buffer)))
-                tag = std::string(buffer);
+            ImGui::InputText("##Tag", nameBuffer, sizeof(nameBuffer));
+            editingName = ImGui::IsItemActive();
+
+            if (ImGui::IsItemDeactivatedAfterEdit())
+                tag = StringID(nameBuffer);
 
             ImGui::PopItemWidth();
         }
@@ -211,7 +217,7 @@ namespace Silex
 
                     std::string meshName = {};
                     if (component.mesh)
-                        meshName = component.mesh->GetName();
+                        meshName = component.mesh->GetName().GetString();
 
                     if (ImGui::Button(meshName.c_str(), ImVec2(w, 0.0f)))
                         ImGui::OpenPopup("##MeshPopup");
@@ -282,7 +288,7 @@ namespace Silex
                     std::string materialName = "None";
                     if (material)
                     {
-                        materialName = material->GetName();
+                        materialName = material->GetName().GetString();
                     }
 
                     std::string indexID = std::to_string(index);
@@ -353,7 +359,7 @@ namespace Silex
             std::string skyName = {};
 
             if (component.sky)
-                skyName = component.sky->GetName();
+                skyName = component.sky->GetName().GetString();
 
             ImGui::Dummy({ 0, 4.0f });
             ImGui::Columns(2);
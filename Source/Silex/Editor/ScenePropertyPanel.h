@@ -45,5 +45,9 @@ namespace Silex
 
         Ref<Scene> scene;
         Entity     selectEntity;
+
+        // 名前の編集中は入力途中の文字列を保持し、確定時にのみ StringID に登録する
+        char nameBuffer[256] = {};
+        bool editingName     = false;
     };
 }
@@ -224,8 +224,8 @@ namespace Silex
         context.text[TextType::VersionInfo]     = L"1.0";
         context.text[TextType::StartupProgress] = L"Initialize...";
 
-        // SplashScreen スレッド開始
-        ThreadPool::AddTask(&SplashScreenThread);
+        // SplashScreen スレッド開始 (メッセージループでブロックするので、ワーカーではなく I/O スレッドで実行する)
+        ThreadPool::AddIOTask(&SplashScreenThread);
     }
 
     void EditorSplashImage::Hide()
@@ -3,6 +3,7 @@
 
 #include "Rendering/Mesh.h"
 #include "Rendering/Renderer.h"
+#include "Core/Parallel.h"
 #include "Asset/TextureReader.h"
 
 
@@ -28,7 +29,7 @@ namespace Silex
     //===========================================
     // 頂点データから生成
     //===========================================
-    MeshSource::MeshSource(std::vector<Vertex>& vertices, std::vector<uint32>& indices, uint32 materialIndex)
+    MeshSource::MeshSource(std::span<Vertex> vertices, std::span<uint32> indices, uint32 materialIndex)
         : vertexCount(vertices.size())
         , indexCount(indices.size())
         , hasIndex(!indices.empty())
@@ -95,7 +96,9 @@ namespace Silex
         }
 
         // 各メッシュ情報を読み込み
-        ProcessNode(scene->mRootNode, scene, assetPath);
+        // 頂点・インデックスの一時配列は GPU バッファ生成後に不要になるので、インポート用のアリーナから確保する
+        ArenaMemoryResource arena(4 * 1024 * 1024); // 4MB
+        ProcessNode(scene->mRootNode, scene, assetPath, &arena);
 
         // マテリアル数
         numMaterialSlot = scene->mNumMaterials;
@@ -115,36 +118,41 @@ namespace Silex
         subMeshes.push_back(source);
     }
 
-    void Mesh::ProcessNode(aiNode* node, const aiScene* scene, const std::string& path)
+    void Mesh::ProcessNode(aiNode* node, const aiScene* scene, const std::string& path, ArenaMemoryResource* arena)
     {
         for (uint32 i = 0; i < node->mNumMeshes; i++)
         {
             uint32 subMeshIndex = node->mMeshes[i];
             aiMesh* mesh = scene->mMeshes[subMeshIndex];
 
-            MeshSource* ms = ProcessMesh(mesh, scene, path);
+            MeshSource* ms = ProcessMesh(mesh, scene, path, arena);
             ms->relativeTransform = Internal::aiMatrixToGLMMatrix(node->mTransformation);
 
+            // 一時配列は破棄済みなので、アリーナのブロックを次のメッシュで再利用する
+            arena->Reset();
+
             subMeshes.emplace_back(ms);
         }
 
         for (uint32 i = 0; i < node->mNumChildren; i++)
         {
-            ProcessNode(node->mChildren[i], scene, path);
+            ProcessNode(node->mChildren[i], scene, path, arena);
         }
     }
     
-    MeshSource* Mesh::ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& path)
+    MeshSource* Mesh::ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& path, ArenaMemoryResource* arena)
     {
-        std::vector<Vertex> vertices;
-        std::vector<uint32> indices;
+        std::pmr::vector<Vertex> vertices(arena);
+        std::pmr::vector<uint32> indices(arena);
 
         //==============================================
         // 頂点
         //==============================================
-        for (uint32 i = 0; i < mesh->mNumVertices; i++)
+        vertices.resize(mesh->mNumVertices);
+
+        ParallelFor(0, mesh->mNumVertices, [&](uint64 i)
         {
-            Vertex vertex;
+            Vertex& vertex = vertices[i];
             glm::vec3 vector;
 
             // 座標
@@ -192,19 +200,36 @@ namespace Silex
             {
                 vertex.TexCoords = glm::vec2(0.0f, 0.0f);
             }
-
-            vertices.push_back(vertex);
-        }
+        });
 
         //==============================================
         // インデックス
         //==============================================
-        for (uint32 i = 0; i < mesh->mNumFaces; i++)
+        if (mesh->mPrimitiveTypes == aiPrimitiveType_TRIANGLE)
         {
-            aiFace face = mesh->mFaces[i];
-            for (uint32 j = 0; j < face.mNumIndices; j++)
+            // 三角形のみで構成されている場合は、書き込み位置が確定するので並列に処理できる
+            indices.resize((uint64)mesh->mNumFaces * 3);
+
+            ParallelFor(0, mesh->mNumFaces, [&](uint64 i)
+            {
+                const aiFace& face = mesh->mFaces[i];
+                indices[i * 3 + 0] = face.mIndices[0];
+                indices[i * 3 + 1] = face.mIndices[1];
+                indices[i * 3 + 2] = face.mIndices[2];
+            });
+        }
+        else
+        {
+            // アリーナは再確保前の領域を解放しないので、三角形を想定して予め確保しておく
+            indices.reserve((uint64)mesh->mNumFaces * 3);
+
+            for (uint32 i = 0; i < mesh->mNumFaces; i++)
             {
-                indices.push_back(face.mIndices[j]);
+                aiFace face = mesh->mFaces[i];
+                for (uint32 j = 0; j < face.mNumIndices; j++)
+                {
+                    indices.push_back(face.mIndices[j]);
+                }
             }
         }
 
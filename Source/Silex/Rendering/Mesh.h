@@ -3,10 +3,12 @@
 #include "Asset/Asset.h"
 #include "Rendering/RenderingCore.h"
 #include "Rendering/Material.h"
+#include "Core/MemoryResource.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
+#include <span>
 
 
 namespace Silex
@@ -38,7 +40,7 @@ namespace Silex
     public:
 
         MeshSource(uint64 numVertex, Vertex* vertices, uint64 numIndex, uint32* indices, uint32 materialIndex = 0);
-        MeshSource(std::vector<Vertex>& vertices, std::vector<uint32>& indices, uint32 materialIndex = 0);
+        MeshSource(std::span<Vertex> vertices, std::span<uint32> indices, uint32 materialIndex = 0);
         ~MeshSource();
 
         void Bind()   const;
@@ -110,8 +112,8 @@ namespace Silex
 
     private:
 
-        void        ProcessNode(aiNode* node, const aiScene* scene, const std::string& path);
-        MeshSource* ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& path);
+        void        ProcessNode(aiNode* node, const aiScene* scene, const std::string& path, ArenaMemoryResource* arena);
+        MeshSource* ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& path, ArenaMemoryResource* arena);
         void        LoadMaterialTextures(uint32 materialInddex, aiMaterial* mat, aiTextureType type, const std::string& path);
 
     private:
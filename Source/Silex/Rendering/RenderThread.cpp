@@ -0,0 +1,113 @@
+
+#include "PCH.h"
+#include "Rendering/RenderThread.h"
+#include "Core/Profiler.h"
+
+#include <mutex>
+#include <condition_variable>
+
+
+namespace Silex
+{
+    static std::thread             renderThread;
+    static std::thread::id         renderThreadID;
+    static std::mutex              renderMutex;
+    static std::condition_variable kickCondition;
+    static std::condition_variable completeCondition;
+
+    static Task pendingTask;
+    static bool isBusy     = false;
+    static bool isStopping = false;
+
+
+    static void RenderThreadLoop()
+    {
+        SL_LOG_DEBUG("Invoke Render Thread");
+
+        Profiler::SetThreadName("Render");
+
+        while (true)
+        {
+            Task task;
+
+            {
+                std::unique_lock<std::mutex> lock(renderMutex);
+                kickCondition.wait(lock, [] { return pendingTask || isStopping; });
+
+                if (!pendingTask && isStopping)
+                    return;
+
+                task = std::move(pendingTask);
+                pendingTask = nullptr;
+            }
+
+            task();
+
+            {
+                std::lock_guard<std::mutex> lock(renderMutex);
+                isBusy = false;
+            }
+
+            completeCondition.notify_all();
+        }
+    }
+
+    void RenderThread::Initialize()
+    {
+        isStopping     = false;
+        isBusy         = false;
+        renderThread   = std::thread(&RenderThreadLoop);
+        renderThreadID = renderThread.get_id();
+    }
+
+    void RenderThread::Finalize()
+    {
+        Wait();
+
+        {
+            std::lock_guard<std::mutex> lock(renderMutex);
+            isStopping = true;
+        }
+
+        kickCondition.notify_all();
+
+        if (renderThread.joinable())
+            renderThread.join();
+
+        renderThreadID = {};
+    }
+
+    void RenderThread::Kick(Task&& task)
+    {
+        SL_ASSERT(!IsRenderThread());
+
+        {
+            std::lock_guard<std::mutex> lock(renderMutex);
+            SL_ASSERT(!isBusy);
+
+            pendingTask = std::move(task);
+            isBusy      = true;
+        }
+
+        kickCondition.notify_one();
+    }
+
+    void RenderThread::Wait()
+    {
+        SL_ASSERT(!IsRenderThread());
+
+        std::unique_lock<std::mutex> lock(renderMutex);
+        completeCondition.wait(lock, [] { return !isBusy; });
+    }
+
+    bool RenderThread::IsBusy()
+    {
+        std::lock_guard<std::mutex> lock(renderMutex);
+        return isBusy;
+    }
+
+    bool RenderThread::IsRenderThread()
+    {
+        return std::this_thread::get_id() == renderThreadID;
+    }
+}
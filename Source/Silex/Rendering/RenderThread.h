@@ -0,0 +1,35 @@
+#pragma once
+#include "Core/ThreadPool.h"
+
+
+namespace Silex
+{
+    //==================================================================
+    // 描画スレッド
+    //------------------------------------------------------------------
+    // フレーム N の描画コマンド記録を専用スレッドで行い、その間にメインスレッドで
+    // フレーム N+1 のシミュレーションを進める
+    //
+    // ワーカースレッドで実行すると、メインスレッドの ThreadPool::Wait に盗まれて
+    // シミュレーションと直列化される可能性があるので、スレッドプールとは独立させている
+    //==================================================================
+    class RenderThread
+    {
+    public:
+
+        static void Initialize();
+        static void Finalize();
+
+        // 描画タスクを投入する（同時に保持できるのは1つのみ。前回のタスクは Wait で完了させておくこと）
+        static void Kick(Task&& task);
+
+        // 投入した描画タスクの完了まで待機する
+        static void Wait();
+
+        // 描画タスクが実行中（または実行待ち）であるか
+        static bool IsBusy();
+
+        // 呼び出しスレッドが描画スレッドであるか
+        static bool IsRenderThread();
+    };
+}
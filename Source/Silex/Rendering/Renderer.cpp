@@ -3,12 +3,14 @@
 
 #include "Core/Window.h"
 #include "Core/Engine.h"
+#include "Core/Profiler.h"
 #include "Asset/TextureReader.h"
 #include "Rendering/Renderer.h"
 #include "Rendering/RenderingContext.h"
 #include "Rendering/RenderingAPI.h"
 #include "Rendering/RenderingUtility.h"
 #include "Rendering/Mesh.h"
+#include "Scene/SceneRenderer.h"
 
 #include <imgui/imgui_internal.h>
 #include <imgui/imgui.h>
@@ -17,14 +19,21 @@
 
 namespace Silex
 {
-    Mesh* cubeMesh   = nullptr;
-    Mesh* sponzaMesh = nullptr;
+    Mesh* cubeMesh = nullptr;
 
     // シャドウマップ
     static const uint32  shadowMapResolution = 2048;
     std::array<float, 4> shadowCascadeLevels = { 10.0f, 40.0f, 100.0f, 200.0f };
     int32 debugSleep = 0;
 
+    // GPU 計測で取得するパイプライン統計（結果はビットの小さい順に並ぶ）
+    static const QueryPipelineStatisticFlags gpuPassStatistics =
+        QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+        QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT       |
+        QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+    static const uint32 gpuPassStatisticCount = 3;
+
     namespace Test
     {
         struct PrifilterParam
@@ -34,14 +43,15 @@ namespace Silex
 
         struct Transform
         {
-            glm::mat4 world      = glm::mat4(1.0f);
             glm::mat4 view       = glm::mat4(1.0f);
             glm::mat4 projection = glm::mat4(1.0f);
         };
 
-        struct ShadowTransformData
+        // 描画単位のプッシュ定数（シャドウパスは world のみ使用する）
+        struct ObjectConstant
         {
             glm::mat4 world = glm::mat4(1.0f);
+            int32     id    = -1;
         };
 
         struct LightSpaceTransformData
@@ -147,8 +157,10 @@ namespace Silex
     {
         api->WaitDevice();
 
+        // 未実行の遅延コマンドは、リソース破棄前に実行しておく
+        deferredCommands.Release();
+
         sldelete(cubeMesh);
-        sldelete(sponzaMesh);
 
         CleanupIBL();
         CleanupShadowBuffer();
@@ -191,8 +203,11 @@ namespace Silex
             api->DestroySemaphore(frameData[i].presentSemaphore);
             api->DestroySemaphore(frameData[i].renderSemaphore);
             api->DestroyFence(frameData[i].fence);
+            api->DestroyQueryPool(frameData[i].gpuQueries.timestamp);
+            api->DestroyQueryPool(frameData[i].gpuQueries.statistics);
 
             sldelete(frameData[i].pendingResources);
+            sldelete(frameData[i].allocator);
         }
 
         api->DestroyCommandBuffer(immidiateContext.commandBuffer);
@@ -211,6 +226,9 @@ namespace Silex
         numFramesInFlight       = framesInFlight;
         numSwapchainFrameBuffer = numSwapchainBuffer;
 
+        // 遅延コマンドキュー
+        deferredCommands.Initialize();
+
         // レンダーAPI実装クラスを生成
         api = context->CreateRendringAPI();
         SL_CHECK(!api->Initialize(), false);
@@ -222,12 +240,25 @@ namespace Silex
         // コマンドキュー生成
         graphicsQueue = api->CreateCommandQueue(graphicsQueueID);
         SL_CHECK(!graphicsQueue, false);
+
+        // GPU 計測（タイムスタンプをサポートしないキューでは計測しない）
+        const uint32 timestampValidBits = api->GetTimestampValidBits(graphicsQueueID);
+        timestampMask   = timestampValidBits >= 64? UINT64_MAX : (1ull << timestampValidBits) - 1;
+        timestampPeriod = api->GetTimestampPeriod();
+
+        if (timestampMask == 0)
+        {
+            SL_LOG_WARN("グラフィックスキューがタイムスタンプをサポートしていないため、GPU 計測は無効になります");
+        }
       
         // フレームデータ生成
         frameData.resize(numFramesInFlight);
         for (uint32 i = 0; i < frameData.size(); i++)
         {
-            frameData[i].pendingResources = slnew(PendingDestroyResourceQueue);
+            frameData[i].allocator = slnew(LinearAllocator);
+            frameData[i].allocator->Initialize();
+
+            frameData[i].pendingResources = slnew(PendingDestroyResourceQueue, frameData[i].allocator);
 
             // コマンドプール生成
             frameData[i].commandPool = api->CreateCommandPool(graphicsQueueID);
@@ -247,6 +278,20 @@ namespace Silex
             // フェンス生成
             frameData[i].fence = api->CreateFence();
             SL_CHECK(!frameData[i].fence, false);
+
+            // GPU 計測用クエリプール生成（パイプライン統計は非対応なら生成されない）
+            if (timestampMask != 0)
+            {
+                frameData[i].gpuQueries.timestamp = api->CreateQueryPool(QUERY_TYPE_TIMESTAMP, GPUPassQueries::maxPassCount * 2);
+                SL_CHECK(!frameData[i].gpuQueries.timestamp, false);
+
+                frameData[i].gpuQueries.statistics = api->CreateQueryPool(QUERY_TYPE_PIPELINE_STATISTICS, GPUPassQueries::maxPassCount, gpuPassStatistics);
+            }
+        }
+
+        if (timestampMask != 0 && !IsPipelineStatisticsSupported())
+        {
+            SL_LOG_INFO("パイプライン統計クエリがサポートされていないため、呼び出し回数は計測されません");
         }
 
         // 即時コマンドデータ
@@ -278,9 +323,25 @@ namespace Silex
             frameData[frameIndex].waitingSignal = false;
         }
 
+        // GPU がこのフレームデータを使い終えたので、記録したパスの計測結果は待機なしで取得できる
+        _ResolveGPUPassTimings(frameIndex);
+        frame.gpuQueries.useStatistics = enablePipelineStatistics && frame.gpuQueries.statistics;
+
         // 削除キュー実行
         _DestroyPendingResources(frameIndex);
 
+        // GPU がこのフレームデータを使い終えたので、一時データを破棄する（削除キューの領域もここで解放される）
+        frame.allocator->Reset();
+
+        // ワーカースレッドから投入された遅延コマンドを実行（破棄要求は現フレームの削除キューに積まれる）
+        deferredCommands.Execute();
+
+        // 描画スレッドの記録開始前に、要求されたリサイズを反映する
+        _ApplyResize();
+
+        // ID リードバックの結果回収と、このフレームで記録する要求の受け渡し
+        _ResolveObjectIDReadback(frameIndex);
+
         // 描画先スワップチェインバッファを取得
         auto [fb, view] = api->GetCurrentBackBuffer(Window::Get()->GetSwapChain(), frame.presentSemaphore);
         currentSwapchainFramebuffer = fb;
@@ -307,8 +368,7 @@ namespace Silex
         auto size = Window::Get()->GetSize();
         swapchainPass = api->GetSwapChainRenderPass(Window::Get()->GetSwapChain());
 
-        cubeMesh   = MeshFactory::Cube();
-        sponzaMesh = MeshFactory::Sponza();
+        cubeMesh = MeshFactory::Cube();
 
         defaultLayout.Binding(0);
         defaultLayout.Attribute(0, VERTEX_BUFFER_FORMAT_R32G32B32);
@@ -328,8 +388,8 @@ namespace Silex
         defaultTextureView = CreateTextureView(defaultTexture, TEXTURE_TYPE_2D, TEXTURE_ASPECT_COLOR_BIT);
         reader.Unload(pixels);
 
-        // ID リードバック
-        pixelIDBuffer = CreateBuffer(nullptr, sizeof(int32));
+        // ID リードバック（フレームごとに int32 1つ分の領域を使用する）
+        pixelIDBuffer = CreateBuffer(nullptr, sizeof(int32) * numFramesInFlight);
 
         // IBL
         PrepareIBL("Assets/Textures/cloud.png");
@@ -337,6 +397,9 @@ namespace Silex
         // シャドウマップ
         PrepareShadowBuffer();
 
+        // シーンバッファサイズ（エディターからのリサイズ要求は1フレーム遅れて反映されるので、初回はウィンドウサイズで描画する）
+        sceneFramebufferSize = size;
+
         // Gバッファ
         gbuffer = slnew(GBufferData);
         PrepareGBuffer(size.x, size.y);
@@ -777,7 +840,6 @@ namespace Silex
         shadow.depthView   = CreateTextureView(shadow.depth, TEXTURE_TYPE_2D_ARRAY, TEXTURE_ASPECT_DEPTH_BIT);
         shadow.framebuffer = CreateFramebuffer(shadow.pass, 1, &hdepth, shadowMapResolution, shadowMapResolution);
         
-        shadow.transformUBO      = CreateUniformBuffer(nullptr, sizeof(Test::ShadowTransformData));
         shadow.lightTransformUBO = CreateUniformBuffer(nullptr, sizeof(Test::LightSpaceTransformData));
         shadow.cascadeUBO        = CreateUniformBuffer(nullptr, sizeof(Test::CascadeData));
 
@@ -797,14 +859,12 @@ namespace Silex
 
         // デスクリプター
         shadow.set = CreateDescriptorSet(shadow.shader, 0);
-        shadow.set->SetResource(0, shadow.transformUBO     );
         shadow.set->SetResource(1, shadow.lightTransformUBO);
         shadow.set->Flush();
     }
 
     void Renderer::CleanupShadowBuffer()
     {
-        DestroyBuffer(shadow.transformUBO);
         DestroyBuffer(shadow.lightTransformUBO);
         DestroyBuffer(shadow.cascadeUBO);
         DestroyTexture(shadow.depth);
@@ -818,7 +878,7 @@ namespace Silex
         api->DestroyFramebuffer(shadow.framebuffer);
     }
 
-    void Renderer::CalculateLightSapceMatrices(glm::vec3 directionalLightDir, Camera* camera, std::array<glm::mat4, 4>& out_result)
+    void Renderer::CalculateLightSapceMatrices(glm::vec3 directionalLightDir, const Camera* camera, std::array<glm::mat4, 4>& out_result)
     {
         auto nearP  = camera->GetNearPlane();
         auto farP   = camera->GetFarPlane();
@@ -829,7 +889,7 @@ namespace Silex
         out_result[3] = (GetLightSpaceMatrix(directionalLightDir, camera, shadowCascadeLevels[2], farP));
     }
 
-    glm::mat4 Renderer::GetLightSpaceMatrix(glm::vec3 directionalLightDir, Camera* camera, const float nearPlane, const float farPlane)
+    glm::mat4 Renderer::GetLightSpaceMatrix(glm::vec3 directionalLightDir, const Camera* camera, const float nearPlane, const float farPlane)
     {
         glm::mat4 proj = glm::perspective(glm::radians(camera->GetFOV()), (float)sceneFramebufferSize.x / (float)sceneFramebufferSize.y, nearPlane, farPlane);
 
@@ -979,7 +1039,7 @@ namespace Silex
 
             subpass.colorReferences.push_back(idRef);
             attachments[3] = id;
-            clearvalues[3].SetInt(10, 0, 0, 1);
+            clearvalues[3].SetInt(-1, 0, 0, 1); // エンティティなし
 
             // 深度
             Attachment depth = {};
@@ -1621,34 +1681,83 @@ namespace Silex
         DestroyDescriptorSet(bloom->prefilterSet);
     }
 
-    int32 Renderer::ReadPixelObjectID(uint32 x, uint32 y)
+    void Renderer::RequestObjectIDReadback(uint32 x, uint32 y)
     {
-        ImmidiateExcute([&](CommandBufferHandle* cmd)
-        {
-            TextureBarrierInfo info = {};
-            info.texture      = gbuffer->id->GetHandle();
-            info.subresources = {};
-            info.srcAccess    = BARRIER_ACCESS_MEMORY_WRITE_BIT;
-            info.dstAccess    = BARRIER_ACCESS_MEMORY_WRITE_BIT;
-            info.oldLayout    = TEXTURE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            info.newLayout    = TEXTURE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            api->Cmd_PipelineBarrier(cmd, PIPELINE_STAGE_ALL_COMMANDS_BIT, PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, 0, nullptr, 1, &info);
+        SL_ASSERT(ThreadPool::IsMainThread());
 
-            BufferTextureCopyRegion region = {};
-            region.bufferOffset        = 0;
-            region.textureSubresources = {};
-            region.textureRegionSize   = {1, 1, 1};
-            region.textureOffset       = {x, y, 0};
+        // 描画スレッドの記録開始前に、次の BeginFrame でフレームデータへ渡す
+        pendingIDReadback = { (int32)x, (int32)y };
+    }
 
-            api->Cmd_CopyTextureToBuffer(cmd, gbuffer->id->GetHandle(), TEXTURE_LAYOUT_TRANSFER_SRC_OPTIMAL, pixelIDBuffer->GetHandle(0), 1, &region);
+    bool Renderer::GetObjectIDReadback(int32& outID)
+    {
+        SL_ASSERT(ThreadPool::IsMainThread());
 
-            info.oldLayout = TEXTURE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            info.newLayout = TEXTURE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            api->Cmd_PipelineBarrier(cmd, PIPELINE_STAGE_ALL_COMMANDS_BIT, PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, 0, nullptr, 1, &info);
-        });
+        if (!hasIDReadbackResult)
+            return false;
+
+        outID               = idReadbackResult;
+        hasIDReadbackResult = false;
+
+        return true;
+    }
+
+    void Renderer::_RecordObjectIDReadback(CommandBufferHandle* cmd, const FrameData& frame)
+    {
+        TextureBarrierInfo info = {};
+        info.texture      = gbuffer->id->GetHandle();
+        info.subresources = {};
+        info.srcAccess    = BARRIER_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        info.dstAccess    = BARRIER_ACCESS_TRANSFER_READ_BIT;
+        info.oldLayout    = TEXTURE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        info.newLayout    = TEXTURE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        api->Cmd_PipelineBarrier(cmd, PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, PIPELINE_STAGE_TRANSFER_BIT, 0, nullptr, 0, nullptr, 1, &info);
+
+        BufferTextureCopyRegion region = {};
+        region.bufferOffset        = sizeof(int32) * frameIndex;
+        region.textureSubresources = {};
+        region.textureRegionSize   = {1, 1, 1};
+        region.textureOffset       = {frame.idReadbackPixel.x, frame.idReadbackPixel.y, 0};
+
+        api->Cmd_CopyTextureToBuffer(cmd, gbuffer->id->GetHandle(), TEXTURE_LAYOUT_TRANSFER_SRC_OPTIMAL, pixelIDBuffer->GetHandle(0), 1, &region);
+
+        info.srcAccess = BARRIER_ACCESS_TRANSFER_READ_BIT;
+        info.dstAccess = BARRIER_ACCESS_SHADER_READ_BIT;
+        info.oldLayout = TEXTURE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        info.newLayout = TEXTURE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        api->Cmd_PipelineBarrier(cmd, PIPELINE_STAGE_TRANSFER_BIT, PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, nullptr, 0, nullptr, 1, &info);
+
+        // フェンス待機後に CPU から読み取れるようにする
+        MemoryBarrierInfo mb = {};
+        mb.srcAccess = BARRIER_ACCESS_TRANSFER_WRITE_BIT;
+        mb.dstAccess = BARRIER_ACCESS_HOST_READ_BIT;
+        api->Cmd_PipelineBarrier(cmd, PIPELINE_STAGE_TRANSFER_BIT, PIPELINE_STAGE_HOST_BIT, 1, &mb, 0, nullptr, 0, nullptr);
+    }
+
+    void Renderer::_ResolveObjectIDReadback(uint32 frame)
+    {
+        FrameData& data = frameData[frame];
+
+        // 前回このフレームデータで記録したコピーは、フェンス待機により完了している
+        if (data.hasIDReadback)
+        {
+            const int32* ids = (const int32*)pixelIDBuffer->GetMappedPointer();
+            idReadbackResult    = ids[frame];
+            hasIDReadbackResult = true;
+            data.hasIDReadback  = false;
+        }
+
+        // 新しい要求はこのフレームで記録する（リサイズ反映後のバッファ範囲外なら破棄する）
+        if (pendingIDReadback.x >= 0 && pendingIDReadback.y >= 0)
+        {
+            if (pendingIDReadback.x < sceneFramebufferSize.x && pendingIDReadback.y < sceneFramebufferSize.y)
+            {
+                data.idReadbackPixel = { (uint32)pendingIDReadback.x, (uint32)pendingIDReadback.y };
+                data.hasIDReadback   = true;
+            }
 
-        int32* outID = (int32*)pixelIDBuffer->GetMappedPointer();
-        return *outID;
+            pendingIDReadback = { -1, -1 };
+        }
     }
 
     void Renderer::Resize(uint32 width, uint32 height)
@@ -1656,6 +1765,19 @@ namespace Silex
         if (width == 0 || height == 0)
             return;
 
+        // 描画スレッドがリソースを参照している可能性があるので、次の BeginFrame まで遅延させる
+        pendingResizeSize = { width, height };
+    }
+
+    void Renderer::_ApplyResize()
+    {
+        if (pendingResizeSize.x == 0 || pendingResizeSize.y == 0)
+            return;
+
+        const uint32 width  = pendingResizeSize.x;
+        const uint32 height = pendingResizeSize.y;
+
+        pendingResizeSize    = {};
         sceneFramebufferSize = {width, height};
 
         ResizeGBuffer(width, height);
@@ -1688,22 +1810,23 @@ namespace Silex
         }
     }
 
-    void Renderer::UpdateUBO()
+    void Renderer::UpdateUBO(const SceneRenderData& renderData)
     {
-        Camera* camera = Engine::Get()->GetEditor()->GetEditorCamera();
+        const Camera* camera = &renderData.camera;
 
+        // シーンにライトがなければ、既定のライトを使用する
+        glm::vec3 lightDir   = sceneLightDir;
+        glm::vec3 lightColor = glm::vec3(1.0);
+        if (renderData.hasDirectionalLight)
         {
-            Test::ShadowTransformData shadowData;
-            shadowData.world = glm::mat4(1.0);
-
-            shadow.transformUBO->SetData(&shadowData, sizeof(Test::ShadowTransformData));
+            lightDir   = renderData.directionalLightDirection;
+            lightColor = renderData.directionalLightColor * renderData.directionalLightIntencity;
         }
 
         {
             Test::Transform sceneData;
             sceneData.projection = camera->GetProjectionMatrix();
             sceneData.view       = camera->GetViewMatrix();
-            sceneData.world      = glm::mat4(1.0);
 
             gbuffer->transformUBO->SetData(&sceneData, sizeof(Test::Transform));
         }
@@ -1730,7 +1853,7 @@ namespace Silex
 
         {
             std::array<glm::mat4, 4> outLightMatrices;
-            CalculateLightSapceMatrices(sceneLightDir, camera, outLightMatrices);
+            CalculateLightSapceMatrices(lightDir, camera, outLightMatrices);
 
             Test::LightSpaceTransformData lightData = {};
             lightData.cascade[0] = outLightMatrices[0];
@@ -1740,8 +1863,8 @@ namespace Silex
             shadow.lightTransformUBO->SetData(&lightData, sizeof(Test::LightSpaceTransformData));
 
             Test::SceneUBO sceneUBO = {};
-            sceneUBO.lightColor               = glm::vec4(1.0, 1.0, 1.0, 1.0);
-            sceneUBO.lightDir                 = glm::vec4(sceneLightDir, 1.0);
+            sceneUBO.lightColor               = glm::vec4(lightColor, 1.0);
+            sceneUBO.lightDir                 = glm::vec4(lightDir, 1.0);
             sceneUBO.cameraPosition           = glm::vec4(camera->GetPosition(), camera->GetFarPlane());
             sceneUBO.view                     = camera->GetViewMatrix();
             sceneUBO.invViewProjection        = glm::inverse(camera->GetProjectionMatrix() * camera->GetViewMatrix());
@@ -1765,9 +1888,11 @@ namespace Silex
 
 
 
-    void Renderer::Render(float dt)
+    void Renderer::Render(const SceneRenderData& renderData, float dt)
     {
-        UpdateUBO();
+        SL_SCOPE_PROFILE("Renderer::Render");
+
+        UpdateUBO(renderData);
 
 
         FrameData& frame = frameData[frameIndex];
@@ -1775,6 +1900,7 @@ namespace Silex
 
         // コマンドバッファ開始
         api->BeginCommandBuffer(frame.commandBuffer);
+        _ResetGPUPassQueries(frame.commandBuffer);
 
         //===================================================================================================
         // memcopy mapped buffer in-between command buffer calls?
@@ -1797,6 +1923,8 @@ namespace Silex
         // シャドウパス
         if (1)
         {
+            _BeginGPUPass(frame.commandBuffer, "Shadow");
+
             api->Cmd_SetViewport(frame.commandBuffer, 0, 0, shadowMapResolution, shadowMapResolution);
             api->Cmd_SetScissor(frame.commandBuffer, 0, 0, shadowMapResolution, shadowMapResolution);
 
@@ -1806,22 +1934,33 @@ namespace Silex
             api->Cmd_BindPipeline(frame.commandBuffer, shadow.pipeline);
             api->Cmd_BindDescriptorSet(frame.commandBuffer, shadow.set->GetHandle(frameIndex), 0);
 
-            // スポンザ
-            for (MeshSource* source : sponzaMesh->GetMeshSources())
+            for (const MeshDrawData& draw : renderData.meshDrawList)
             {
-                BufferHandle* vb = source->GetVertexBuffer()->GetHandle();
-                BufferHandle* ib = source->GetIndexBuffer()->GetHandle();
-                uint32 indexCount = source->GetIndexCount();
-                api->Cmd_BindVertexBuffer(frame.commandBuffer, vb, 0);
-                api->Cmd_BindIndexBuffer(frame.commandBuffer, ib, INDEX_BUFFER_FORMAT_UINT32, 0);
-                api->Cmd_DrawIndexed(frame.commandBuffer, indexCount, 1, 0, 0, 0);
+                Mesh* mesh = draw.mesh->Get();
+                if (!draw.castShadow || !mesh)
+                    continue;
+
+                api->Cmd_PushConstants(frame.commandBuffer, shadow.shader, &draw.transform, sizeof(glm::mat4) / sizeof(uint32));
+
+                for (MeshSource* source : mesh->GetMeshSources())
+                {
+                    BufferHandle* vb  = source->GetVertexBuffer()->GetHandle();
+                    BufferHandle* ib  = source->GetIndexBuffer()->GetHandle();
+                    uint32 indexCount = source->GetIndexCount();
+                    api->Cmd_BindVertexBuffer(frame.commandBuffer, vb, 0);
+                    api->Cmd_BindIndexBuffer(frame.commandBuffer, ib, INDEX_BUFFER_FORMAT_UINT32, 0);
+                    api->Cmd_DrawIndexed(frame.commandBuffer, indexCount, 1, 0, 0, 0);
+                }
             }
 
             api->Cmd_EndRenderPass(frame.commandBuffer);
+            _EndGPUPass(frame.commandBuffer);
         }
 
         if (1) // メッシュパス
         {
+            _BeginGPUPass(frame.commandBuffer, "GBuffer");
+
             api->Cmd_SetViewport(frame.commandBuffer, 0, 0, viewportSize.x, viewportSize.y);
             api->Cmd_SetScissor(frame.commandBuffer, 0, 0, viewportSize.x, viewportSize.y);
 
@@ -1842,29 +1981,45 @@ namespace Silex
             //========================================================================
             // TODO: バインドレスとインスタンシング描画のためのストレージバッファの設計までに...
             //------------------------------------------------------------------------
-            // 設計が完了するまでは個別でドローコールすることになるので、ワールド行列はプッシュ定数で
-            // 渡すように変更する。現在は定数バッファで渡しているので、シーンで一律なカメラの
-            // ビュー・プロジェクション行列とは分離させる
-            // 
-            // ※本来は描画パス全体で使用する共通パラメータ(View/Projection)として1回だけバインド
+            // 設計が完了するまでは個別でドローコールするので、ワールド行列とエンティティIDは
+            // プッシュ定数で渡し、シーンで一律なカメラのビュー・プロジェクション行列とは分離する
             //========================================================================
-            
-            // スポンザ
-            for (MeshSource* source : sponzaMesh->GetMeshSources())
+            for (const MeshDrawData& draw : renderData.meshDrawList)
             {
-                BufferHandle* vb  = source->GetVertexBuffer()->GetHandle();
-                BufferHandle* ib  = source->GetIndexBuffer()->GetHandle();
-                uint32 indexCount = source->GetIndexCount();
-                api->Cmd_BindVertexBuffer(frame.commandBuffer, vb, 0);
-                api->Cmd_BindIndexBuffer(frame.commandBuffer, ib, INDEX_BUFFER_FORMAT_UINT32, 0);
-                api->Cmd_DrawIndexed(frame.commandBuffer, indexCount, 1, 0, 0, 0);
+                Mesh* mesh = draw.mesh->Get();
+                if (!mesh)
+                    continue;
+
+                Test::ObjectConstant object;
+                object.world = draw.transform;
+                object.id    = draw.entityID;
+                api->Cmd_PushConstants(frame.commandBuffer, gbuffer->shader, &object, sizeof(Test::ObjectConstant) / sizeof(uint32));
+
+                for (MeshSource* source : mesh->GetMeshSources())
+                {
+                    BufferHandle* vb  = source->GetVertexBuffer()->GetHandle();
+                    BufferHandle* ib  = source->GetIndexBuffer()->GetHandle();
+                    uint32 indexCount = source->GetIndexCount();
+                    api->Cmd_BindVertexBuffer(frame.commandBuffer, vb, 0);
+                    api->Cmd_BindIndexBuffer(frame.commandBuffer, ib, INDEX_BUFFER_FORMAT_UINT32, 0);
+                    api->Cmd_DrawIndexed(frame.commandBuffer, indexCount, 1, 0, 0, 0);
+                }
             }
 
             api->Cmd_EndRenderPass(frame.commandBuffer);
+            _EndGPUPass(frame.commandBuffer);
+
+            // オブジェクトID リードバック（結果はこのフレームデータのフェンス待機後に回収する）
+            if (frame.hasIDReadback)
+            {
+                _RecordObjectIDReadback(frame.commandBuffer, frame);
+            }
         }
 
         if (1) // ライティングパス
         {
+            _BeginGPUPass(frame.commandBuffer, "Lighting");
+
             auto* view = lighting.view->GetHandle();
             api->Cmd_BeginRenderPass(frame.commandBuffer, lighting.pass, lighting.framebuffer, 1, &view);
 
@@ -1873,10 +2028,13 @@ namespace Silex
             api->Cmd_Draw(frame.commandBuffer, 3, 1, 0, 0);
 
             api->Cmd_EndRenderPass(frame.commandBuffer);
+            _EndGPUPass(frame.commandBuffer);
         }
 
         if (1) // スカイパス
         {
+            _BeginGPUPass(frame.commandBuffer, "Sky / Grid");
+
             TextureViewHandle* views[] = { lighting.view->GetHandle(), gbuffer->depthView->GetHandle() };
             api->Cmd_BeginRenderPass(frame.commandBuffer, environment.pass, environment.framebuffer, 2, views);
 
@@ -1899,10 +2057,13 @@ namespace Silex
             }
 
             api->Cmd_EndRenderPass(frame.commandBuffer);
+            _EndGPUPass(frame.commandBuffer);
         }
 
         if (1) // ブルーム
         {
+            _BeginGPUPass(frame.commandBuffer, "Bloom");
+
             // プリフィルタリング
             if (1)
             {
@@ -1985,10 +2146,14 @@ namespace Silex
 
                 api->Cmd_EndRenderPass(frame.commandBuffer);
             }
+
+            _EndGPUPass(frame.commandBuffer);
         }
 
         if (1) // コンポジットパス
         {
+            _BeginGPUPass(frame.commandBuffer, "Composite");
+
             auto* view = compositeTextureView->GetHandle();
             api->Cmd_BeginRenderPass(frame.commandBuffer, compositePass, compositeFB, 1, &view);
 
@@ -2000,9 +2165,97 @@ namespace Silex
             api->Cmd_Draw(frame.commandBuffer, 3, 1, 0, 0);
 
             api->Cmd_EndRenderPass(frame.commandBuffer);
+            _EndGPUPass(frame.commandBuffer);
         }
     }
 
+    void Renderer::_ResetGPUPassQueries(CommandBufferHandle* cmd)
+    {
+        GPUPassQueries& queries = frameData[frameIndex].gpuQueries;
+        queries.passCount = 0;
+
+        if (!queries.timestamp)
+            return;
+
+        // クエリのリセットはレンダーパスの外で行う必要がある
+        api->Cmd_ResetQueryPool(cmd, queries.timestamp, 0, GPUPassQueries::maxPassCount * 2);
+
+        if (queries.useStatistics)
+            api->Cmd_ResetQueryPool(cmd, queries.statistics, 0, GPUPassQueries::maxPassCount);
+    }
+
+    void Renderer::_BeginGPUPass(CommandBufferHandle* cmd, const char* name)
+    {
+        GPUPassQueries& queries = frameData[frameIndex].gpuQueries;
+        if (!queries.timestamp || queries.passCount >= GPUPassQueries::maxPassCount)
+            return;
+
+        const uint32 index = queries.passCount;
+        queries.names[index] = name;
+
+        api->Cmd_WriteTimestamp(cmd, queries.timestamp, index * 2, PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+
+        if (queries.useStatistics)
+            api->Cmd_BeginQuery(cmd, queries.statistics, index);
+    }
+
+    void Renderer::_EndGPUPass(CommandBufferHandle* cmd)
+    {
+        GPUPassQueries& queries = frameData[frameIndex].gpuQueries;
+        if (!queries.timestamp || queries.passCount >= GPUPassQueries::maxPassCount)
+            return;
+
+        const uint32 index = queries.passCount++;
+
+        if (queries.useStatistics)
+            api->Cmd_EndQuery(cmd, queries.statistics, index);
+
+        // 先行するコマンドが全て完了した時点の時刻
+        api->Cmd_WriteTimestamp(cmd, queries.timestamp, index * 2 + 1, PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+    }
+
+    void Renderer::_ResolveGPUPassTimings(uint32 frame)
+    {
+        GPUPassQueries& queries = frameData[frame].gpuQueries;
+
+        const uint32 passCount = queries.passCount;
+        queries.passCount = 0;
+
+        if (passCount == 0)
+            return;
+
+        // 未完了のクエリが残っていれば（通常はフェンス待機後なので起きない）、前回の結果を維持する
+        uint64 timestamps[GPUPassQueries::maxPassCount * 2];
+        if (!api->GetQueryPoolResults(queries.timestamp, 0, passCount * 2, timestamps))
+            return;
+
+        uint64 statistics[GPUPassQueries::maxPassCount * gpuPassStatisticCount] = {};
+        if (queries.useStatistics && !api->GetQueryPoolResults(queries.statistics, 0, passCount, statistics))
+            std::fill(std::begin(statistics), std::end(statistics), 0);
+
+        // タイムスタンプは有効ビットの範囲で循環するので、差分をマスクしてから変換する
+        auto ToMilliSecond = [this](uint64 begin, uint64 end)
+        {
+            return (float)((double)((end - begin) & timestampMask) * timestampPeriod / 1'000'000.0);
+        };
+
+        gpuPassTimings.resize(passCount);
+
+        for (uint32 i = 0; i < passCount; i++)
+        {
+            const uint64* passStatistics = &statistics[i * gpuPassStatisticCount];
+
+            GPUPassTiming& timing = gpuPassTimings[i];
+            timing.name                = queries.names[i];
+            timing.time                = ToMilliSecond(timestamps[i * 2], timestamps[i * 2 + 1]);
+            timing.vertexInvocations   = passStatistics[0];
+            timing.clippingPrimitives  = passStatistics[1];
+            timing.fragmentInvocations = passStatistics[2];
+        }
+
+        gpuFrameTime = ToMilliSecond(timestamps[0], timestamps[passCount * 2 - 1]);
+    }
+
 
 
 
@@ -2030,6 +2283,39 @@ namespace Silex
         return texture;
     }
 
+    AsyncTask<Texture2D*> Renderer::CreateTextureFromMemoryAsync(const void* pixelData, uint64 dataSize, uint32 width, uint32 height, bool isHDR, bool genMipmap)
+    {
+        // RGBA8_UNORM / RGBA16_SFLOAT フォーマットテクスチャ
+        RenderingFormat format     = isHDR? RENDERING_FORMAT_R16G16B16A16_SFLOAT : RENDERING_FORMAT_R8G8B8A8_UNORM;
+        TextureHandle*  gpuTexture = _CreateTexture(TEXTURE_DIMENSION_2D, TEXTURE_TYPE_2D, format, width, height, 1, 1, genMipmap, TEXTURE_USAGE_COPY_DST_BIT);
+
+        // ステージングにコピーした時点で、呼び出し元のピクセルデータは不要になる
+        BufferHandle* staging = api->CreateBuffer(dataSize, BUFFER_USAGE_TRANSFER_SRC_BIT, MEMORY_ALLOCATION_TYPE_CPU);
+
+        void* mappedPtr = api->MapBuffer(staging);
+        std::memcpy(mappedPtr, pixelData, dataSize);
+        api->UnmapBuffer(staging);
+
+        const bool result = co_await ImmidiateExcuteAsync([this, gpuTexture, staging, width, height, genMipmap](CommandBufferHandle* cmd)
+        {
+            _RecordTextureUpload(cmd, gpuTexture, staging, width, height, genMipmap);
+        });
+
+        api->DestroyBuffer(staging);
+
+        // 転送に失敗したテクスチャは内容が不定なので返さない
+        if (!result)
+        {
+            api->DestroyTexture(gpuTexture);
+            co_return nullptr;
+        }
+
+        Texture2D* texture = slnew(Texture2D, numFramesInFlight);
+        texture->handle[0] = gpuTexture;
+
+        co_return texture;
+    }
+
     Texture2D* Renderer::CreateTexture2D(RenderingFormat format, uint32 width, uint32 height, bool genMipmap, TextureUsageFlags additionalFlags)
     {
         Texture2D* texture = slnew(Texture2D, numFramesInFlight);
@@ -2059,6 +2345,9 @@ namespace Silex
 
     void Renderer::DestroyTexture(Texture* texture)
     {
+        if (_DeferDestroyToMainThread(&Renderer::DestroyTexture, texture))
+            return;
+
         FrameData& frame = frameData[frameIndex];
 
         TextureHandle* h = texture->GetHandle();
@@ -2086,6 +2375,9 @@ namespace Silex
 
     void Renderer::DestroyTextureView(TextureView* view)
     {
+        if (_DeferDestroyToMainThread(&Renderer::DestroyTextureView, view))
+            return;
+
         FrameData& frame = frameData[frameIndex];
 
         TextureViewHandle* h = view->GetHandle();
@@ -2115,6 +2407,9 @@ namespace Silex
 
     void Renderer::DestroySampler(Sampler* sampler)
     {
+        if (_DeferDestroyToMainThread(&Renderer::DestroySampler, sampler))
+            return;
+
         FrameData& frame = frameData[frameIndex];
 
         SamplerHandle* h = sampler->GetHandle();
@@ -2160,51 +2455,56 @@ namespace Silex
         // コピーコマンド
         ImmidiateExcute([&](CommandBufferHandle* cmd)
         {
-            TextureSubresourceRange range = {};
-            range.aspect = TEXTURE_ASPECT_COLOR_BIT;
+            _RecordTextureUpload(cmd, texture, staging, width, height, genMipmap);
+        });
 
-            TextureBarrierInfo info = {};
-            info.texture      = texture;
-            info.subresources = range;
-            info.srcAccess    = BARRIER_ACCESS_MEMORY_WRITE_BIT;
-            info.dstAccess    = BARRIER_ACCESS_MEMORY_WRITE_BIT;
-            info.oldLayout    = TEXTURE_LAYOUT_UNDEFINED;
-            info.newLayout    = TEXTURE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        // ステージング破棄
+        api->DestroyBuffer(staging);
+    }
 
-            api->Cmd_PipelineBarrier(cmd, PIPELINE_STAGE_ALL_COMMANDS_BIT, PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, 0, nullptr, 1, &info);
+    void Renderer::_RecordTextureUpload(CommandBufferHandle* cmd, TextureHandle* texture, BufferHandle* staging, uint32 width, uint32 height, bool genMipmap)
+    {
+        TextureSubresourceRange range = {};
+        range.aspect = TEXTURE_ASPECT_COLOR_BIT;
 
-            TextureSubresource subresource = {};
-            subresource.aspect     = TEXTURE_ASPECT_COLOR_BIT;
+        TextureBarrierInfo info = {};
+        info.texture      = texture;
+        info.subresources = range;
+        info.srcAccess    = BARRIER_ACCESS_MEMORY_WRITE_BIT;
+        info.dstAccess    = BARRIER_ACCESS_MEMORY_WRITE_BIT;
+        info.oldLayout    = TEXTURE_LAYOUT_UNDEFINED;
+        info.newLayout    = TEXTURE_LAYOUT_TRANSFER_DST_OPTIMAL;
 
-            BufferTextureCopyRegion region = {};
-            region.bufferOffset        = 0;
-            region.textureOffset       = { 0, 0, 0 };
-            region.textureRegionSize   = { width, height, 1 };
-            region.textureSubresources = subresource;
+        api->Cmd_PipelineBarrier(cmd, PIPELINE_STAGE_ALL_COMMANDS_BIT, PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, 0, nullptr, 1, &info);
 
-            api->Cmd_CopyBufferToTexture(cmd, staging, texture, TEXTURE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        TextureSubresource subresource = {};
+        subresource.aspect     = TEXTURE_ASPECT_COLOR_BIT;
 
-            if (genMipmap)
-            {
-                // ミップマップ生成
-                _GenerateMipmaps(cmd, texture, width, height, 1, 1, TEXTURE_ASPECT_COLOR_BIT);
+        BufferTextureCopyRegion region = {};
+        region.bufferOffset        = 0;
+        region.textureOffset       = { 0, 0, 0 };
+        region.textureRegionSize   = { width, height, 1 };
+        region.textureSubresources = subresource;
 
-                // シェーダーリードに移行 (ミップマップ生成時のコピーでコピーソースに移行するため、コピーソース -> シェーダーリード)
-                info.oldLayout = TEXTURE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-                info.newLayout = TEXTURE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                api->Cmd_PipelineBarrier(cmd, PIPELINE_STAGE_ALL_COMMANDS_BIT, PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, 0, nullptr, 1, &info);
-            }
-            else
-            {
-                // シェーダーリードに移行 (バッファからの転送でレイアウト変更がないため、コピー先 -> シェーダーリード)
-                info.oldLayout = TEXTURE_LAYOUT_TRANSFER_DST_OPTIMAL;
-                info.newLayout = TEXTURE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                api->Cmd_PipelineBarrier(cmd, PIPELINE_STAGE_ALL_COMMANDS_BIT, PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, 0, nullptr, 1, &info);
-            }
-        });
+        api->Cmd_CopyBufferToTexture(cmd, staging, texture, TEXTURE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
-        // ステージング破棄
-        api->DestroyBuffer(staging);
+        if (genMipmap)
+        {
+            // ミップマップ生成
+            _GenerateMipmaps(cmd, texture, width, height, 1, 1, TEXTURE_ASPECT_COLOR_BIT);
+
+            // シェーダーリードに移行 (ミップマップ生成時のコピーでコピーソースに移行するため、コピーソース -> シェーダーリード)
+            info.oldLayout = TEXTURE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            info.newLayout = TEXTURE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            api->Cmd_PipelineBarrier(cmd, PIPELINE_STAGE_ALL_COMMANDS_BIT, PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, 0, nullptr, 1, &info);
+        }
+        else
+        {
+            // シェーダーリードに移行 (バッファからの転送でレイアウト変更がないため、コピー先 -> シェーダーリード)
+            info.oldLayout = TEXTURE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            info.newLayout = TEXTURE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            api->Cmd_PipelineBarrier(cmd, PIPELINE_STAGE_ALL_COMMANDS_BIT, PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, 0, nullptr, 1, &info);
+        }
     }
     
     void Renderer::_GenerateMipmaps(CommandBufferHandle* cmd, TextureHandle* texture, uint32 width, uint32 height, uint32 depth, uint32 array, TextureAspectFlags aspect)
@@ -2340,6 +2640,9 @@ namespace Silex
 
     void Renderer::DestroyBuffer(Buffer* buffer)
     {
+        if (_DeferDestroyToMainThread(&Renderer::DestroyBuffer, buffer))
+            return;
+
         FrameData& frame = frameData[frameIndex];
 
         for (uint32 i = 0; i < numFramesInFlight; i++)
@@ -2405,6 +2708,9 @@ namespace Silex
 
     void Renderer::DestroyFramebuffer(FramebufferHandle* framebuffer)
     {
+        if (_DeferDestroyToMainThread(&Renderer::DestroyFramebuffer, framebuffer))
+            return;
+
         FrameData& frame = frameData[frameIndex];
         frame.pendingResources->framebuffer.push_back(framebuffer);
     }
@@ -2429,6 +2735,9 @@ namespace Silex
 
     void Renderer::DestroyDescriptorSet(DescriptorSet* set)
     {
+        if (_DeferDestroyToMainThread(&Renderer::DestroyDescriptorSet, set))
+            return;
+
         FrameData& frame = frameData[frameIndex];
 
         for (uint32 i = 0; i < numFramesInFlight; i++)
@@ -2482,9 +2791,41 @@ namespace Silex
 
     void Renderer::ImmidiateExcute(std::function<void(CommandBufferHandle*)>&& func)
     {
+        // 共有のコマンドプール・キューは外部同期が必要なので、送信はメインスレッドに限定する
+        SL_ASSERT(ThreadPool::IsMainThread());
+
         api->ImmidiateCommands(graphicsQueue, immidiateContext.commandBuffer, immidiateContext.fence, std::move(func));
     }
 
+    AsyncTask<bool> Renderer::ImmidiateExcuteAsync(std::function<void(CommandBufferHandle*)> func)
+    {
+        SL_ASSERT(ThreadPool::IsMainThread());
+
+        // 共有のコマンドバッファは同期実行で使い回されるので、送信ごとにコマンドバッファとフェンスを生成する
+        CommandBufferHandle* commandBuffer = api->CreateCommandBuffer(immidiateContext.commandPool);
+        FenceHandle*         fence         = api->CreateFence();
+
+        api->BeginCommandBuffer(commandBuffer);
+        func(commandBuffer);
+        api->EndCommandBuffer(commandBuffer);
+
+        bool result = api->SubmitCommands(graphicsQueue, commandBuffer, fence);
+        if (result)
+        {
+            // デバイスロスト時もシグナルされないので、エラーで待機を打ち切る
+            RenderingAPI* rhi    = api;
+            FenceStatus   status = FENCE_STATUS_NOT_READY;
+            co_await WaitUntil([rhi, fence, &status]() { status = rhi->GetFenceStatus(fence); return status != FENCE_STATUS_NOT_READY; }, true);
+
+            result = status == FENCE_STATUS_SIGNALED;
+        }
+
+        api->DestroyCommandBuffer(commandBuffer);
+        api->DestroyFence(fence);
+
+        co_return result;
+    }
+
     void Renderer::_DestroyPendingResources(uint32 frame)
     {
         FrameData& f = frameData[frame];
@@ -2544,6 +2885,10 @@ namespace Silex
         }
 
         f.pendingResources->pipeline.clear();
+
+        // リニアアロケーターの領域は解放されないので、リセット前に空のキューで作り直す
+        Memory::Destruct(f.pendingResources);
+        Memory::Construct<PendingDestroyResourceQueue>(f.pendingResources, f.allocator);
     }
 
     const DeviceInfo& Renderer::GetDeviceInfo() const
@@ -2556,6 +2901,36 @@ namespace Silex
         return imageSet;
     }
 
+    const std::vector<GPUPassTiming>& Renderer::GetGPUPassTimings() const
+    {
+        return gpuPassTimings;
+    }
+
+    float Renderer::GetGPUFrameTime() const
+    {
+        return gpuFrameTime;
+    }
+
+    bool Renderer::IsGPUTimingSupported() const
+    {
+        return timestampMask != 0;
+    }
+
+    bool Renderer::IsPipelineStatisticsSupported() const
+    {
+        return !frameData.empty() && frameData[0].gpuQueries.statistics;
+    }
+
+    void Renderer::SetPipelineStatisticsEnabled(bool enable)
+    {
+        enablePipelineStatistics = enable;
+    }
+
+    bool Renderer::IsPipelineStatisticsEnabled() const
+    {
+        return enablePipelineStatistics;
+    }
+
     RenderingContext* Renderer::GetContext() const
     {
         return context;
@@ -2571,6 +2946,11 @@ namespace Silex
         return frameData[frameIndex];
     }
 
+    LinearAllocator* Renderer::GetFrameAllocator() const
+    {
+        return frameData[frameIndex].allocator;
+    }
+
     uint32 Renderer::GetCurrentFrameIndex() const
     {
         return frameIndex;
@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include "Core/Coroutine.h"
+#include "Core/TaskQueue.h"
+#include "Core/LinearAllocator.h"
 #include "Scene/Camera.h"
 #include "Rendering/ShaderCompiler.h"
 #include "Rendering/RenderingStructures.h"
@@ -10,6 +13,7 @@ namespace Silex
 {
     class RenderingAPI;
     class RenderingContext;
+    struct SceneRenderData;
 
     struct GBufferData
     {
@@ -73,7 +77,6 @@ namespace Silex
         PipelineHandle*    pipeline    = nullptr;
         ShaderHandle*      shader      = nullptr;
 
-        UniformBuffer* transformUBO;
         UniformBuffer* lightTransformUBO;
         UniformBuffer* cascadeUBO;
         DescriptorSet* set;
@@ -116,17 +119,50 @@ namespace Silex
 
 
 
-    // 削除待機リソース
+    // 削除待機リソース（フレームのリニアアロケーターから確保し、フェンス待機後に破棄される）
     struct PendingDestroyResourceQueue
     {
-        std::vector<BufferHandle*>        buffer;
-        std::vector<TextureHandle*>       texture;
-        std::vector<TextureViewHandle*>   textureView;
-        std::vector<SamplerHandle*>       sampler;
-        std::vector<DescriptorSetHandle*> descriptorset;
-        std::vector<FramebufferHandle*>   framebuffer;
-        std::vector<ShaderHandle*>        shader;
-        std::vector<PipelineHandle*>      pipeline;
+        PendingDestroyResourceQueue(LinearAllocator* allocator)
+            : buffer(allocator)
+            , texture(allocator)
+            , textureView(allocator)
+            , sampler(allocator)
+            , descriptorset(allocator)
+            , framebuffer(allocator)
+            , shader(allocator)
+            , pipeline(allocator)
+        {}
+
+        LinearVector<BufferHandle*>        buffer;
+        LinearVector<TextureHandle*>       texture;
+        LinearVector<TextureViewHandle*>   textureView;
+        LinearVector<SamplerHandle*>       sampler;
+        LinearVector<DescriptorSetHandle*> descriptorset;
+        LinearVector<FramebufferHandle*>   framebuffer;
+        LinearVector<ShaderHandle*>        shader;
+        LinearVector<PipelineHandle*>      pipeline;
+    };
+
+    // パスごとの GPU 計測結果
+    struct GPUPassTiming
+    {
+        const char* name;
+        float       time;                // ミリ秒
+        uint64      vertexInvocations;   // パイプライン統計（無効時は 0）
+        uint64      clippingPrimitives;
+        uint64      fragmentInvocations;
+    };
+
+    // パスごとの GPU 計測クエリ（描画スレッドが記録し、同じフレームデータのフェンス待機後に BeginFrame で回収する）
+    struct GPUPassQueries
+    {
+        static constexpr uint32 maxPassCount = 16;
+
+        QueryPoolHandle* timestamp     = nullptr; // パスごとに開始・終了の 2 つ（タイムスタンプ非対応なら nullptr）
+        QueryPoolHandle* statistics    = nullptr; // パイプライン統計非対応なら nullptr
+        bool             useStatistics = false;   // このフレームで統計を記録するか（BeginFrame で決定する）
+        uint32           passCount     = 0;
+        const char*      names[maxPassCount] = {};
     };
 
     // フレームデータ
@@ -139,6 +175,14 @@ namespace Silex
         FenceHandle*                 fence            = nullptr;
         bool                         waitingSignal    = false;
         PendingDestroyResourceQueue* pendingResources = nullptr;
+        GPUPassQueries               gpuQueries       = {};
+
+        // オブジェクトID リードバック（描画スレッドが記録し、同じフレームデータのフェンス待機後に BeginFrame で回収する）
+        bool       hasIDReadback   = false;
+        glm::uvec2 idReadbackPixel = {};
+
+        // フレーム内の一時データ用（フェンスのシグナル後、次に同じフレームデータを使用する BeginFrame でリセットされる）
+        LinearAllocator* allocator = nullptr;
     };
 
     // 即時コマンドデータ
@@ -184,6 +228,7 @@ namespace Silex
 
         // フレームデータ
         const FrameData& GetFrameData()          const;
+        LinearAllocator* GetFrameAllocator()     const;
         uint32           GetCurrentFrameIndex()  const;
         uint32           GetFrameCountInFlight() const;
 
@@ -192,6 +237,16 @@ namespace Silex
 
         DescriptorSet* GetSceneImageSet() const;
 
+        // GPU 計測（直近に完了したフレームの、パスごとの GPU 時間）
+        const std::vector<GPUPassTiming>& GetGPUPassTimings()             const;
+        float                             GetGPUFrameTime()               const;
+        bool                              IsGPUTimingSupported()          const;
+        bool                              IsPipelineStatisticsSupported() const;
+
+        // パイプライン統計（呼び出し回数）の計測は任意（次の BeginFrame から反映される）
+        void SetPipelineStatisticsEnabled(bool enable);
+        bool IsPipelineStatisticsEnabled() const;
+
         //===========================================================
         // API
         //===========================================================
@@ -200,6 +255,9 @@ namespace Silex
         Texture2D* CreateTextureFromMemory(const uint8* pixelData, uint64 dataSize, uint32 width, uint32 height, bool genMipmap);
         Texture2D* CreateTextureFromMemory(const float* pixelData, uint64 dataSize, uint32 width, uint32 height, bool genMipmap);
 
+        // 転送完了をフェンスのポーリングで待機する（メインスレッドから呼び出し、完了後もメインスレッドで再開される）
+        AsyncTask<Texture2D*> CreateTextureFromMemoryAsync(const void* pixelData, uint64 dataSize, uint32 width, uint32 height, bool isHDR, bool genMipmap);
+
         // レンダーテクスチャ
         Texture2D*      CreateTexture2D(RenderingFormat format, uint32 width, uint32 height, bool genMipmap = false, TextureUsageFlags additionalFlags = 0);
         Texture2DArray* CreateTexture2DArray(RenderingFormat format, uint32 width, uint32 height, uint32 array, bool genMipmap = false, TextureUsageFlags additionalFlags = 0);
@@ -240,14 +298,28 @@ namespace Silex
         void             BeginSwapChainPass();
         void             EndSwapChainPass();
 
-        // 即時コマンド
+        // 即時コマンド（共有のコマンドプール・キューを使用するので、メインスレッドからのみ呼び出せる）
         void ImmidiateExcute(std::function<void(CommandBufferHandle*)>&& func);
+
+        // 即時コマンド（非同期）: 送信後は GPU の完了を待たずに中断し、フェンスのシグナル後にメインスレッドで再開される
+        AsyncTask<bool> ImmidiateExcuteAsync(std::function<void(CommandBufferHandle*)> func);
+
+        // 遅延コマンド: 任意のスレッドから投入でき、次の BeginFrame でメインスレッドから実行される
+        // ワーカースレッドで生成したリソースの破棄・転送要求などに使用する
+        template<typename Func>
+        void EnqueueDeferredCommand(const char* commandName, Func&& func)
+        {
+            deferredCommands.Enqueue(commandName, Traits::Forward<Func>(func));
+        }
     
     public:
 
         // ネイティブハンドル破棄
         void DestroyNativeHandle(Handle* handle)
         {
+            if (_DeferDestroyToMainThread(&Renderer::DestroyNativeHandle, handle))
+                return;
+
             FrameData& frame = frameData[frameIndex];
 
             if      (handle->IsClassOf<TextureHandle>())       frame.pendingResources->texture.push_back((TextureHandle*)handle);
@@ -262,11 +334,24 @@ namespace Silex
 
     private:
 
+        // 削除キューはメインスレッドのみが操作する
+        // 他スレッドからの破棄要求は遅延コマンドとして、次の BeginFrame でメインスレッドから積み直す
+        template<typename T>
+        bool _DeferDestroyToMainThread(void (Renderer::*destroy)(T*), T* resource)
+        {
+            if (ThreadPool::IsMainThread())
+                return false;
+
+            EnqueueDeferredCommand("Renderer::DeferredDestroy", [this, destroy, resource]() { (this->*destroy)(resource); });
+            return true;
+        }
+
         BufferHandle* _CreateAndMapBuffer(BufferUsageFlags type, const void* data, uint64 dataSize, void** outMappedPtr);
         BufferHandle* _CreateAndSubmitBufferData(BufferUsageFlags type, const void* data, uint64 dataSize);
 
         TextureHandle* _CreateTexture(TextureDimension dimension, TextureType type, RenderingFormat format, uint32 width, uint32 height, uint32 depth, uint32 array, bool genMipmap, TextureUsageFlags additionalFlags);
         void           _SubmitTextureData(TextureHandle* texture, uint32 width, uint32 height, bool genMipmap, const void* pixelData, uint64 dataSize);
+        void           _RecordTextureUpload(CommandBufferHandle* cmd, TextureHandle* texture, BufferHandle* staging, uint32 width, uint32 height, bool genMipmap);
         void           _GenerateMipmaps(CommandBufferHandle* cmd, TextureHandle* texture, uint32 width, uint32 height, uint32 depth, uint32 array, TextureAspectFlags aspect);
 
         // フレームデータ
@@ -274,6 +359,9 @@ namespace Silex
         std::vector<FrameData> frameData        = {};
         uint64                 frameIndex       = 0;
 
+        // 遅延コマンド
+        TaskQueue deferredCommands;
+
         // 固有APIレイヤー
         RenderingContext* context = nullptr;
         RenderingAPI*     api     = nullptr;
@@ -289,6 +377,18 @@ namespace Silex
         // リソース解放処理
         void _DestroyPendingResources(uint32 frame);
 
+        // GPU 計測（_BeginGPUPass / _EndGPUPass は描画スレッドから、パスの外で呼び出す）
+        void _ResetGPUPassQueries(CommandBufferHandle* cmd);
+        void _BeginGPUPass(CommandBufferHandle* cmd, const char* name);
+        void _EndGPUPass(CommandBufferHandle* cmd);
+        void _ResolveGPUPassTimings(uint32 frame);
+
+        std::vector<GPUPassTiming> gpuPassTimings           = {};
+        float                      gpuFrameTime             = 0.0f;
+        float                      timestampPeriod          = 0.0f; // 1 カウントあたりのナノ秒
+        uint64                     timestampMask            = 0;    // 有効ビットのマスク（0 ならタイムスタンプ非対応）
+        bool                       enablePipelineStatistics = false;
+
         //===========================================================
         // インスタンス
         //===========================================================
@@ -306,15 +406,21 @@ namespace Silex
         //===========================================================
 
         void TEST();
-        void Render(float dt);
+        void UpdateUBO(const SceneRenderData& renderData);
+
+        // 描画スレッドから呼び出される（シーンの情報はスナップショットからのみ取得する）
+        void Render(const SceneRenderData& renderData, float dt);
+
+        // 実際のリサイズは次の BeginFrame で行われる
         void Resize(uint32 width, uint32 height);
-        void UpdateUBO();
+        void _ApplyResize();
 
     public:
 
         // ビューポートサイズ
         glm::ivec2 sceneFramebufferSize = {};
         glm::ivec2 cameraFramebufferSize = {};
+        glm::ivec2 pendingResizeSize     = {};
 
         // Gバッファ
         void PrepareGBuffer(uint32 width, uint32 height);
@@ -344,9 +450,9 @@ namespace Silex
         // シャドウマップ
         void PrepareShadowBuffer();
         void CleanupShadowBuffer();
-        void CalculateLightSapceMatrices(glm::vec3 directionalLightDir, Camera* camera, std::array<glm::mat4, 4>& out_result);
+        void CalculateLightSapceMatrices(glm::vec3 directionalLightDir, const Camera* camera, std::array<glm::mat4, 4>& out_result);
         void GetFrustumCornersWorldSpace(const glm::mat4& projview, std::array<glm::vec4, 8>& out_result);
-        glm::mat4 GetLightSpaceMatrix(glm::vec3 directionalLightDir, Camera* camera, const float nearPlane, const float farPlane);
+        glm::mat4 GetLightSpaceMatrix(glm::vec3 directionalLightDir, const Camera* camera, const float nearPlane, const float farPlane);
         ShadowData shadow;
 
         // ブルーム
@@ -357,8 +463,15 @@ namespace Silex
         BloomData* bloom;
 
         // オブジェクトID リードバック
-        int32 ReadPixelObjectID(uint32 x, uint32 y);
-        Buffer* pixelIDBuffer = nullptr;
+        // 要求は次のフレームで記録され、そのフレームの GPU 完了後（numFramesInFlight フレーム後）に結果を取得できる
+        void RequestObjectIDReadback(uint32 x, uint32 y);
+        bool GetObjectIDReadback(int32& outID);
+        void _RecordObjectIDReadback(CommandBufferHandle* cmd, const FrameData& frame);
+        void _ResolveObjectIDReadback(uint32 frame);
+        Buffer*    pixelIDBuffer       = nullptr;
+        glm::ivec2 pendingIDReadback   = { -1, -1 };
+        int32      idReadbackResult    = -1;
+        bool       hasIDReadbackResult = false;
 
     public:
 
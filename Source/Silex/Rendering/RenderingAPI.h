@@ -32,6 +32,7 @@ namespace Silex
         virtual void DestroyCommandQueue(CommandQueueHandle* queue) = 0;
         virtual QueueID QueryQueueID(QueueFamilyFlags flag, SurfaceHandle* surface = nullptr) const = 0;
         virtual bool SubmitQueue(CommandQueueHandle* queue, CommandBufferHandle* commandbuffer, FenceHandle* fence, SemaphoreHandle* present, SemaphoreHandle* render) = 0;
+        virtual bool SubmitCommands(CommandQueueHandle* queue, CommandBufferHandle* commandbuffer, FenceHandle* fence) = 0;
 
         //--------------------------------------------------
         // コマンドプール
@@ -62,6 +63,7 @@ namespace Silex
         virtual FenceHandle* CreateFence() = 0;
         virtual void DestroyFence(FenceHandle* fence) = 0;
         virtual bool WaitFence(FenceHandle* fence) = 0;
+        virtual FenceStatus GetFenceStatus(FenceHandle* fence) = 0;
 
         //--------------------------------------------------
         // スワップチェイン
@@ -135,6 +137,19 @@ namespace Silex
         virtual PipelineHandle* CreateComputePipeline(ShaderHandle* shader) = 0;
         virtual void DestroyPipeline(PipelineHandle* pipeline) = 0;
 
+        //--------------------------------------------------
+        // クエリ
+        //--------------------------------------------------
+        virtual QueryPoolHandle* CreateQueryPool(QueryType type, uint32 numQuery, QueryPipelineStatisticFlags statistics = 0) = 0;
+        virtual void DestroyQueryPool(QueryPoolHandle* pool) = 0;
+        // GPU の完了を待たずに取得する（未完了のクエリを含む場合は false）
+        // パイプライン統計クエリは、1 クエリにつき有効な統計の数だけ値が書き込まれる
+        virtual bool GetQueryPoolResults(QueryPoolHandle* pool, uint32 firstQuery, uint32 numQuery, uint64* out_results) = 0;
+
+        // タイムスタンプの有効ビット数（0 ならそのキューではタイムスタンプを使用できない）と、1 カウントあたりのナノ秒
+        virtual uint32 GetTimestampValidBits(QueueID id) const = 0;
+        virtual float GetTimestampPeriod() const = 0;
+
         //--------------------------------------------------
         // コマンド
         //--------------------------------------------------
@@ -162,6 +177,10 @@ namespace Silex
         virtual void Cmd_BindVertexBuffers(CommandBufferHandle* commandbuffer, uint32 bindingCount, BufferHandle** buffers, uint64* offsets) = 0;
         virtual void Cmd_BindVertexBuffer(CommandBufferHandle* commandbuffer, BufferHandle* buffer, uint64 offset) = 0;
         virtual void Cmd_BindIndexBuffer(CommandBufferHandle* commandbuffer, BufferHandle* buffer, IndexBufferFormat format, uint64 offset) = 0;
+        virtual void Cmd_ResetQueryPool(CommandBufferHandle* commandbuffer, QueryPoolHandle* pool, uint32 firstQuery, uint32 numQuery) = 0;
+        virtual void Cmd_WriteTimestamp(CommandBufferHandle* commandbuffer, QueryPoolHandle* pool, uint32 query, PipelineStageBits stage) = 0;
+        virtual void Cmd_BeginQuery(CommandBufferHandle* commandbuffer, QueryPoolHandle* pool, uint32 query) = 0;
+        virtual void Cmd_EndQuery(CommandBufferHandle* commandbuffer, QueryPoolHandle* pool, uint32 query) = 0;
 
         //--------------------------------------------------
         // MISC
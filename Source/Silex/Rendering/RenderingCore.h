@@ -31,6 +31,7 @@ namespace Silex
     SL_DECLARE_HANDLE(TextureViewHandle);
     SL_DECLARE_HANDLE(TextureHandle);
     SL_DECLARE_HANDLE(ShaderHandle);
+    SL_DECLARE_HANDLE(QueryPoolHandle);
 
 
     //================================================
@@ -370,6 +371,16 @@ namespace Silex
         COMMAND_BUFFER_TYPE_MAX,
     };
 
+    //================================================
+    // フェンス
+    //================================================
+    enum FenceStatus
+    {
+        FENCE_STATUS_SIGNALED,
+        FENCE_STATUS_NOT_READY,
+        FENCE_STATUS_ERROR,     // デバイスロスト等（以降シグナルされることはない）
+    };
+
     //=================================================
     // バッファ
     //=================================================
@@ -642,6 +653,33 @@ namespace Silex
         TextureSubresourceRange subresources;
     };
 
+    //================================================
+    // クエリ
+    //================================================
+    enum QueryType
+    {
+        QUERY_TYPE_TIMESTAMP,
+        QUERY_TYPE_PIPELINE_STATISTICS,
+
+        QUERY_TYPE_MAX,
+    };
+
+    enum QueryPipelineStatisticBits
+    {
+        QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT                    = SL_BIT(0),
+        QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT                  = SL_BIT(1),
+        QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT                  = SL_BIT(2),
+        QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS_BIT                = SL_BIT(3),
+        QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES_BIT                 = SL_BIT(4),
+        QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT                       = SL_BIT(5),
+        QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT                        = SL_BIT(6),
+        QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT                = SL_BIT(7),
+        QUERY_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES_BIT        = SL_BIT(8),
+        QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT = SL_BIT(9),
+        QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT                 = SL_BIT(10),
+    };
+    using QueryPipelineStatisticFlags = uint32;
+
     //================================================
     // レンダーパス
     //================================================
@@ -211,7 +211,7 @@ namespace Silex
         VkImageView* vkview = SL_STACK(VkImageView, imageCount);
         for (uint32 i = 0; i < imageCount; i++)
         {
-            VulkanTexture* vktex = slnew(VulkanTexture);
+            VulkanTexture* vktex = textureStorage.New();
             vktex->createFlags      = 0;
             vktex->image            = vkimg[i];
             vktex->format           = swapCreateInfo.imageFormat;
@@ -273,7 +273,7 @@ namespace Silex
                 // VkImage 自体は swapchain が管理しているので破棄しない
                 //-------------------------------------------------
                 VulkanTexture* vktex = VulkanCast(swapchain->textures[i]);
-                sldelete(vktex);
+                textureStorage.Delete(vktex);
             }
 
             // スワップチェイン破棄
@@ -555,6 +555,13 @@ namespace Silex
         features2.pNext = &features_12;
         vkGetPhysicalDeviceFeatures2(context->GetPhysicalDevice(), &features2);
 
+        // サポートされている機能はすべて有効にするので、パイプライン統計クエリもサポートされていれば使用できる
+        supportPipelineStatistics = features2.features.pipelineStatisticsQuery;
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(context->GetPhysicalDevice(), &properties);
+        timestampPeriod = properties.limits.timestampPeriod;
+
         // 拡張ポインタチェイン
         void* createInfoNext = &features_12;
 
@@ -683,6 +690,24 @@ namespace Silex
         return false;
     }
 
+    bool VulkanAPI::SubmitCommands(CommandQueueHandle* queue, CommandBufferHandle* commandbuffer, FenceHandle* fence)
+    {
+        VulkanCommandQueue*  vkqueue         = VulkanCast(queue);
+        VulkanCommandBuffer* vkcommandBuffer = VulkanCast(commandbuffer);
+        VulkanFence*         vkfence         = VulkanCast(fence);
+
+        // 同期オブジェクトを待機・通知しない単純な送信（完了はフェンスで確認する）
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers    = &vkcommandBuffer->commandBuffer;
+
+        VkResult result = vkQueueSubmit(vkqueue->queue, 1, &submitInfo, vkfence? vkfence->fence : nullptr);
+        SL_CHECK_VKRESULT(result, false);
+
+        return true;
+    }
+
 
 
     //==================================================================================
@@ -859,6 +884,21 @@ namespace Silex
         return true;
     }
 
+    FenceStatus VulkanAPI::GetFenceStatus(FenceHandle* fence)
+    {
+        VulkanFence* vkfence = VulkanCast(fence);
+        VkResult result = vkGetFenceStatus(device, vkfence->fence);
+
+        // VK_NOT_READY は未完了を意味する（エラーではない）
+        if (result == VK_NOT_READY)
+            return FENCE_STATUS_NOT_READY;
+
+        // デバイスロストのフェンスはシグナルされないので、待機側が終了できるようにエラーとして返す
+        SL_CHECK_VKRESULT(result, FENCE_STATUS_ERROR);
+
+        return FENCE_STATUS_SIGNALED;
+    }
+
     //==================================================================================
     // スワップチェイン
     //==================================================================================
@@ -1023,7 +1063,7 @@ namespace Silex
         VkResult result = vmaCreateBuffer(allocator, &createInfo, &allocationCreateInfo, &vkbuffer, &allocation, &allocationInfo);
         SL_CHECK_VKRESULT(result, nullptr);
 
-        VulkanBuffer* buffer = slnew(VulkanBuffer);
+        VulkanBuffer* buffer = bufferStorage.New();
         buffer->allocationHandle = allocation;
         buffer->size             = size;
         buffer->buffer           = vkbuffer;
@@ -1043,7 +1083,7 @@ namespace Silex
             }
 
             vmaDestroyBuffer(allocator, vkbuffer->buffer, vkbuffer->allocationHandle);
-            sldelete(vkbuffer);
+            bufferStorage.Delete(vkbuffer);
         }
     }
 
@@ -1144,7 +1184,7 @@ namespace Silex
         result = vmaCreateImage(allocator, &imageCreateInfo, &allocationCreateInfo, &vkimage, &allocation, &allocationInfo);
         SL_CHECK_VKRESULT(result, nullptr);
 
-        VulkanTexture* texture = slnew(VulkanTexture);
+        VulkanTexture* texture = textureStorage.New();
         texture->allocationHandle = allocation;
         texture->image            = vkimage;
         texture->format           = (VkFormat)info.format;
@@ -1164,7 +1204,7 @@ namespace Silex
             VulkanTexture* vktexture = VulkanCast(texture);
             vmaDestroyImage(allocator, vktexture->image, vktexture->allocationHandle);
 
-            sldelete(vktexture);
+            textureStorage.Delete(vktexture);
         }
     }
 
@@ -1204,7 +1244,7 @@ namespace Silex
         VkResult result = vkCreateImageView(device, &viewCreateInfo, nullptr, &vkview);
         SL_CHECK_VKRESULT(result, nullptr);
 
-        VulkanTextureView* texview = slnew(VulkanTextureView);
+        VulkanTextureView* texview = textureViewStorage.New();
         texview->view        = vkview;
         texview->subresource = viewCreateInfo.subresourceRange;
 
@@ -1218,7 +1258,7 @@ namespace Silex
             VulkanTextureView* vkview = VulkanCast(view);
             vkDestroyImageView(device, vkview->view, nullptr);
 
-            sldelete(vkview);
+            textureViewStorage.Delete(vkview);
         }
     }
 
@@ -1252,7 +1292,7 @@ namespace Silex
         VkResult result = vkCreateSampler(device, &createInfo, nullptr, &vksampler);
         SL_CHECK_VKRESULT(result, nullptr);
 
-        VulkanSampler* sampler = slnew(VulkanSampler);
+        VulkanSampler* sampler = samplerStorage.New();
         sampler->sampler = vksampler;
 
         return sampler;
@@ -1265,7 +1305,7 @@ namespace Silex
             VulkanSampler* vksampler = (VulkanSampler * )sampler;
             vkDestroySampler(device, vksampler->sampler, nullptr);
 
-            sldelete(vksampler);
+            samplerStorage.Delete(vksampler);
         }
     }
 
@@ -1321,7 +1361,7 @@ namespace Silex
         VkResult result = vkCreateFramebuffer(device, &createInfo, nullptr, &vkfb);
         SL_CHECK_VKRESULT(result, nullptr);
 
-        VulkanFramebuffer* framebuffer = slnew(VulkanFramebuffer);
+        VulkanFramebuffer* framebuffer = framebufferStorage.New();
         framebuffer->framebuffer = vkfb;
         framebuffer->rect.x      = 0;
         framebuffer->rect.y      = 0;
@@ -1338,7 +1378,7 @@ namespace Silex
             VulkanFramebuffer* vkfb = VulkanCast(framebuffer);
             vkDestroyFramebuffer(device, vkfb->framebuffer, nullptr);
 
-            sldelete(vkfb);
+            framebufferStorage.Delete(vkfb);
         }
     }
 
@@ -1467,6 +1507,82 @@ namespace Silex
         }
     }
 
+    //==================================================================================
+    // クエリ
+    //==================================================================================
+    QueryPoolHandle* VulkanAPI::CreateQueryPool(QueryType type, uint32 numQuery, QueryPipelineStatisticFlags statistics)
+    {
+        SL_ASSERT(numQuery > 0);
+
+        VkQueryPoolCreateInfo createInfo = {};
+        createInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.queryCount = numQuery;
+
+        uint32 valuesPerQuery = 1;
+
+        if (type == QUERY_TYPE_PIPELINE_STATISTICS)
+        {
+            // 非対応の場合は、呼び出し側で計測を無効にする
+            if (!supportPipelineStatistics || statistics == 0)
+                return nullptr;
+
+            createInfo.queryType          = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            createInfo.pipelineStatistics = (VkQueryPipelineStatisticFlags)statistics;
+            valuesPerQuery                = (uint32)std::popcount(statistics);
+        }
+        else
+        {
+            createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        }
+
+        VkQueryPool vkpool = nullptr;
+        VkResult result = vkCreateQueryPool(device, &createInfo, nullptr, &vkpool);
+        SL_CHECK_VKRESULT(result, nullptr);
+
+        VulkanQueryPool* pool = slnew(VulkanQueryPool);
+        pool->pool           = vkpool;
+        pool->type           = createInfo.queryType;
+        pool->valuesPerQuery = valuesPerQuery;
+
+        return pool;
+    }
+
+    void VulkanAPI::DestroyQueryPool(QueryPoolHandle* pool)
+    {
+        if (pool)
+        {
+            VulkanQueryPool* vkpool = VulkanCast(pool);
+            vkDestroyQueryPool(device, vkpool->pool, nullptr);
+
+            sldelete(vkpool);
+        }
+    }
+
+    bool VulkanAPI::GetQueryPoolResults(QueryPoolHandle* pool, uint32 firstQuery, uint32 numQuery, uint64* out_results)
+    {
+        VulkanQueryPool* vkpool = VulkanCast(pool);
+
+        const uint64 stride   = sizeof(uint64) * vkpool->valuesPerQuery;
+        const uint64 dataSize = stride * numQuery;
+
+        // WAIT_BIT を指定しないので、未完了のクエリがあっても待機しない
+        VkResult result = vkGetQueryPoolResults(device, vkpool->pool, firstQuery, numQuery, dataSize, out_results, stride, VK_QUERY_RESULT_64_BIT);
+
+        // VK_NOT_READY は未完了を意味する（エラーではない）
+        return result == VK_SUCCESS;
+    }
+
+    uint32 VulkanAPI::GetTimestampValidBits(QueueID id) const
+    {
+        const auto& queueFamilyProperties = context->GetQueueFamilyProperties();
+        return id < queueFamilyProperties.size()? queueFamilyProperties[id].timestampValidBits : 0;
+    }
+
+    float VulkanAPI::GetTimestampPeriod() const
+    {
+        return timestampPeriod;
+    }
+
     //==================================================================================
     // コマンド
     //==================================================================================
@@ -1891,6 +2007,30 @@ namespace Silex
         vkCmdBindIndexBuffer(cmd->commandBuffer, buf->buffer, offset, format == INDEX_BUFFER_FORMAT_UINT16? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
     }
 
+    void VulkanAPI::Cmd_ResetQueryPool(CommandBufferHandle* commandbuffer, QueryPoolHandle* pool, uint32 firstQuery, uint32 numQuery)
+    {
+        VulkanCommandBuffer* cmd = VulkanCast(commandbuffer);
+        vkCmdResetQueryPool(cmd->commandBuffer, VulkanCast(pool)->pool, firstQuery, numQuery);
+    }
+
+    void VulkanAPI::Cmd_WriteTimestamp(CommandBufferHandle* commandbuffer, QueryPoolHandle* pool, uint32 query, PipelineStageBits stage)
+    {
+        VulkanCommandBuffer* cmd = VulkanCast(commandbuffer);
+        vkCmdWriteTimestamp(cmd->commandBuffer, (VkPipelineStageFlagBits)stage, VulkanCast(pool)->pool, query);
+    }
+
+    void VulkanAPI::Cmd_BeginQuery(CommandBufferHandle* commandbuffer, QueryPoolHandle* pool, uint32 query)
+    {
+        VulkanCommandBuffer* cmd = VulkanCast(commandbuffer);
+        vkCmdBeginQuery(cmd->commandBuffer, VulkanCast(pool)->pool, query, 0);
+    }
+
+    void VulkanAPI::Cmd_EndQuery(CommandBufferHandle* commandbuffer, QueryPoolHandle* pool, uint32 query)
+    {
+        VulkanCommandBuffer* cmd = VulkanCast(commandbuffer);
+        vkCmdEndQuery(cmd->commandBuffer, VulkanCast(pool)->pool, query);
+    }
+
     //==================================================================================
     // 即時コマンド
     //==================================================================================
@@ -2194,7 +2334,7 @@ namespace Silex
             return nullptr;
         }
 
-        VulkanDescriptorSet* descriptorset = slnew(VulkanDescriptorSet);
+        VulkanDescriptorSet* descriptorset = descriptorSetStorage.New();
         descriptorset->descriptorPool = vkPool;
         descriptorset->descriptorSet  = vkdescriptorset;
         descriptorset->pipelineLayout = vkShader->pipelineLayout;
@@ -2413,7 +2553,7 @@ namespace Silex
             // 同一キーのデスクリプタプールの参照カウントを減らす(参照カウントが0ならデスクリプタプールを破棄)
             _DecrementPoolRefCount(vkdescriptorset->descriptorPool, vkdescriptorset->poolKey);
 
-            sldelete(vkdescriptorset);
+            descriptorSetStorage.Delete(vkdescriptorset);
         }
     }
 
@@ -2649,7 +2789,7 @@ namespace Silex
         VkResult result = vkCreateGraphicsPipelines(device, nullptr, 1, &pipelineCreateInfo, nullptr, &vkpipeline);
         SL_CHECK_VKRESULT(result, nullptr);
 
-        VulkanPipeline* pipeline = slnew(VulkanPipeline);
+        VulkanPipeline* pipeline = pipelineStorage.New();
         pipeline->pipeline = vkpipeline;
 
         return pipeline;
@@ -2669,7 +2809,7 @@ namespace Silex
         VkResult result = vkCreateComputePipelines(device, nullptr, 1, &pipelineCreateInfo, nullptr, &vkpipeline);
         SL_CHECK_VKRESULT(result, nullptr);
 
-        VulkanPipeline* pipeline = slnew(VulkanPipeline);
+        VulkanPipeline* pipeline = pipelineStorage.New();
         pipeline->pipeline = vkpipeline;
 
         return pipeline;
@@ -2682,7 +2822,7 @@ namespace Silex
             VulkanPipeline* vkpipeline = VulkanCast(pipeline);
             vkDestroyPipeline(device, vkpipeline->pipeline, nullptr);
 
-            sldelete(vkpipeline);
+            pipelineStorage.Delete(vkpipeline);
         }
     }
 }
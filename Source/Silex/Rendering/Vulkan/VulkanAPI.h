@@ -31,6 +31,7 @@ namespace Silex
         void DestroyCommandQueue(CommandQueueHandle* queue) override;
         QueueID QueryQueueID(QueueFamilyFlags queueFlag, SurfaceHandle* surface = nullptr) const override;
         bool SubmitQueue(CommandQueueHandle* queue, CommandBufferHandle* commandbuffer, FenceHandle* fence, SemaphoreHandle* present, SemaphoreHandle* render) override;
+        bool SubmitCommands(CommandQueueHandle* queue, CommandBufferHandle* commandbuffer, FenceHandle* fence) override;
 
         //--------------------------------------------------
         // コマンドプール
@@ -58,6 +59,7 @@ namespace Silex
         FenceHandle* CreateFence() override;
         void DestroyFence(FenceHandle* fence) override;
         bool WaitFence(FenceHandle* fence) override;
+        FenceStatus GetFenceStatus(FenceHandle* fence) override;
 
         //--------------------------------------------------
         // スワップチェイン
@@ -131,6 +133,15 @@ namespace Silex
         PipelineHandle* CreateComputePipeline(ShaderHandle* shader) override;
         void DestroyPipeline(PipelineHandle* pipeline) override;
 
+        //--------------------------------------------------
+        // クエリ
+        //--------------------------------------------------
+        QueryPoolHandle* CreateQueryPool(QueryType type, uint32 numQuery, QueryPipelineStatisticFlags statistics = 0) override;
+        void DestroyQueryPool(QueryPoolHandle* pool) override;
+        bool GetQueryPoolResults(QueryPoolHandle* pool, uint32 firstQuery, uint32 numQuery, uint64* out_results) override;
+        uint32 GetTimestampValidBits(QueueID id) const override;
+        float GetTimestampPeriod() const override;
+
         //--------------------------------------------------
         // コマンド
         //--------------------------------------------------
@@ -158,6 +169,10 @@ namespace Silex
         void Cmd_BindVertexBuffers(CommandBufferHandle* commandbuffer, uint32 bindingCount, BufferHandle** buffers, uint64* offsets) override;
         void Cmd_BindVertexBuffer(CommandBufferHandle* commandbuffer, BufferHandle* buffer, uint64 offset) override;
         void Cmd_BindIndexBuffer(CommandBufferHandle* commandbuffer, BufferHandle* buffer, IndexBufferFormat format, uint64 offset) override;
+        void Cmd_ResetQueryPool(CommandBufferHandle* commandbuffer, QueryPoolHandle* pool, uint32 firstQuery, uint32 numQuery) override;
+        void Cmd_WriteTimestamp(CommandBufferHandle* commandbuffer, QueryPoolHandle* pool, uint32 query, PipelineStageBits stage) override;
+        void Cmd_BeginQuery(CommandBufferHandle* commandbuffer, QueryPoolHandle* pool, uint32 query) override;
+        void Cmd_EndQuery(CommandBufferHandle* commandbuffer, QueryPoolHandle* pool, uint32 query) override;
 
         //--------------------------------------------------
         // MISC
@@ -201,5 +216,19 @@ namespace Silex
 
         // VMAアロケータ (VulkanMemoryAllocator: VkImage/VkBuffer に関るメモリ管理を代行)
         VmaAllocator allocator = nullptr;
+
+        // クエリ関連のデバイス情報
+        float timestampPeriod           = 0.0f;
+        bool  supportPipelineStatistics = false;
+
+        // 生成数の多いオブジェクトは、型ごとのストレージに詰めて確保する
+        // （解放済みハンドルの破棄はストレージのアサートで検出される）
+        ResourceStorage<VulkanBuffer,        true> bufferStorage;
+        ResourceStorage<VulkanTexture,       true> textureStorage;
+        ResourceStorage<VulkanTextureView,   true> textureViewStorage;
+        ResourceStorage<VulkanSampler,       true> samplerStorage;
+        ResourceStorage<VulkanFramebuffer,   true> framebufferStorage;
+        ResourceStorage<VulkanDescriptorSet, true> descriptorSetStorage;
+        ResourceStorage<VulkanPipeline,      true> pipelineStorage;
     };
 }
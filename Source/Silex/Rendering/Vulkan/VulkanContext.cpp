@@ -216,16 +216,23 @@ namespace Silex
             VkPhysicalDeviceFeatures feature;
             vkGetPhysicalDeviceFeatures(pd, &feature);
 
-            // 外部GPUでジオメトリシェーダをサポートしているデバイスのみを選択
-            if (property.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU && feature.geometryShader)
+            // ジオメトリシェーダをサポートしているデバイスのみを選択
+            if (!feature.geometryShader)
+                continue;
+
+            // 外部GPUを優先し、無ければ他のデバイス（lavapipe などのソフトウェア実装を含む）を使用する
+            const bool isDiscrete = property.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
+            if (physicalDevice == nullptr || isDiscrete)
             {
                 deviceInfo.name   = property.deviceName;
                 deviceInfo.vendor = (DeviceVendor)property.vendorID;
                 deviceInfo.type   = (DeviceType)property.deviceType;
 
                 physicalDevice = pd;
-                break;
             }
+
+            if (isDiscrete)
+                break;
         }
 
         if (physicalDevice == nullptr)
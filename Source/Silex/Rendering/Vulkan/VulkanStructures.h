@@ -26,6 +26,7 @@ namespace Silex
     struct VulkanRenderPass;
     struct VulkanSurface;
     struct VulkanSwapChain;
+    struct VulkanQueryPool;
 
     template<class T> struct VulkanTypeTraits {};
     template<> struct VulkanTypeTraits<BufferHandle>        { using Internal = VulkanBuffer;        };
@@ -44,6 +45,7 @@ namespace Silex
     template<> struct VulkanTypeTraits<RenderPassHandle>    { using Internal = VulkanRenderPass;    };
     template<> struct VulkanTypeTraits<SurfaceHandle>       { using Internal = VulkanSurface;       };
     template<> struct VulkanTypeTraits<SwapChainHandle>     { using Internal = VulkanSwapChain;     };
+    template<> struct VulkanTypeTraits<QueryPoolHandle>     { using Internal = VulkanQueryPool;     };
 
     //=============================================
     // Vulkan 型キャスト
@@ -107,6 +109,14 @@ namespace Silex
         VkFence fence = nullptr;
     };
 
+    // クエリプール
+    struct VulkanQueryPool : public QueryPoolHandle
+    {
+        VkQueryPool pool           = nullptr;
+        VkQueryType type           = VK_QUERY_TYPE_TIMESTAMP;
+        uint32      valuesPerQuery = 1; // パイプライン統計は、有効な統計の数だけ値を持つ
+    };
+
     // レンダーパス
     struct VulkanRenderPass : public RenderPassHandle
     {
@@ -14,9 +14,9 @@ namespace Silex
     {
         SL_CLASS(InstanceComponent, Class)
 
-        uint64      id;
-        bool        active;
-        std::string name;
+        uint64   id;
+        bool     active;
+        StringID name;
     };
 
 
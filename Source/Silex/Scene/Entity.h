@@ -53,8 +53,8 @@ namespace Silex
         operator entt::entity() const { return entityHandle;               }
         operator uint32()       const { return (uint32)entityHandle;       }
 
-        uint64             GetID()   { return GetComponent<InstanceComponent>().id;   }
-        const std::string& GetName() { return GetComponent<InstanceComponent>().name; }
+        uint64   GetID()   { return GetComponent<InstanceComponent>().id;   }
+        StringID GetName() { return GetComponent<InstanceComponent>().name; }
 
         bool operator==(const Entity& other) const
         {
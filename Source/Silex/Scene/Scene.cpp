@@ -2,7 +2,8 @@
 #include "PCH.h"
 
 #include "Core/Random.h"
-#include "Core/Timer.h"
+#include "Core/Profiler.h"
+#include "Core/Parallel.h"
 #include "Scene/Scene.h"
 #include "Scene/Entity.h"
 
@@ -22,51 +23,80 @@ namespace Silex
         entity.AddComponent<InstanceComponent>();
         entity.AddComponent<TransformComponent>();
 
+        // Static はテーブルに登録しないので、既定名は初回に一度だけ登録する（逆引きで文字列を得るため）
+        static const StringID defaultName("Empty");
+
         auto& c  = entity.GetComponent<InstanceComponent>();
-        c.name   = name.empty()? "Empty" : name;
+        c.name   = name.empty()? defaultName : StringID(name);
         c.id     = id;
         c.active = active;
 
         entityMap[id] = entity;
+        entityNameMap.try_emplace(c.name, entity);
 
         return entity;
     }
 
     void Scene::DestroyEntity(Entity entity)
     {
+        auto it = entityNameMap.find(entity.GetName());
+        if (it != entityNameMap.end() && it->second == (entt::entity)entity)
+        {
+            entityNameMap.erase(it);
+        }
+
         entityMap.erase(entity.GetID());
         registry.destroy(entity);
     }
 
-    Entity Scene::FindEntity(const std::string& name)
+    Entity Scene::FindEntity(StringID name)
     {
+        auto it = entityNameMap.find(name);
+        if (it != entityNameMap.end())
+        {
+            const entt::entity entity = it->second;
+            if (registry.valid(entity) && registry.get<InstanceComponent>(entity).name == name) SL_LIKELY
+            {
+                return { entity, this };
+            }
+        }
+
+        // 索引にない、または名前の変更 / 削除で古くなっている場合は走査して索引を更新する
         const auto& view = registry.view<InstanceComponent>();
         for (auto entity : view)
         {
             const InstanceComponent& nc = view.get<InstanceComponent>(entity);
             if (nc.name == name)
             {
+                entityNameMap[name] = entity;
                 return { entity, this };
             }
         }
 
+        if (it != entityNameMap.end())
+        {
+            entityNameMap.erase(it);
+        }
+
         return {};
     }
 
     Entity Scene::FindEntity(uint64 id)
     {
-        if (entityMap.contains(id))
+        auto it = entityMap.find(id);
+        if (it != entityMap.end())
         {
-            return { entityMap.at(id), this };
+            return { it->second, this };
         }
 
         return {};
     }
 
-    void Scene::Update(float deltaTime, Camera& camera, SceneRenderer* renderer)
+    void Scene::Update(float deltaTime, const Camera& camera, SceneRenderData& outRenderData)
     {
-        // 描画データ更新
-        //renderer->BeginFrame(this, &camera);
+        // 前回このバッファに書き込んだ内容は、描画スレッドで使用済み
+        outRenderData.Clear();
+        outRenderData.camera = camera;
 
         {
             SL_SCOPE_PROFILE("Scene::Update");
@@ -106,38 +136,67 @@ namespace Silex
             // ディレクショナルライト
             for (auto entity : directional)
             {
-                // シーンレンダラーの平行光源リストへ追加（現状 1個のみ）
+                // スナップショットの平行光源へ設定（現状 1個のみ）
                 auto [tc, dc, ic] = directional.get<TransformComponent, DirectionalLightComponent, InstanceComponent>(entity);
                 if (ic.active)
                 {
                     // (0, 0, 1)ベクトル を基準（0°）として回転させた値を適応
                     dc.direction = -glm::mat3(tc.GetTransform()) * glm::vec3(0.0f, 0.0f, 1.0f);
-                    //renderer->SetDirectionalLight(dc);
+
+                    outRenderData.hasDirectionalLight       = true;
+                    outRenderData.directionalLightDirection = dc.direction;
+                    outRenderData.directionalLightColor     = dc.color;
+                    outRenderData.directionalLightIntencity = dc.intencity;
                 }
 
                 // 現状1つのみ受け付ける
                 break;
             }
 
-            // メッシュ
-            for (entt::entity entity : meshes)
+            // メッシュ: エンティティごとに独立しているので並列に処理し、描画対象外のスロットは後で詰める
+            std::vector<MeshDrawData>&           meshDrawList = outRenderData.meshDrawList;
+            std::vector<RefView<MaterialAsset>>& materialList = outRenderData.materialList;
+            meshDrawList.resize(meshes.size());
+
+            // マテリアルの格納位置を先に確定しておく（並列処理中に配列を伸ばさない）
+            uint32 materialCount = 0;
+            for (uint64 i = 0; i < meshes.size(); i++)
+            {
+                const MeshComponent& mc = meshes.get<MeshComponent>(meshes[i]);
+
+                meshDrawList[i].materialOffset = materialCount;
+                meshDrawList[i].materialCount  = (uint32)mc.materials.size();
+                materialCount += (uint32)mc.materials.size();
+            }
+
+            materialList.resize(materialCount);
+
+            // 借用参照のコピーのみなので、参照カウントのアトミック操作は発生しない
+            ParallelFor(0, meshes.size(), [&](uint64 i)
             {
+                entt::entity entity = meshes[i];
                 auto [tc, mc, ic] = meshes.get<TransformComponent, MeshComponent, InstanceComponent>(entity);
 
+                MeshDrawData& data = meshDrawList[i];
                 if (ic.active)
                 {
-                    MeshDrawData data;
-                    data.mesh      = mc;
-                    data.transform = tc.GetTransform();
-                    data.entityID  = (int32)entity;
-
-                    // シーンレンダラーの描画リストへ追加
-                    //renderer->AddMeshDrawList(data);
+                    data.mesh       = mc.mesh;
+                    data.castShadow = mc.castShadow;
+                    data.transform  = tc.GetTransform();
+                    data.entityID   = (int32)entity;
+
+                    for (uint32 m = 0; m < data.materialCount; m++)
+                    {
+                        materialList[data.materialOffset + m] = mc.materials[m];
+                    }
                 }
-            }
-        }
+                else
+                {
+                    data.mesh = nullptr;
+                }
+            });
 
-        // 描画パス実行
-        //renderer->EndFrame();
+            std::erase_if(meshDrawList, [](const MeshDrawData& data) { return data.mesh == nullptr; });
+        }
     }
 }
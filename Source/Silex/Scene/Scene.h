@@ -2,24 +2,18 @@
 #pragma once
 
 #include "Core/Ref.h"
+#include "Core/FlatHashMap.h"
 #include "Scene/Camera.h"
 #include "Scene/Components.h"
+#include "Scene/SceneRenderer.h"
 #include <entt/entt.hpp>
 
 
 
 namespace Silex
 {
-    class SceneRenderer;
     class Entity;
 
-    struct MeshDrawData
-    {
-        MeshComponent mesh;
-        int32         entityID;
-        glm::mat4     transform;
-    };
-
     class Scene : public Object
     {
         SL_CLASS(Scene, Object)
@@ -33,15 +27,22 @@ namespace Silex
         Entity CreateEntity(uint64 id, const std::string& name = std::string(), bool active = true);
         void   DestroyEntity(Entity entity);
 
-        Entity FindEntity(const std::string& name);
+        Entity FindEntity(StringID name);
         Entity FindEntity(uint64 id);
 
-        void Update(float deltaTime, Camera& camera, SceneRenderer* renderer);
+        // 破棄済みのハンドルでないか
+        bool IsValidEntity(entt::entity handle) const { return registry.valid(handle); }
+
+        // シーンを更新し、描画に必要なデータを outRenderData へ書き出す
+        void Update(float deltaTime, const Camera& camera, SceneRenderData& outRenderData);
 
     private:
 
-        entt::registry                           registry;
-        std::unordered_map<uint64, entt::entity> entityMap;
+        entt::registry                       registry;
+        FlatHashMap<uint64, entt::entity>    entityMap;
+
+        // 名前検索用の索引（名前は重複 / エディターから直接変更されるので、検索時に検証する）
+        FlatHashMap<StringID, entt::entity>  entityNameMap;
 
     private:
 
@@ -5,5 +5,15 @@
 
 namespace Silex
 {
+    SceneRenderer::SceneRenderer()
+    {
+        renderData[0] = slnew(SceneRenderData);
+        renderData[1] = slnew(SceneRenderData);
+    }
 
+    SceneRenderer::~SceneRenderer()
+    {
+        sldelete(renderData[0]);
+        sldelete(renderData[1]);
+    }
 }
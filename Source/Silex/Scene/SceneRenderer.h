@@ -1,12 +1,86 @@
-
 #pragma once
 #include "Core/CoreType.h"
+#include "Scene/Camera.h"
+#include "Scene/Components.h"
+#include <span>
 
 
 namespace Silex
 {
+    // アセットは借用参照で保持し、毎フレームの参照カウント操作を避ける
+    // （所有者が手放しても、DeferredRelease により描画が終わるまでは破棄されない）
+    struct MeshDrawData
+    {
+        RefView<MeshAsset> mesh;
+        uint32             materialOffset = 0; // SceneRenderData::materialList 内の位置
+        uint32             materialCount  = 0;
+        bool               castShadow     = true;
+        int32              entityID       = 0;
+        glm::mat4          transform;
+    };
+
+    //==================================================================
+    // 描画用シーンスナップショット
+    //------------------------------------------------------------------
+    // Scene::Update で生成され、描画スレッドはこのデータのみを参照する
+    // 描画中にシミュレーション側がシーンを書き換えても影響を受けない
+    //==================================================================
+    struct SceneRenderData
+    {
+        // カメラ（値コピー）
+        Camera camera;
+
+        // ディレクショナルライト（現状1つのみ）
+        bool      hasDirectionalLight       = false;
+        glm::vec3 directionalLightDirection = { 0.0f, 0.0f, 0.0f };
+        glm::vec3 directionalLightColor     = { 1.0f, 1.0f, 1.0f };
+        float     directionalLightIntencity = 1.0f;
+
+        // 描画対象メッシュと、各メッシュのマテリアル（メッシュごとに連続して格納）
+        std::vector<MeshDrawData>           meshDrawList;
+        std::vector<RefView<MaterialAsset>> materialList;
+
+        std::span<const RefView<MaterialAsset>> GetMaterials(const MeshDrawData& data) const
+        {
+            return { materialList.data() + data.materialOffset, data.materialCount };
+        }
+
+        // 要素は破棄するが、描画リストの容量は次フレームで再利用する
+        void Clear()
+        {
+            hasDirectionalLight = false;
+            meshDrawList.clear();
+            materialList.clear();
+        }
+    };
+
+    //==================================================================
+    // シーン描画データのダブルバッファ
+    //------------------------------------------------------------------
+    // シミュレーション側が書き込むスナップショットと、描画スレッドが読み取るスナップショットを分離し
+    // フレーム N の描画とフレーム N+1 のシミュレーションを並行させる
+    // Swap は描画スレッドの完了後に、メインスレッドから呼び出すこと
+    //==================================================================
     class SceneRenderer
     {
+    public:
+
+        SceneRenderer();
+        ~SceneRenderer();
+
+        SceneRenderer(const SceneRenderer&)            = delete;
+        SceneRenderer& operator=(const SceneRenderer&) = delete;
+
+        SceneRenderData&       GetSimulationData()       { return *renderData[simulationIndex];     }
+        const SceneRenderData& GetRenderData()     const { return *renderData[simulationIndex ^ 1]; }
+
+        // シミュレーションが完了したスナップショットを描画側へ渡す
+        void Swap() { simulationIndex ^= 1; }
+
+    private:
 
+        // 所有者（Editor）のサイズを抑えるため、ヒープに確保する
+        SceneRenderData* renderData[2]   = {};
+        uint32           simulationIndex = 0;
     };
 }
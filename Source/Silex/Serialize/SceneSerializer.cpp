@@ -38,7 +38,7 @@ namespace Silex
                 out << YAML::BeginMap;
 
                 auto& c = entity.GetComponent<InstanceComponent>();
-                out << YAML::Key << "name"   << YAML::Value << c.name;
+                out << YAML::Key << "name"   << YAML::Value << c.name.c_str();
                 out << YAML::Key << "active" << YAML::Value << c.active;
 
                 out << YAML::EndMap;
@@ -0,0 +1,270 @@
+
+#include "PCH.h"
+#include "Core/FlatHashMap.h"
+#include "UnitTest.h"
+
+#include <random>
+#include <unordered_map>
+
+
+//==================================================================
+// FlatHashMap テスト
+//------------------------------------------------------------------
+// std::unordered_map と同じ操作列を適用して、内容が一致し続けることを確認する
+//==================================================================
+namespace Silex::Test
+{
+    // 全てのキーを同じグループに集めて、グループを跨ぐ探索と削除済みスロットを発生させる
+    struct CollidingHash
+    {
+        uint64 operator()(uint64 key) const
+        {
+            return key & 0x7F;
+        }
+    };
+
+    template<typename Map>
+    static bool IsSameContents(const Map& map, const std::unordered_map<uint64, uint64>& reference)
+    {
+        if (map.size() != reference.size())
+            return false;
+
+        uint64 numIterated = 0;
+        for (const auto& [key, value] : map)
+        {
+            const auto it = reference.find(key);
+            if (it == reference.end() || it->second != value)
+                return false;
+
+            numIterated++;
+        }
+
+        return numIterated == reference.size();
+    }
+
+    template<typename Map>
+    static bool RunRandomOperations(Map& map, uint64 numOperations, uint64 keyRange, uint64 seed)
+    {
+        std::unordered_map<uint64, uint64> reference;
+        std::mt19937_64 random(seed);
+
+        for (uint64 i = 0; i < numOperations; i++)
+        {
+            const uint64 key = random() % keyRange;
+
+            switch (random() % 4)
+            {
+                case 0:
+                {
+                    map[key]       = i;
+                    reference[key] = i;
+                    break;
+                }
+                case 1:
+                {
+                    if (map.erase(key) != reference.erase(key))
+                        return false;
+
+                    break;
+                }
+                case 2:
+                {
+                    const auto result    = map.try_emplace(key, i);
+                    const auto expected  = reference.try_emplace(key, i);
+                    if (result.second != expected.second || result.first->second != expected.first->second)
+                        return false;
+
+                    break;
+                }
+                case 3:
+                {
+                    const auto found    = map.find(key);
+                    const auto expected = reference.find(key);
+                    if ((found == map.end()) != (expected == reference.end()))
+                        return false;
+
+                    if (found != map.end() && found->second != expected->second)
+                        return false;
+
+                    break;
+                }
+            }
+
+            if (map.size() != reference.size())
+                return false;
+        }
+
+        return IsSameContents(map, reference);
+    }
+
+
+    SL_TEST(FlatHashMap_InsertFind)
+    {
+        FlatHashMap<uint64, uint64> map;
+        SL_TEST_CHECK(map.empty());
+        SL_TEST_CHECK(map.find(0) == map.end());
+
+        for (uint64 i = 0; i < 1000; i++)
+        {
+            const auto result = map.insert({ i, i * 3 });
+            SL_TEST_CHECK(result.second);
+            SL_TEST_CHECK(result.first->first == i);
+        }
+
+        // 既存キーへの insert / try_emplace は値を変更しない
+        SL_TEST_CHECK(!map.insert({ 10, 0 }).second);
+        SL_TEST_CHECK(!map.try_emplace(10, 0).second);
+        SL_TEST_CHECK(map.at(10) == 30);
+
+        // insert_or_assign は上書きする
+        SL_TEST_CHECK(!map.insert_or_assign(10, 1).second);
+        SL_TEST_CHECK(map.at(10) == 1);
+
+        SL_TEST_CHECK(map.size() == 1000);
+        for (uint64 i = 0; i < 1000; i++)
+        {
+            SL_TEST_CHECK(map.contains(i));
+        }
+
+        SL_TEST_CHECK(!map.contains(1000));
+    }
+
+    SL_TEST(FlatHashMap_Erase)
+    {
+        FlatHashMap<uint64, uint64> map;
+        for (uint64 i = 0; i < 1000; i++)
+            map[i] = i;
+
+        SL_TEST_CHECK(map.erase(5)    == 1);
+        SL_TEST_CHECK(map.erase(5)    == 0);
+        SL_TEST_CHECK(map.erase(5000) == 0);
+        SL_TEST_CHECK(!map.contains(5));
+
+        // 削除は他の要素を移動しないので、残った要素への参照は有効なまま
+        uint64& kept = map.at(6);
+
+        // イテレーターを使った削除中の走査
+        for (auto it = map.begin(); it != map.end();)
+        {
+            if (it->first & 1)
+                it = map.erase(it);
+            else
+                ++it;
+        }
+
+        SL_TEST_CHECK(&kept == &map.at(6));
+        SL_TEST_CHECK(map.size() == 500);
+
+        for (const auto& [key, value] : map)
+        {
+            SL_TEST_CHECK((key & 1) == 0);
+        }
+    }
+
+    SL_TEST(FlatHashMap_Rehash)
+    {
+        FlatHashMap<uint64, uint64> map;
+
+        // 拡張を繰り返しても、既存要素が失われない
+        uint64 lastCapacity = map.capacity();
+        uint64 numRehash    = 0;
+        for (uint64 i = 0; i < 100000; i++)
+        {
+            map[i * 7919] = i;
+
+            if (map.capacity() != lastCapacity)
+            {
+                lastCapacity = map.capacity();
+                numRehash++;
+            }
+        }
+
+        SL_TEST_CHECK(numRehash > 1);
+        SL_TEST_CHECK(map.size() == 100000);
+
+        for (uint64 i = 0; i < 100000; i++)
+        {
+            SL_TEST_CHECK(map.at(i * 7919) == i);
+        }
+
+        // 事前確保した容量内では再構築しない
+        FlatHashMap<uint64, uint64> reserved;
+        reserved.reserve(1000);
+
+        const uint64 reservedCapacity = reserved.capacity();
+        for (uint64 i = 0; i < 1000; i++)
+            reserved[i] = i;
+
+        SL_TEST_CHECK(reserved.capacity() == reservedCapacity);
+    }
+
+    // 要素数が一定なら、挿入と削除を繰り返しても削除済みスロットの掃除で容量は増え続けない
+    SL_TEST(FlatHashMap_TombstoneReuse)
+    {
+        FlatHashMap<uint64, uint64, CollidingHash> map;
+        for (uint64 i = 0; i < 64; i++)
+            map[i] = i;
+
+        const uint64 initialCapacity = map.capacity();
+
+        for (uint64 i = 64; i < 100000; i++)
+        {
+            map.erase(i - 64);
+            map[i] = i;
+        }
+
+        SL_TEST_CHECK(map.size() == 64);
+        SL_TEST_CHECK(map.capacity() <= initialCapacity * 2);
+
+        for (uint64 i = 100000 - 64; i < 100000; i++)
+        {
+            SL_TEST_CHECK(map.at(i) == i);
+        }
+    }
+
+    SL_TEST(FlatHashMap_RandomOperations)
+    {
+        FlatHashMap<uint64, uint64> map;
+        SL_TEST_CHECK(RunRandomOperations(map, 200000, 5000, 1));
+
+        FlatHashMap<uint64, uint64, CollidingHash> colliding;
+        SL_TEST_CHECK(RunRandomOperations(colliding, 50000, 500, 2));
+    }
+
+    SL_TEST(FlatHashMap_CopyMove)
+    {
+        FlatHashMap<uint64, std::string> map;
+        for (uint64 i = 0; i < 1000; i++)
+            map[i] = std::to_string(i);
+
+        FlatHashMap<uint64, std::string> copied = map;
+        SL_TEST_CHECK(copied.size() == map.size());
+
+        FlatHashMap<uint64, std::string> moved = std::move(copied);
+        SL_TEST_CHECK(moved.size() == map.size());
+        SL_TEST_CHECK(copied.empty());
+
+        for (const auto& [key, value] : map)
+        {
+            SL_TEST_CHECK(moved.at(key) == value);
+        }
+
+        moved.clear();
+        SL_TEST_CHECK(moved.empty());
+        SL_TEST_CHECK(moved.find(1) == moved.end());
+    }
+
+    SL_TEST(FlatHashMap_HeterogeneousLookup)
+    {
+        FlatHashMap<std::string, int32> map;
+        map.emplace("Silex", 1);
+        map["Editor"] = 2;
+
+        SL_TEST_CHECK(map.contains("Silex"));
+        SL_TEST_CHECK(map.at(std::string_view("Editor")) == 2);
+        SL_TEST_CHECK(map.find(std::string_view("Renderer")) == map.end());
+
+        SL_TEST_CHECK(map.erase(std::string_view("Editor")) == 1);
+        SL_TEST_CHECK(map.size() == 1);
+    }
+}
@@ -0,0 +1,121 @@
+
+#include "PCH.h"
+#include "Core/Hash.h"
+#include "UnitTest.h"
+
+
+//==================================================================
+// xxHash 既知値テスト
+//------------------------------------------------------------------
+// 期待値は参照実装 (xxHash v0.8) で計算したもの
+// 入力は GetPattern で生成し、XXH3 の各長さの分岐（0 / 1-3 / 4-8 / 9-16 / 17-128 / 129-240 / 241 以上）と
+// ブロック境界（1024 バイト）を跨ぐ長さを含める
+//==================================================================
+namespace Silex::Test
+{
+    struct KnownAnswer
+    {
+        uint64 length;
+        uint64 xxh3;
+        uint64 xxh64;
+        uint64 xxh3Seeded;
+        uint64 xxh64Seeded;
+    };
+
+    static constexpr uint64 knownAnswerSeed = 0x9E3779B97F4A7C15ULL;
+
+    static constexpr KnownAnswer knownAnswers[] =
+    {
+        {      0, 0x2D06800538D394C2ULL, 0xEF46DB3751D8E999ULL, 0x602B0E2CD6662C8BULL, 0xC4349FC93C010000ULL },
+        {      1, 0xC44BDFF4074EECDBULL, 0xE934A84ADB052768ULL, 0x062B185E4E01441AULL, 0x126BB57A12364AA5ULL },
+        {      3, 0x6811538B444FC6DCULL, 0xA83378D1EB86EC62ULL, 0xF4A795D2019D121AULL, 0x22F4AAA6A7ABCB74ULL },
+        {      4, 0xED503340C589A28BULL, 0x9882E57ED36C4CFCULL, 0xF5AEE1C988BF33E7ULL, 0x499FEE07183420C5ULL },
+        {      8, 0xE5B43AB074C9C13BULL, 0xA5BC8D8944331FE7ULL, 0xA1C0D07AE3B3CAD9ULL, 0x66C50C48C04F54F2ULL },
+        {      9, 0x089B8D25B20FB877ULL, 0x17006424A894094AULL, 0x474718B6A471D8B0ULL, 0x4514DEF3D9B37787ULL },
+        {     16, 0x0A0EC5AE8679CB7FULL, 0x9CB21DF76892D962ULL, 0x95D332B0C4696F0CULL, 0x77764121E73DF9B7ULL },
+        {     17, 0x57C52D21CE492C1EULL, 0x8839744DA5EBCE07ULL, 0x7F95C4DD352ADA88ULL, 0x299DC4AD51D2A436ULL },
+        {    128, 0x696069C4F1E6A91AULL, 0xA2A5C849215E5023ULL, 0x4ECDFD294E836728ULL, 0x28E305D0F0A1F636ULL },
+        {    129, 0x34DFC256C90565F6ULL, 0x2FBB49EA750E7F35ULL, 0x768E8C6CF04BF2C6ULL, 0x4946E6E9A88A0B7BULL },
+        {    240, 0xC92D1E75D8E9B86AULL, 0x91EA90DBD61A1324ULL, 0x056BFEC4B5E500D8ULL, 0xA86E3C6D4F89BED6ULL },
+        {    241, 0x8EC323309081B1D1ULL, 0x2130D78C062A5661ULL, 0xDB9AA089871BDE9AULL, 0x056729E366C4C443ULL },
+        {   1024, 0x0768CBF99558CBDAULL, 0x56ABBB189CE2FF11ULL, 0xF39107F933235917ULL, 0x06A6B7BE0FACE510ULL },
+        {   1025, 0x72182781B24CCA49ULL, 0x185D44C7F768F7F4ULL, 0x60BE6234C3FA28FBULL, 0x65590F4985508E60ULL },
+        {   4096, 0x3A05B2DECF62A0A8ULL, 0xA8F2F189ABC83CABULL, 0x3565C12FCD905E89ULL, 0x41EAAA22B550EEF8ULL },
+        { 100000, 0x5AF14EB6D9DC4705ULL, 0x977A440BC7F7DD1FULL, 0x3AEF1C08C1BD5B7EULL, 0x5024EDF7E3A9F756ULL },
+    };
+
+    static std::vector<uint8> GetPattern(uint64 length)
+    {
+        std::vector<uint8> data(length);
+        for (uint64 i = 0; i < length; i++)
+        {
+            data[i] = (uint8)((i * 131) ^ (i >> 7));
+        }
+
+        return data;
+    }
+
+    // コンパイル時版も参照実装と一致する
+    static_assert(Hash::StaticXXH3("")                           == 0x2D06800538D394C2ULL);
+    static_assert(Hash::StaticXXH64("")                          == 0xEF46DB3751D8E999ULL);
+    static_assert(Hash::StaticXXH3("abc")                        == 0x78AF5F94892F3950ULL);
+    static_assert(Hash::StaticXXH64("abc")                       == 0x44BC2CF5AD770999ULL);
+    static_assert(Hash::StaticXXH3("Assets/Shaders/PBR.glsl", 7)  == 0x06E07CDF14D6E98FULL);
+    static_assert(Hash::StaticXXH64("Assets/Shaders/PBR.glsl", 7) == 0x26180F921C02C436ULL);
+
+
+    SL_TEST(Hash_XXH3_KnownAnswer)
+    {
+        for (const KnownAnswer& answer : knownAnswers)
+        {
+            const std::vector<uint8> data = GetPattern(answer.length);
+
+            SL_TEST_CHECK(Hash::XXH3(data.data(), data.size())                  == answer.xxh3);
+            SL_TEST_CHECK(Hash::XXH3(data.data(), data.size(), knownAnswerSeed) == answer.xxh3Seeded);
+        }
+
+        SL_TEST_CHECK(Hash::XXH3(std::string_view("Silex"))    == 0xB347399836013900ULL);
+        SL_TEST_CHECK(Hash::XXH3(std::string_view("Silex"), 7) == 0x6EDBFE971926AF09ULL);
+    }
+
+    SL_TEST(Hash_XXH64_KnownAnswer)
+    {
+        for (const KnownAnswer& answer : knownAnswers)
+        {
+            const std::vector<uint8> data = GetPattern(answer.length);
+
+            SL_TEST_CHECK(Hash::XXH64(data.data(), data.size())                  == answer.xxh64);
+            SL_TEST_CHECK(Hash::XXH64(data.data(), data.size(), knownAnswerSeed) == answer.xxh64Seeded);
+        }
+
+        SL_TEST_CHECK(Hash::XXH64("Silex", 5)    == 0x29247FC925F195ABULL);
+        SL_TEST_CHECK(Hash::XXH64("Silex", 5, 7) == 0x8A0445B65F502FDCULL);
+    }
+
+    // 分割して入力しても、一括計算と同じ値になる
+    SL_TEST(Hash_Stream_KnownAnswer)
+    {
+        static constexpr uint64 splitSizes[] = { 1, 7, 64, 255, 1000 };
+
+        for (const KnownAnswer& answer : knownAnswers)
+        {
+            const std::vector<uint8> data = GetPattern(answer.length);
+
+            for (uint64 split : splitSizes)
+            {
+                XXH3Stream  xxh3(knownAnswerSeed);
+                XXH64Stream xxh64(knownAnswerSeed);
+
+                for (uint64 offset = 0; offset < data.size(); offset += split)
+                {
+                    const uint64 size = std::min(split, data.size() - offset);
+                    xxh3.Update(data.data() + offset, size);
+                    xxh64.Update(data.data() + offset, size);
+                }
+
+                SL_TEST_CHECK(xxh3.Digest()  == answer.xxh3Seeded);
+                SL_TEST_CHECK(xxh64.Digest() == answer.xxh64Seeded);
+            }
+        }
+    }
+}
@@ -0,0 +1,160 @@
+
+#include "PCH.h"
+#include "Core/LinearAllocator.h"
+#include "UnitTest.h"
+
+#include <algorithm>
+#include <thread>
+
+
+//==================================================================
+// LinearAllocator テスト
+//==================================================================
+namespace Silex::Test
+{
+    static bool IsAligned(const void* ptr, uint64 alignment)
+    {
+        return (reinterpret_cast<uintptr_t>(ptr) & (alignment - 1)) == 0;
+    }
+
+
+    SL_TEST(LinearAllocator_Alignment)
+    {
+        LinearAllocator allocator;
+        allocator.Initialize(4096);
+
+        static constexpr uint64 alignments[] = { 1, 2, 4, 8, 16, 32, 64, 256 };
+
+        for (uint64 i = 0; i < 100; i++)
+        {
+            for (uint64 alignment : alignments)
+            {
+                void* ptr = allocator.Allocate(i % 13 + 1, alignment);
+                SL_TEST_CHECK(ptr != nullptr);
+                SL_TEST_CHECK(IsAligned(ptr, alignment));
+            }
+        }
+
+        struct alignas(64) Aligned { uint8 data[3]; };
+        SL_TEST_CHECK(IsAligned(allocator.New<Aligned>(), 64));
+        SL_TEST_CHECK(IsAligned(allocator.NewArray<Aligned>(5), 64));
+    }
+
+    // 確保した領域同士が重ならず、ブロックを跨いでも書き込んだ内容が保持される
+    SL_TEST(LinearAllocator_Growth)
+    {
+        LinearAllocator allocator;
+        allocator.Initialize(1024);
+
+        std::vector<std::pair<uint8*, uint64>> allocations;
+        for (uint64 i = 0; i < 1000; i++)
+        {
+            const uint64 size = i % 97 + 1;
+
+            uint8* ptr = static_cast<uint8*>(allocator.Allocate(size));
+            std::fill(ptr, ptr + size, (uint8)i);
+
+            allocations.push_back({ ptr, size });
+        }
+
+        // ブロックサイズより大きな確保も受け付ける
+        uint8* large = static_cast<uint8*>(allocator.Allocate(8192));
+        std::fill(large, large + 8192, (uint8)0xAB);
+
+        SL_TEST_CHECK(allocator.GetCapacity() > 1024);
+        SL_TEST_CHECK(allocator.GetUsedSize() <= allocator.GetCapacity());
+
+        for (uint64 i = 0; i < allocations.size(); i++)
+        {
+            const auto [ptr, size] = allocations[i];
+            SL_TEST_CHECK(std::all_of(ptr, ptr + size, [i](uint8 value) { return value == (uint8)i; }));
+        }
+
+        SL_TEST_CHECK(std::all_of(large, large + 8192, [](uint8 value) { return value == 0xAB; }));
+    }
+
+    // Reset 後はブロックを保持したまま再利用し、容量が増えない
+    SL_TEST(LinearAllocator_Reset)
+    {
+        LinearAllocator allocator;
+        allocator.Initialize(1024);
+
+        for (uint64 i = 0; i < 100; i++)
+            allocator.Allocate(100);
+
+        const uint64 capacity = allocator.GetCapacity();
+        SL_TEST_CHECK(allocator.GetUsedSize() >= 100 * 100);
+
+        for (uint32 frame = 0; frame < 10; frame++)
+        {
+            allocator.Reset();
+            SL_TEST_CHECK(allocator.GetUsedSize() == 0);
+
+            for (uint64 i = 0; i < 100; i++)
+                allocator.Allocate(100);
+
+            SL_TEST_CHECK(allocator.GetCapacity() == capacity);
+        }
+
+        allocator.Release();
+        SL_TEST_CHECK(allocator.GetCapacity() == 0);
+    }
+
+    SL_TEST(LinearAllocator_Vector)
+    {
+        LinearAllocator allocator;
+        allocator.Initialize(1024);
+
+        LinearVector<uint64> values(&allocator);
+        for (uint64 i = 0; i < 10000; i++)
+            values.push_back(i);
+
+        bool isValid = true;
+        for (uint64 i = 0; i < values.size(); i++)
+            isValid &= values[i] == i;
+
+        SL_TEST_CHECK(isValid);
+        SL_TEST_CHECK(values.size() == 10000);
+    }
+
+    // 複数スレッドから同時に確保しても、領域が重ならない
+    SL_TEST(LinearAllocator_Concurrent)
+    {
+        static constexpr uint32 numThreads          = 8;
+        static constexpr uint32 numAllocationPerThread = 5000;
+
+        LinearAllocator allocator;
+        allocator.Initialize(4096);
+
+        std::vector<uint32*> allocations[numThreads];
+        std::vector<std::thread> threads;
+
+        for (uint32 t = 0; t < numThreads; t++)
+        {
+            threads.emplace_back([&allocator, &allocations, t]()
+            {
+                for (uint32 i = 0; i < numAllocationPerThread; i++)
+                {
+                    uint32* ptr = allocator.New<uint32>(t * numAllocationPerThread + i);
+                    allocations[t].push_back(ptr);
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        std::vector<uint32*> all;
+        for (uint32 t = 0; t < numThreads; t++)
+        {
+            for (uint32 i = 0; i < numAllocationPerThread; i++)
+            {
+                SL_TEST_CHECK(*allocations[t][i] == t * numAllocationPerThread + i);
+                all.push_back(allocations[t][i]);
+            }
+        }
+
+        std::sort(all.begin(), all.end());
+        SL_TEST_CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+    }
+}
@@ -0,0 +1,150 @@
+
+#include "PCH.h"
+#include "Core/TaskQueue.h"
+#include "UnitTest.h"
+
+#include <array>
+#include <thread>
+
+
+//==================================================================
+// TaskQueue テスト
+//==================================================================
+namespace Silex::Test
+{
+    SL_TEST(TaskQueue_Order)
+    {
+        TaskQueue queue;
+        queue.Initialize();
+
+        SL_TEST_CHECK(queue.IsEmpty());
+
+        std::vector<uint32> order;
+        for (uint32 i = 0; i < 100; i++)
+        {
+            queue.Enqueue("Order", [&order, i]() { order.push_back(i); });
+        }
+
+        SL_TEST_CHECK(!queue.IsEmpty());
+        queue.Execute();
+
+        SL_TEST_CHECK(order.size() == 100);
+        for (uint32 i = 0; i < order.size(); i++)
+        {
+            SL_TEST_CHECK(order[i] == i);
+        }
+
+        // 実行済みのタスクは再実行されない
+        queue.Execute();
+        SL_TEST_CHECK(order.size() == 100);
+        SL_TEST_CHECK(queue.IsEmpty());
+    }
+
+    // チャンクに収まらない量と、大きなキャプチャを持つタスクを積んでも順序と内容が保たれる
+    SL_TEST(TaskQueue_Growth)
+    {
+        TaskQueue queue;
+        queue.Initialize(1024);
+
+        std::vector<uint64> results;
+        for (uint64 i = 0; i < 1000; i++)
+        {
+            std::array<uint64, 64> payload;
+            payload.fill(i);
+
+            queue.Enqueue("Growth", [&results, payload]()
+            {
+                uint64 sum = 0;
+                for (uint64 value : payload)
+                    sum += value;
+
+                results.push_back(sum);
+            });
+        }
+
+        for (uint32 frame = 0; frame < 2; frame++)
+        {
+            queue.Execute();
+        }
+
+        SL_TEST_CHECK(results.size() == 1000);
+        for (uint64 i = 0; i < results.size(); i++)
+        {
+            SL_TEST_CHECK(results[i] == i * 64);
+        }
+    }
+
+    // 実行中に追加されたタスクは、次回の実行に回される
+    SL_TEST(TaskQueue_EnqueueDuringExecute)
+    {
+        TaskQueue queue;
+        queue.Initialize();
+
+        uint32 numFirst  = 0;
+        uint32 numSecond = 0;
+
+        queue.Enqueue("First", [&]()
+        {
+            numFirst++;
+            queue.Enqueue("Second", [&]() { numSecond++; });
+        });
+
+        queue.Execute();
+        SL_TEST_CHECK(numFirst  == 1);
+        SL_TEST_CHECK(numSecond == 0);
+        SL_TEST_CHECK(!queue.IsEmpty());
+
+        queue.Execute();
+        SL_TEST_CHECK(numFirst  == 1);
+        SL_TEST_CHECK(numSecond == 1);
+    }
+
+    // 複数スレッドからの投入と実行が並行しても、全てのタスクがちょうど1回ずつ実行される
+    SL_TEST(TaskQueue_ConcurrentEnqueue)
+    {
+        static constexpr uint32 numThreads       = 4;
+        static constexpr uint32 numTaskPerThread = 20000;
+
+        TaskQueue queue;
+        queue.Initialize(4096);
+
+        std::vector<uint32> executed(numThreads * numTaskPerThread, 0);
+        std::vector<uint32> lastIndex(numThreads, 0);
+        bool                isOrdered = true;
+
+        std::atomic<uint32>      numFinished = 0;
+        std::vector<std::thread> threads;
+
+        for (uint32 t = 0; t < numThreads; t++)
+        {
+            threads.emplace_back([&, t]()
+            {
+                for (uint32 i = 0; i < numTaskPerThread; i++)
+                {
+                    // 同じスレッドから投入したタスクは投入順に実行される
+                    queue.Enqueue("Concurrent", [&, t, i]()
+                    {
+                        executed[t * numTaskPerThread + i]++;
+                        isOrdered &= i == 0 || lastIndex[t] == i - 1;
+                        lastIndex[t] = i;
+                    });
+                }
+
+                numFinished.fetch_add(1);
+            });
+        }
+
+        while (numFinished.load() != numThreads)
+        {
+            queue.Execute();
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        queue.Execute();
+
+        SL_TEST_CHECK(isOrdered);
+        SL_TEST_CHECK(std::all_of(executed.begin(), executed.end(), [](uint32 count) { return count == 1; }));
+    }
+}
@@ -0,0 +1,136 @@
+
+#include "PCH.h"
+#include "Core/ThreadPool.h"
+#include "UnitTest.h"
+
+
+//==================================================================
+// ThreadPool / TaskCounter テスト
+//------------------------------------------------------------------
+// テストごとにスレッドプールを初期化し、呼び出しスレッドをメインスレッドとする
+//==================================================================
+namespace Silex::Test
+{
+    struct ScopedThreadPool
+    {
+        ScopedThreadPool()  { ThreadPool::Initialize(); }
+        ~ScopedThreadPool() { ThreadPool::Finalize();   }
+    };
+
+
+    SL_TEST(ThreadPool_Wait)
+    {
+        ScopedThreadPool threadPool;
+        SL_TEST_CHECK(ThreadPool::IsMainThread());
+
+        // タスクのない待機はすぐに戻る
+        TaskCounter empty;
+        SL_TEST_CHECK(empty.IsCompleted());
+        ThreadPool::Wait(empty);
+
+        std::atomic<uint32> numExecuted = 0;
+        TaskCounter counter;
+
+        for (uint32 i = 0; i < 1000; i++)
+        {
+            ThreadPool::AddTask([&numExecuted]() { numExecuted.fetch_add(1); }, &counter);
+        }
+
+        ThreadPool::Wait(counter);
+
+        SL_TEST_CHECK(counter.IsCompleted());
+        SL_TEST_CHECK(counter.GetCount() == 0);
+        SL_TEST_CHECK(numExecuted.load() == 1000);
+    }
+
+    SL_TEST(ThreadPool_Priority)
+    {
+        ScopedThreadPool threadPool;
+
+        std::atomic<uint32> numExecuted = 0;
+        TaskCounter counter;
+
+        for (uint32 i = 0; i < 300; i++)
+        {
+            const TaskPriority priority = (TaskPriority)(i % (uint32)TaskPriority::Count);
+            ThreadPool::AddTask([&numExecuted]() { numExecuted.fetch_add(1); }, &counter, priority);
+        }
+
+        ThreadPool::Wait(counter);
+        SL_TEST_CHECK(numExecuted.load() == 300);
+    }
+
+    // タスク内から子タスクを待機しても、待機中のスレッドが子タスクを実行するのでデッドロックしない
+    SL_TEST(ThreadPool_NestedWait)
+    {
+        ScopedThreadPool threadPool;
+
+        const uint32 numOuter = ThreadPool::GetThreadCount() * 4;
+
+        std::atomic<uint32> numInner = 0;
+        TaskCounter outer;
+
+        for (uint32 i = 0; i < numOuter; i++)
+        {
+            ThreadPool::AddTask([&numInner]()
+            {
+                TaskCounter inner;
+                for (uint32 j = 0; j < 16; j++)
+                {
+                    ThreadPool::AddTask([&numInner]() { numInner.fetch_add(1); }, &inner);
+                }
+
+                ThreadPool::Wait(inner);
+            }, &outer);
+        }
+
+        ThreadPool::Wait(outer);
+        SL_TEST_CHECK(numInner.load() == numOuter * 16);
+    }
+
+    // Wait から戻った直後にカウンターを破棄しても、ワーカーが破棄済みのカウンターに触れない
+    SL_TEST(ThreadPool_CounterLifetime)
+    {
+        ScopedThreadPool threadPool;
+
+        for (uint32 i = 0; i < 2000; i++)
+        {
+            TaskCounter* counter = slnew(TaskCounter);
+
+            ThreadPool::AddTask([]() {}, counter);
+            ThreadPool::AddTask([]() {}, counter);
+            ThreadPool::Wait(*counter);
+
+            SL_TEST_CHECK(counter->IsCompleted());
+            sldelete(counter);
+        }
+    }
+
+    // ワーカーから積んだメインスレッドタスクは、ExecuteMainThreadTasks を呼んだスレッドで実行される
+    SL_TEST(ThreadPool_MainThreadTask)
+    {
+        ScopedThreadPool threadPool;
+
+        std::atomic<bool> isExecuted   = false;
+        std::atomic<bool> isMainThread = false;
+        TaskCounter counter;
+
+        ThreadPool::AddTask([&]()
+        {
+            ThreadPool::AddMainThreadTask([&]()
+            {
+                isMainThread = ThreadPool::IsMainThread();
+                isExecuted   = true;
+            });
+        }, &counter);
+
+        ThreadPool::Wait(counter);
+
+        while (!isExecuted.load())
+        {
+            ThreadPool::ExecuteMainThreadTasks();
+        }
+
+        SL_TEST_CHECK(isMainThread.load());
+    }
+}
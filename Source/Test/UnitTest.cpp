@@ -0,0 +1,99 @@
+
+#include "PCH.h"
+#include "Core/ThreadPool.h"
+#include "Core/Profiler.h"
+#include "UnitTest.h"
+
+#include <cstdio>
+#include <cstring>
+
+
+//==================================================================
+// ユニットテスト実行
+//------------------------------------------------------------------
+// 使い方: UnitTest [テスト名の一部]
+// 引数を指定すると、名前にその文字列を含むテストのみ実行する
+// 失敗したテストがあれば 1 を返す
+//==================================================================
+
+
+namespace Silex
+{
+    // エディターのコンソールを持たないので、警告以上のログのみ標準エラーに出力する
+    void Logger::Log(LogLevel level, std::string_view message)
+    {
+        if (level > LogLevel::Warn)
+            return;
+
+        std::fprintf(stderr, "%.*s\n", (int)message.size(), message.data());
+    }
+
+    // プロファイラーはリンクしない
+    void Profiler::SetThreadName(std::string_view name)
+    {
+    }
+}
+
+
+namespace Silex::Test
+{
+    struct TestCase
+    {
+        const char*  name;
+        TestFunction function;
+    };
+
+    // 静的初期化の順序に依存しないように、関数内の静的変数で保持する
+    static std::vector<TestCase>& GetTestCases()
+    {
+        static std::vector<TestCase> testCases;
+        return testCases;
+    }
+
+    static uint32 currentFailureCount = 0;
+
+    TestRegistrar::TestRegistrar(const char* name, TestFunction function)
+    {
+        GetTestCases().push_back({ name, function });
+    }
+
+    void ReportFailure(const char* expression, const char* file, int32 line)
+    {
+        std::fprintf(stderr, "    %s(%d): %s\n", file, line, expression);
+        currentFailureCount++;
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    using namespace Silex;
+    using namespace Silex::Test;
+
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+
+    Memory::Initialize();
+
+    uint32 numRun    = 0;
+    uint32 numFailed = 0;
+
+    for (const TestCase& test : GetTestCases())
+    {
+        if (filter && !std::strstr(test.name, filter))
+            continue;
+
+        currentFailureCount = 0;
+        test.function();
+
+        numRun++;
+        if (currentFailureCount != 0)
+            numFailed++;
+
+        std::printf("[%s] %s\n", currentFailureCount == 0 ? "  OK  " : " FAIL ", test.name);
+    }
+
+    std::printf("%u / %u passed\n", numRun - numFailed, numRun);
+
+    Memory::Finalize();
+    return numFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Core/CoreType.h"
+#include "Core/Macros.h"
+
+
+//==================================================================
+// ユニットテスト
+//------------------------------------------------------------------
+// 外部のテストフレームワークは使用せず、SL_TEST で定義した関数を静的初期化時に登録して
+// main から順に実行する。SL_TEST_CHECK が失敗しても、そのテストは最後まで実行される
+//
+// 例:
+//   SL_TEST(FlatHashMap_Insert)
+//   {
+//       FlatHashMap<int32, int32> map;
+//       map[1] = 2;
+//       SL_TEST_CHECK(map.at(1) == 2);
+//   }
+//==================================================================
+namespace Silex::Test
+{
+    using TestFunction = void(*)();
+
+    struct TestRegistrar
+    {
+        TestRegistrar(const char* name, TestFunction function);
+    };
+
+    // 失敗を記録する（実行中のテストが失敗として報告される）
+    void ReportFailure(const char* expression, const char* file, int32 line);
+}
+
+
+#define SL_TEST(name)                                                        \
+    static void SL_COMBINE(SLTest_, name)();                                 \
+    static Silex::Test::TestRegistrar SL_COMBINE(SLTestRegistrar_, name)(    \
+        #name, &SL_COMBINE(SLTest_, name));                                  \
+    static void SL_COMBINE(SLTest_, name)()
+
+#define SL_TEST_CHECK(expr) { if (!(expr)) { Silex::Test::ReportFailure(#expr, __FILE__, __LINE__); } }
@@ -241,3 +241,155 @@ project "Silex"
             "/DELAYLOAD:assimp-vc143-mt.dll",
             "/DELAYLOAD:shaderc_shared.dll",
         }
+
+
+
+--==================================================
+-- アロケーターベンチマーク
+--==================================================
+-- エンジン本体とは別の、ヘッドレスなコンソールアプリケーション
+-- 計測対象のアロケーターのソースのみをビルドする
+--
+-- 例: AllocatorBenchmark.exe --threads 8 --output benchmark.json
+--==================================================
+project "AllocatorBenchmark"
+
+    location      "Source"
+    kind          "ConsoleApp"
+    language      "C++"
+    cppdialect    "C++20"
+    staticruntime "on"
+    characterset  "Unicode"
+
+    debugdir   "%{wks.location}"
+    targetdir  "Binary/%{cfg.buildcfg}/"
+    objdir     "Binary/%{cfg.buildcfg}/Intermediate/%{prj.name}"
+
+    files
+    {
+        "Source/Benchmark/**.h",
+        "Source/Benchmark/**.cpp",
+
+        "Source/Silex/Core/Memory.cpp",
+        "Source/Silex/Core/MemoryPool.cpp",
+        "Source/Silex/Core/LinearAllocator.cpp",
+        "Source/Silex/Core/Hash.cpp",
+    }
+
+    includedirs
+    {
+        "Source/Silex/",
+        "Source/Silex/Core/PCH",
+        "Source/External",
+        "Source/External/glm",
+        "Source/External/imgui",
+    }
+
+    buildoptions
+    {
+        "/wd4244",
+        "/wd4267",
+        "/wd4291",
+        "/utf-8",
+        "/Zc:preprocessor",
+    }
+
+    filter "system:windows"
+
+        systemversion "latest"
+
+        defines
+        {
+            "SL_PLATFORM_WINDOWS",
+            "NOMINMAX",
+            "_CRT_SECURE_NO_WARNINGS",
+        }
+
+    filter "configurations:Debug"
+
+        defines    "SL_DEBUG"
+        symbols    "On"
+        targetname "%{prj.name}d"
+
+    filter "configurations:Release"
+
+        defines    "SL_RELEASE"
+        optimize   "On"
+        targetname "%{prj.name}"
+
+
+
+--==================================================
+-- ユニットテスト
+--==================================================
+-- エンジン本体とは別の、ヘッドレスなコンソールアプリケーション
+-- テスト対象のソースのみをビルドし、失敗したテストがあれば 1 を返す
+--
+-- 例: UnitTest.exe FlatHashMap
+--==================================================
+project "UnitTest"
+
+    location      "Source"
+    kind          "ConsoleApp"
+    language      "C++"
+    cppdialect    "C++20"
+    staticruntime "on"
+    characterset  "Unicode"
+
+    debugdir   "%{wks.location}"
+    targetdir  "Binary/%{cfg.buildcfg}/"
+    objdir     "Binary/%{cfg.buildcfg}/Intermediate/%{prj.name}"
+
+    files
+    {
+        "Source/Test/**.h",
+        "Source/Test/**.cpp",
+
+        "Source/Silex/Core/Memory.cpp",
+        "Source/Silex/Core/MemoryPool.cpp",
+        "Source/Silex/Core/LinearAllocator.cpp",
+        "Source/Silex/Core/Hash.cpp",
+        "Source/Silex/Core/TaskQueue.cpp",
+        "Source/Silex/Core/ThreadPool.cpp",
+    }
+
+    includedirs
+    {
+        "Source/Silex/",
+        "Source/Silex/Core/PCH",
+        "Source/External",
+        "Source/External/glm",
+        "Source/External/imgui",
+    }
+
+    buildoptions
+    {
+        "/wd4244",
+        "/wd4267",
+        "/wd4291",
+        "/utf-8",
+        "/Zc:preprocessor",
+    }
+
+    filter "system:windows"
+
+        systemversion "latest"
+
+        defines
+        {
+            "SL_PLATFORM_WINDOWS",
+            "NOMINMAX",
+            "_CRT_SECURE_NO_WARNINGS",
+        }
+
+    filter "configurations:Debug"
+
+        defines    "SL_DEBUG"
+        symbols    "On"
+        targetname "%{prj.name}d"
+
+    filter "configurations:Release"
+
+        defines    "SL_RELEASE"
+        optimize   "On"
+        targetname "%{prj.name}"